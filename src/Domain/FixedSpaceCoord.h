@@ -0,0 +1,79 @@
+#ifndef __GEOMTK_FixedSpaceCoord__
+#define __GEOMTK_FixedSpaceCoord__
+
+#include "geomtk_commons.h"
+
+namespace geomtk {
+
+/**
+ *  This class describes the Cartesian space coordinate of a point with the
+ *  dimension size fixed at compile time. Unlike SpaceCoord, it has no heap
+ *  members and no virtual methods, so it is trivially copyable and can be
+ *  put into large particle arrays or copied in hot loops without allocation.
+ *
+ *  @tparam NumDim the dimension size.
+ */
+template <int NumDim>
+class FixedSpaceCoord {
+protected:
+    double coord[NumDim];
+public:
+    static uword
+    numDim() { return NumDim; }
+
+    void
+    set(double x) {
+        coord[0] = x;
+    }
+
+    void
+    set(double x, double y) {
+        coord[0] = x;
+        coord[1] = y;
+    }
+
+    void
+    set(double x, double y, double z) {
+        coord[0] = x;
+        coord[1] = y;
+        coord[2] = z;
+    }
+
+    void
+    setComp(int i, double comp) {
+        coord[i] = comp;
+    }
+
+    double
+    operator()(int i) const {
+        return coord[i];
+    }
+
+    double&
+    operator()(int i) {
+        return coord[i];
+    }
+
+    const double*
+    data() const {
+        return coord;
+    }
+
+    double*
+    data() {
+        return coord;
+    }
+
+    void
+    print() const {
+        cout << "Coordinate:";
+        for (int m = 0; m < NumDim; ++m) {
+            cout << setw(20) << coord[m];
+        }
+        cout << endl;
+    }
+}; // FixedSpaceCoord
+
+} // geomtk
+
+#endif // __GEOMTK_FixedSpaceCoord__
@@ -0,0 +1,187 @@
+#ifndef __GEOMTK_FixedSphereCoord__
+#define __GEOMTK_FixedSphereCoord__
+
+#include "FixedSpaceCoord.h"
+
+namespace geomtk {
+
+enum Pole {
+    SOUTH_POLE = 0, NORTH_POLE = 1, NOT_POLE = 2
+};
+
+/**
+ *  Transform the horizontal coordinate onto polar stereographic plane. This is
+ *  shared by SphereCoord and FixedSphereCoord.
+ *
+ *  @param radius the sphere radius.
+ *  @param lat    the latitude.
+ *  @param cosLon the cosine of longitude.
+ *  @param sinLon the sine of longitude.
+ *  @param xt     the output coordinate on polar stereographic plane.
+ */
+inline void
+transformCoordToPS(double radius, double lat, double cosLon, double sinLon,
+                   double *xt) {
+    double tanLat = tan(lat);
+    if (lat < 0.0) { // South Pole
+        xt[0] =  radius*cosLon/tanLat;
+        xt[1] = -radius*sinLon/tanLat;
+    } else { // North Pole
+        xt[0] =  radius*cosLon/tanLat;
+        xt[1] =  radius*sinLon/tanLat;
+    }
+} // transformCoordToPS
+
+/**
+ *  Transform the horizontal coordinate from polar stereographic plane.
+ *
+ *  @param radius the sphere radius.
+ *  @param pole   the pole where the plane is tangent.
+ *  @param xt     the coordinate on polar stereographic plane.
+ *  @param lon    the output longitude in [0, 2*PI].
+ *  @param lat    the output latitude.
+ */
+inline void
+transformCoordFromPS(double radius, Pole pole, const double *xt,
+                     double &lon, double &lat) {
+    if (pole == SOUTH_POLE) { // South Pole
+        lon = atan2(xt[1], -xt[0]);
+        lat = -atan(radius/sqrt(xt[0]*xt[0]+xt[1]*xt[1]));
+#ifndef NDEBUG
+        assert(lat < 0);
+#endif
+    } else { // North Pole
+        lon = atan2(xt[1], xt[0]);
+        lat = atan(radius/sqrt(xt[0]*xt[0]+xt[1]*xt[1]));
+#ifndef NDEBUG
+        assert(lat > 0);
+#endif
+    }
+    if (lon < 0.0) lon += PI2;
+    if (lon > PI2) lon -= PI2;
+} // transformCoordFromPS
+
+/**
+ *  This class describes the coordinate of sphere with the dimension size fixed
+ *  at compile time. The sine and cosine of longitude and latitude are cached
+ *  as SphereCoord does, but the polar stereographic and Cartesian coordinates
+ *  are calculated on demand, so one point only takes (NumDim+4) doubles.
+ *
+ *  @tparam NumDim the dimension size (2 or 3).
+ */
+template <int NumDim>
+class FixedSphereCoord : public FixedSpaceCoord<NumDim> {
+protected:
+    double _cosLon, _sinLon, _cosLat, _sinLat;
+public:
+    void
+    set(double lon, double lat) {
+        this->coord[0] = lon;
+        this->coord[1] = lat;
+        updateTrigonometricFunctions();
+    }
+
+    void
+    set(double lon, double lat, double lev) {
+        this->coord[0] = lon;
+        this->coord[1] = lat;
+        this->coord[2] = lev;
+        updateTrigonometricFunctions();
+    }
+
+    void
+    setComp(int i, double comp) {
+        this->coord[i] = comp;
+        switch (i) {
+            case 0:
+                _cosLon = cos(comp);
+                _sinLon = sin(comp);
+                break;
+            case 1:
+                _cosLat = cos(comp);
+                _sinLat = sin(comp);
+            default:
+                break;
+        }
+    }
+
+    void
+    updateTrigonometricFunctions() {
+        _cosLon = cos(this->coord[0]);
+        _sinLon = sin(this->coord[0]);
+        _cosLat = cos(this->coord[1]);
+        _sinLat = sin(this->coord[1]);
+    }
+
+    double
+    cosLon() const {
+        return _cosLon;
+    }
+
+    double
+    sinLon() const {
+        return _sinLon;
+    }
+
+    double
+    cosLat() const {
+        return _cosLat;
+    }
+
+    double
+    sinLat() const {
+        return _sinLat;
+    }
+
+    /**
+     *  Calculate the horizontal coordinate on polar stereographic plane.
+     *
+     *  @param radius the sphere radius.
+     *  @param xt     the output coordinate (2 elements).
+     */
+    void
+    transformToPS(double radius, double *xt) const {
+        transformCoordToPS(radius, this->coord[1], _cosLon, _sinLon, xt);
+    }
+
+    /**
+     *  Set the horizontal coordinate from polar stereographic plane.
+     *
+     *  @param radius the sphere radius.
+     *  @param pole   the pole where the plane is tangent.
+     *  @param xt     the coordinate on polar stereographic plane.
+     */
+    void
+    transformFromPS(double radius, Pole pole, const double *xt) {
+        transformCoordFromPS(radius, pole, xt, this->coord[0], this->coord[1]);
+        updateTrigonometricFunctions();
+    }
+
+    /**
+     *  Calculate the Cartesian coordinate.
+     *
+     *  @param radius the sphere radius.
+     *  @param xc     the output coordinate (3 elements).
+     */
+    void
+    transformToCart(double radius, double *xc) const {
+        xc[0] = radius*_cosLat*_cosLon;
+        xc[1] = radius*_cosLat*_sinLon;
+        xc[2] = radius*_sinLat;
+    }
+
+    void
+    print() const {
+        cout << "Coordinate:";
+        cout << setw(20) << setprecision(10) << this->coord[0]/RAD;
+        cout << setw(20) << setprecision(10) << this->coord[1]/RAD;
+        if (NumDim == 3) {
+            cout << setw(20) << setprecision(10) << this->coord[2];
+        }
+        cout << endl;
+    }
+}; // FixedSphereCoord
+
+} // geomtk
+
+#endif // __GEOMTK_FixedSphereCoord__
@@ -0,0 +1,154 @@
+#ifndef __GEOMTK_FixedSphereVelocity__
+#define __GEOMTK_FixedSphereVelocity__
+
+#include "FixedVelocity.h"
+#include "FixedSphereCoord.h"
+
+namespace geomtk {
+
+/**
+ *  Transform the horizontal velocity onto polar stereographic plane. This is
+ *  shared by SphereVelocity and FixedSphereVelocity.
+ *
+ *  @param sinLat  the sine of latitude.
+ *  @param sinLat2 the square of sine of latitude.
+ *  @param sinLon  the sine of longitude.
+ *  @param cosLon  the cosine of longitude.
+ *  @param v       the velocity on sphere.
+ *  @param vt      the output velocity on polar stereographic plane.
+ */
+inline void
+transformVelocityToPS(double sinLat, double sinLat2, double sinLon,
+                      double cosLon, const double *v, double *vt) {
+    if (sinLat < 0.0) { // South Pole
+        vt[0] = -sinLon/sinLat*v[0]-cosLon/sinLat2*v[1];
+        vt[1] = -cosLon/sinLat*v[0]+sinLon/sinLat2*v[1];
+    } else { // North Pole
+        vt[0] = -sinLon/sinLat*v[0]-cosLon/sinLat2*v[1];
+        vt[1] =  cosLon/sinLat*v[0]-sinLon/sinLat2*v[1];
+    }
+} // transformVelocityToPS
+
+/**
+ *  Transform the horizontal velocity from polar stereographic plane.
+ *
+ *  @param lat    the latitude.
+ *  @param sinLat the sine of latitude.
+ *  @param sinLon the sine of longitude.
+ *  @param cosLon the cosine of longitude.
+ *  @param vt     the velocity on polar stereographic plane.
+ *  @param v      the output velocity on sphere.
+ */
+inline void
+transformVelocityFromPS(double lat, double sinLat, double sinLon,
+                        double cosLon, const double *vt, double *v) {
+    if (lat < 0.0) { // South Pole
+        v[0] = (-sinLon*vt[0]-cosLon*vt[1])*sinLat;
+        v[1] = (-cosLon*vt[0]+sinLon*vt[1])*sinLat*sinLat;
+    } else { // North Pole
+        v[0] = (-sinLon*vt[0]+cosLon*vt[1])*sinLat;
+        v[1] = (-cosLon*vt[0]-sinLon*vt[1])*sinLat*sinLat;
+    }
+} // transformVelocityFromPS
+
+/**
+ *  This class describes the velocity on sphere with the dimension size fixed
+ *  at compile time. It is trivially copyable, so it is used in the polar ring
+ *  and the particle arrays instead of SphereVelocity.
+ *
+ *  @tparam NumDim the dimension size (2 or 3).
+ */
+template <int NumDim>
+class FixedSphereVelocity : public FixedVelocity<NumDim> {
+protected:
+    double vt[2];
+public:
+    void
+    fill(double val) {
+        FixedVelocity<NumDim>::fill(val);
+        vt[0] = val;
+        vt[1] = val;
+    }
+
+    const double*
+    psVelocity() const {
+        return vt;
+    }
+
+    double*
+    psVelocity() {
+        return vt;
+    }
+
+    const FixedSphereVelocity
+    operator+(const FixedSphereVelocity &other) const {
+        FixedSphereVelocity res;
+        for (int m = 0; m < NumDim; ++m) {
+            res.v[m] = this->v[m]+other.v[m];
+        }
+        res.vt[0] = vt[0]+other.vt[0];
+        res.vt[1] = vt[1]+other.vt[1];
+        return res;
+    }
+
+    const FixedSphereVelocity
+    operator-(const FixedSphereVelocity &other) const {
+        FixedSphereVelocity res;
+        for (int m = 0; m < NumDim; ++m) {
+            res.v[m] = this->v[m]-other.v[m];
+        }
+        res.vt[0] = vt[0]-other.vt[0];
+        res.vt[1] = vt[1]-other.vt[1];
+        return res;
+    }
+
+    const FixedSphereVelocity
+    operator*(double scale) const {
+        FixedSphereVelocity res;
+        for (int m = 0; m < NumDim; ++m) {
+            res.v[m] = this->v[m]*scale;
+        }
+        res.vt[0] = vt[0]*scale;
+        res.vt[1] = vt[1]*scale;
+        return res;
+    }
+
+    const FixedSphereVelocity
+    operator/(double scale) const {
+        FixedSphereVelocity res;
+        for (int m = 0; m < NumDim; ++m) {
+            res.v[m] = this->v[m]/scale;
+        }
+        res.vt[0] = vt[0]/scale;
+        res.vt[1] = vt[1]/scale;
+        return res;
+    }
+
+    void
+    transformToPS(const FixedSphereCoord<NumDim> &x) {
+        transformToPS(x.sinLat(), x.sinLat()*x.sinLat(), x.sinLon(), x.cosLon());
+    }
+
+    void
+    transformToPS(double sinLat, double sinLat2, double sinLon, double cosLon) {
+        transformVelocityToPS(sinLat, sinLat2, sinLon, cosLon, this->v, vt);
+    }
+
+    void
+    transformFromPS(const FixedSphereCoord<NumDim> &x) {
+        transformVelocityFromPS(x(1), x.sinLat(), x.sinLon(), x.cosLon(),
+                                vt, this->v);
+    }
+
+    void
+    print() const {
+        FixedVelocity<NumDim>::print();
+        cout << "Transformed velocity:";
+        cout << setw(20) << setprecision(10) << vt[0];
+        cout << setw(20) << setprecision(10) << vt[1] << endl;
+    }
+}; // FixedSphereVelocity
+
+} // geomtk
+
+#endif // __GEOMTK_FixedSphereVelocity__
@@ -0,0 +1,98 @@
+#ifndef __GEOMTK_FixedVelocity__
+#define __GEOMTK_FixedVelocity__
+
+#include "geomtk_commons.h"
+
+namespace geomtk {
+
+/**
+ *  This class describes the velocity for the Cartesian domain with the
+ *  dimension size fixed at compile time. It is trivially copyable, and the
+ *  arithmetic operators do not allocate, unlike Velocity.
+ *
+ *  @tparam NumDim the dimension size.
+ */
+template <int NumDim>
+class FixedVelocity {
+protected:
+    double v[NumDim];
+public:
+    static uword
+    numDim() { return NumDim; }
+
+    void
+    fill(double val) {
+        for (int m = 0; m < NumDim; ++m) {
+            v[m] = val;
+        }
+    }
+
+    double
+    operator()(int i) const {
+        return v[i];
+    }
+
+    double&
+    operator()(int i) {
+        return v[i];
+    }
+
+    const double*
+    data() const {
+        return v;
+    }
+
+    double*
+    data() {
+        return v;
+    }
+
+    const FixedVelocity
+    operator+(const FixedVelocity &other) const {
+        FixedVelocity res;
+        for (int m = 0; m < NumDim; ++m) {
+            res.v[m] = v[m]+other.v[m];
+        }
+        return res;
+    }
+
+    const FixedVelocity
+    operator-(const FixedVelocity &other) const {
+        FixedVelocity res;
+        for (int m = 0; m < NumDim; ++m) {
+            res.v[m] = v[m]-other.v[m];
+        }
+        return res;
+    }
+
+    const FixedVelocity
+    operator*(double scale) const {
+        FixedVelocity res;
+        for (int m = 0; m < NumDim; ++m) {
+            res.v[m] = v[m]*scale;
+        }
+        return res;
+    }
+
+    const FixedVelocity
+    operator/(double scale) const {
+        FixedVelocity res;
+        for (int m = 0; m < NumDim; ++m) {
+            res.v[m] = v[m]/scale;
+        }
+        return res;
+    }
+
+    void
+    print() const {
+        cout << "Velocity:";
+        for (int m = 0; m < NumDim; ++m) {
+            cout << setw(20) << v[m];
+        }
+        cout << endl;
+    }
+}; // FixedVelocity
+
+} // geomtk
+
+#endif // __GEOMTK_FixedVelocity__
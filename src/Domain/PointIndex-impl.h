@@ -0,0 +1,170 @@
+namespace geomtk {
+
+template <class DomainType>
+PointIndex<DomainType>::
+PointIndex(const DomainType &domain) {
+    this->domain = &domain;
+    _maxDisplacement = 0;
+    _rebuildThreshold = 0;
+    rangeTree = NULL;
+    neighborTree = NULL;
+}
+
+template <class DomainType>
+PointIndex<DomainType>::
+~PointIndex() {
+    clearTrees();
+}
+
+template <class DomainType>
+void PointIndex<DomainType>::
+build(const mat &points) {
+    clearTrees();
+    treePoints = points;
+    this->points = points;
+    _maxDisplacement = 0;
+} // build
+
+template <class DomainType>
+void PointIndex<DomainType>::
+update(const mat &points) {
+    if (points.n_cols != treePoints.n_cols) {
+        REPORT_ERROR("Point number is changed, call build instead!");
+    }
+    MetricType::domain = domain;
+    double maxDisplacement = 0;
+    #pragma omp parallel for reduction(max:maxDisplacement)
+    for (uword i = 0; i < points.n_cols; ++i) {
+        double d = MetricType::Evaluate(points.col(i), treePoints.col(i));
+        maxDisplacement = max(maxDisplacement, d);
+    }
+    if (maxDisplacement > _rebuildThreshold) {
+        build(points);
+    } else {
+        this->points = points;
+        _maxDisplacement = maxDisplacement;
+    }
+} // update
+
+template <class DomainType>
+void PointIndex<DomainType>::
+searchRadius(const mat &queries, double radius,
+             vector<vector<uword> > &neighbors,
+             vector<vector<double> > &distances) {
+    searchRange(queries, radius+_maxDisplacement, radius, neighbors, distances);
+} // searchRadius
+
+template <class DomainType>
+void PointIndex<DomainType>::
+searchNearest(const mat &queries, uword k, umat &neighbors, mat &distances) {
+    if (k > numPoint()) {
+        REPORT_ERROR("Neighbor number " << k << " exceeds point number " <<
+                     numPoint() << "!");
+    }
+    MetricType::domain = domain;
+    NeighborTreeType queryTree(queries);
+    mlpack::neighbor::NeighborSearch<mlpack::neighbor::NearestNeighborSort,
+        MetricType, NeighborTreeType> search(getNeighborTree(), &queryTree,
+                                             treePoints, queries);
+    arma::Mat<size_t> treeNeighbors;
+    search.Search(k, treeNeighbors, distances);
+    neighbors.set_size(k, queries.n_cols);
+    if (_maxDisplacement == 0) {
+        for (uword i = 0; i < neighbors.n_elem; ++i) {
+            neighbors(i) = treeNeighbors(i);
+        }
+        return;
+    }
+    // The true k-th nearest distance is not larger than the one on the trees
+    // plus the displacement, so the candidates are within the range below.
+    double treeRadius = 0;
+    for (uword q = 0; q < queries.n_cols; ++q) {
+        treeRadius = max(treeRadius, distances(k-1, q));
+    }
+    treeRadius += 2*_maxDisplacement;
+    vector<vector<uword> > candidates;
+    vector<vector<double> > candidateDistances;
+    searchRange(queries, treeRadius, treeRadius, candidates, candidateDistances);
+    #pragma omp parallel for
+    for (uword q = 0; q < queries.n_cols; ++q) {
+        vector<uword> order(candidates[q].size());
+        for (uword l = 0; l < order.size(); ++l) {
+            order[l] = l;
+        }
+        const vector<double> &d = candidateDistances[q];
+        std::partial_sort(order.begin(), order.begin()+k, order.end(),
+                          [&d](uword a, uword b) { return d[a] < d[b]; });
+        for (uword l = 0; l < k; ++l) {
+            neighbors(l, q) = candidates[q][order[l]];
+            distances(l, q) = d[order[l]];
+        }
+    }
+} // searchNearest
+
+template <class DomainType>
+void PointIndex<DomainType>::
+clearTrees() {
+    if (rangeTree != NULL) {
+        delete rangeTree;
+        rangeTree = NULL;
+    }
+    if (neighborTree != NULL) {
+        delete neighborTree;
+        neighborTree = NULL;
+    }
+} // clearTrees
+
+template <class DomainType>
+typename PointIndex<DomainType>::RangeTreeType* PointIndex<DomainType>::
+getRangeTree() {
+    if (rangeTree == NULL) {
+        MetricType::domain = domain;
+        rangeTree = new RangeTreeType(treePoints);
+    }
+    return rangeTree;
+} // getRangeTree
+
+template <class DomainType>
+typename PointIndex<DomainType>::NeighborTreeType* PointIndex<DomainType>::
+getNeighborTree() {
+    if (neighborTree == NULL) {
+        MetricType::domain = domain;
+        neighborTree = new NeighborTreeType(treePoints);
+    }
+    return neighborTree;
+} // getNeighborTree
+
+template <class DomainType>
+void PointIndex<DomainType>::
+searchRange(const mat &queries, double treeRadius, double radius,
+            vector<vector<uword> > &neighbors,
+            vector<vector<double> > &distances) {
+    MetricType::domain = domain;
+    RangeTreeType queryTree(queries);
+    mlpack::range::RangeSearch<MetricType, RangeTreeType> search(
+        getRangeTree(), &queryTree, treePoints, queries);
+    vector<vector<size_t> > treeNeighbors;
+    search.Search(mlpack::math::Range(0, treeRadius), treeNeighbors, distances);
+    neighbors.resize(queries.n_cols);
+    #pragma omp parallel for
+    for (uword q = 0; q < queries.n_cols; ++q) {
+        neighbors[q].clear();
+        if (_maxDisplacement == 0) {
+            neighbors[q].assign(treeNeighbors[q].begin(), treeNeighbors[q].end());
+            continue;
+        }
+        // Check the candidates with the current positions.
+        uword n = 0;
+        for (uword l = 0; l < treeNeighbors[q].size(); ++l) {
+            uword i = treeNeighbors[q][l];
+            double d = MetricType::Evaluate(queries.col(q), points.col(i));
+            if (d <= radius) {
+                neighbors[q].push_back(i);
+                distances[q][n++] = d;
+            }
+        }
+        distances[q].resize(n);
+    }
+} // searchRange
+
+} // geomtk
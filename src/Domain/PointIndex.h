@@ -0,0 +1,134 @@
+#ifndef __GEOMTK_PointIndex__
+#define __GEOMTK_PointIndex__
+
+#include "geomtk_commons.h"
+#include "DomainMetric.h"
+
+namespace geomtk {
+
+/**
+ *  This class indexes the scattered points (e.g. particles or observation
+ *  sites) in the domain by MLPACK cover trees with DomainMetric, and answers
+ *  the radius and k-nearest-neighbour queries for a batch of query points.
+ *
+ *  The points are given as the columns of a matrix with the coordinates used
+ *  by "calcDistance(const vec&, const vec&)" of the domain, that is the
+ *  Cartesian coordinates (e.g. SphereCoord::cartCoord) for SphereDomain, and
+ *  the distances are measured in the same way (i.e. chord lengths on sphere).
+ *
+ *  When the points move a little, "update" keeps the trees built on the old
+ *  positions and records the maximum displacement. The queries then search
+ *  the trees with the radius enlarged by the displacement, and check the
+ *  candidates with the current positions, so the results are still exact.
+ *  The trees are rebuilt when the displacement exceeds the threshold.
+ */
+template <class DomainType>
+class PointIndex {
+public:
+    typedef DomainMetric<DomainType> MetricType;
+    typedef mlpack::tree::CoverTree<MetricType, mlpack::tree::FirstPointIsRoot,
+        mlpack::range::RangeSearchStat> RangeTreeType;
+    typedef mlpack::neighbor::NeighborSearchStat<
+        mlpack::neighbor::NearestNeighborSort> NeighborStatType;
+    typedef mlpack::tree::CoverTree<MetricType, mlpack::tree::FirstPointIsRoot,
+        NeighborStatType> NeighborTreeType;
+protected:
+    const DomainType *domain;
+    // point positions when the trees are built
+    mat treePoints;
+    mat points;
+    double _maxDisplacement;
+    double _rebuildThreshold;
+    // The trees are built on demand.
+    RangeTreeType *rangeTree;
+    NeighborTreeType *neighborTree;
+public:
+    PointIndex(const DomainType &domain);
+    virtual ~PointIndex();
+
+    /**
+     *  Index the given points from scratch.
+     *
+     *  @param points the point coordinates (one column per point).
+     */
+    void
+    build(const mat &points);
+
+    /**
+     *  Update the point positions. The point number should not be changed.
+     *
+     *  @param points the new point coordinates.
+     */
+    void
+    update(const mat &points);
+
+    uword
+    numPoint() const {
+        return points.n_cols;
+    }
+
+    double
+    maxDisplacement() const {
+        return _maxDisplacement;
+    }
+
+    double
+    rebuildThreshold() const {
+        return _rebuildThreshold;
+    }
+
+    void
+    setRebuildThreshold(double threshold) {
+        _rebuildThreshold = threshold;
+    }
+
+    /**
+     *  Find the points within the given distance of each query point.
+     *
+     *  @param queries   the query point coordinates (one column per point).
+     *  @param radius    the search radius.
+     *  @param neighbors the output point indices for each query point.
+     *  @param distances the output distances for each query point.
+     */
+    void
+    searchRadius(const mat &queries, double radius,
+                 vector<vector<uword> > &neighbors,
+                 vector<vector<double> > &distances);
+
+    /**
+     *  Find the k nearest points of each query point.
+     *
+     *  @param queries   the query point coordinates (one column per point).
+     *  @param k         the neighbor number.
+     *  @param neighbors the output point indices (k x query point number)
+     *                   sorted by distances.
+     *  @param distances the output distances with the same layout.
+     */
+    void
+    searchNearest(const mat &queries, uword k, umat &neighbors,
+                  mat &distances);
+protected:
+    void
+    clearTrees();
+
+    RangeTreeType*
+    getRangeTree();
+
+    NeighborTreeType*
+    getNeighborTree();
+
+    /**
+     *  Run the range search on the trees and check the candidates with the
+     *  current positions.
+     */
+    void
+    searchRange(const mat &queries, double treeRadius, double radius,
+                vector<vector<uword> > &neighbors,
+                vector<vector<double> > &distances);
+}; // PointIndex
+
+} // geomtk
+
+#include "PointIndex-impl.h"
+
+#endif // __GEOMTK_PointIndex__
@@ -101,14 +101,7 @@ operator=(const SphereCoord &other) {
 
 void SphereCoord::
 transformToPS(const SphereDomain &domain) {
-    double tanLat = tan(coord[1]);
-    if (coord[1] < 0.0) { // South Pole
-        xt[0] =  domain.radius()*_cosLon/tanLat;
-        xt[1] = -domain.radius()*_sinLon/tanLat;
-    } else { // North Pole
-        xt[0] =  domain.radius()*_cosLon/tanLat;
-        xt[1] =  domain.radius()*_sinLon/tanLat;
-    }
+    transformCoordToPS(domain.radius(), coord[1], _cosLon, _sinLon, xt.memptr());
     if (domain.numDim() == 3) {
         xt[2] = coord[2];
     }
@@ -116,21 +109,7 @@ transformToPS(const SphereDomain &domain) {
 
 void SphereCoord::
 transformFromPS(const SphereDomain &domain, Pole pole) {
-    if (pole == SOUTH_POLE) { // South Pole
-        coord[0] = atan2(xt[1], -xt[0]);
-        coord[1] = -atan(domain.radius()/sqrt(xt[0]*xt[0]+xt[1]*xt[1]));
-#ifndef NDEBUG
-        assert(coord[1] < 0);
-#endif
-    } else { // North Pole
-        coord[0] = atan2(xt[1], xt[0]);
-        coord[1] = atan(domain.radius()/sqrt(xt[0]*xt[0]+xt[1]*xt[1]));
-#ifndef NDEBUG
-        assert(coord[1] > 0);
-#endif
-    }
-    if (coord[0] < 0.0) coord[0] += PI2;
-    if (coord[0] > PI2) coord[0] -= PI2;
+    transformCoordFromPS(domain.radius(), pole, xt.memptr(), coord[0], coord[1]);
     if (domain.numDim() == 3) {
         coord[2] = xt[2];
     }
@@ -2,15 +2,12 @@
 #define __GEOMTK_SphereCoord__
 
 #include "SpaceCoord.h"
+#include "FixedSphereCoord.h"
 
 namespace geomtk {
 
 class SphereDomain;
 
-enum Pole {
-    SOUTH_POLE = 0, NORTH_POLE = 1, NOT_POLE = 2
-};
-
 /**
  *  This class describes the coordinate of sphere.
  */
@@ -103,6 +100,35 @@ public:
     SphereCoord&
     operator=(const SphereCoord& other);
 
+    /**
+     *  Copy from the lightweight coordinate, which should have the same
+     *  dimension size.
+     */
+    template <int NumDim>
+    SphereCoord&
+    operator=(const FixedSphereCoord<NumDim> &other) {
+        for (int m = 0; m < NumDim; ++m) {
+            coord[m] = other(m);
+        }
+        _cosLon = other.cosLon();
+        _sinLon = other.sinLon();
+        _cosLat = other.cosLat();
+        _sinLat = other.sinLat();
+        return *this;
+    }
+
+    /**
+     *  Copy into the lightweight coordinate for hot loops.
+     */
+    template <int NumDim>
+    void
+    get(FixedSphereCoord<NumDim> &x) const {
+        for (int m = 0; m < NumDim; ++m) {
+            x(m) = coord[m];
+        }
+        x.updateTrigonometricFunctions();
+    }
+
     void
     transformToPS(const SphereDomain &domain);
 
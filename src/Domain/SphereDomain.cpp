@@ -263,6 +263,48 @@ rotateBack(const SphereCoord &xp, SphereCoord &xo, double lonR, double latR) con
     xo.set(lon, lat);
 } // rotateBack
 
+void SphereDomain::
+rotate(const SphereCoord &xp, uword n, const double *lon, const double *lat,
+       double *lonR, double *latR) const {
+    const double lonP = xp(0);
+    const double cosLatP = xp.cosLat();
+    const double sinLatP = xp.sinLat();
+    for (uword i = 0; i < n; ++i) {
+        double dlon = lon[i]-lonP;
+        double cosDlon = cos(dlon);
+        double sinDlon = sin(dlon);
+        double cosLat = cos(lat[i]);
+        double sinLat = sin(lat[i]);
+        double tmp1 = cosLat*sinDlon;
+        double tmp2 = cosLat*sinLatP*cosDlon-cosLatP*sinLat;
+        lonR[i] = atan2(tmp1, tmp2);
+        if (lonR[i] < 0.0) lonR[i] += PI2;
+        double tmp3 = sinLat*sinLatP+cosLat*cosLatP*cosDlon;
+        latR[i] = asin(fmin(1.0, fmax(-1.0, tmp3)));
+    }
+} // rotate
+
+void SphereDomain::
+rotateBack(const SphereCoord &xp, uword n, const double *lonR,
+           const double *latR, double *lon, double *lat) const {
+    const double lonP = xp(0);
+    const double cosLatP = xp.cosLat();
+    const double sinLatP = xp.sinLat();
+    for (uword i = 0; i < n; ++i) {
+        double cosLonR = cos(lonR[i]);
+        double sinLonR = sin(lonR[i]);
+        double cosLatR = cos(latR[i]);
+        double sinLatR = sin(latR[i]);
+        double tmp1 = cosLatR*sinLonR;
+        double tmp2 = sinLatR*cosLatP+cosLatR*cosLonR*sinLatP;
+        lon[i] = lonP+atan2(tmp1, tmp2);
+        if (lon[i] > PI2) lon[i] -= PI2;
+        if (lon[i] < 0.0) lon[i] += PI2;
+        double tmp3 = sinLatR*sinLatP-cosLatR*cosLatP*cosLonR;
+        lat[i] = asin(fmin(1.0, fmax(-1.0, tmp3)));
+    }
+} // rotateBack
+
 void SphereDomain::
 project(ProjectionType projType, const SphereCoord &xp, const SphereCoord &xo, vec &xs) const {
     switch (projType) {
@@ -277,6 +319,23 @@ project(ProjectionType projType, const SphereCoord &xp, const SphereCoord &xo, v
             break;
     }
 } // project
+
+void SphereDomain::
+project(ProjectionType projType, const SphereCoord &xp, uword n,
+        const double *lon, const double *lat, double *xs0, double *xs1) const {
+    switch (projType) {
+        case STEREOGRAPHIC:
+            // Use the output arrays to hold the rotated coordinates.
+            rotate(xp, n, lon, lat, xs0, xs1);
+            for (uword i = 0; i < n; ++i) {
+                double lonR = xs0[i];
+                double scale = _radius/tan(xs1[i]);
+                xs0[i] = scale*cos(lonR);
+                xs1[i] = scale*sin(lonR);
+            }
+            break;
+    }
+} // project
  
 void SphereDomain::
 projectBack(ProjectionType projType, const SphereCoord &xp, SphereCoord &xo, const vec &xs) const {
@@ -15,7 +15,17 @@ public:
     enum ProjectionType {
         STEREOGRAPHIC
     };
-    
+
+    /**
+     *  The distance types for the batched distance calculation. CHORD is the
+     *  straight-line distance, which is monotonic with the great circle one,
+     *  so it can be used to rank the distances without inverse trigonometric
+     *  functions.
+     */
+    enum DistanceType {
+        GREAT_CIRCLE, CHORD
+    };
+
     SphereDomain();
     SphereDomain(int numDim);
     SphereDomain(VertCoordType type);
@@ -46,6 +56,69 @@ public:
     double
     calcDistance(const SphereCoord &x, double lon, double sinLat, double cosLat) const;
 
+    template <int NumDim>
+    double
+    calcDistance(const FixedSphereCoord<NumDim> &x, double lon, double sinLat,
+                 double cosLat) const {
+        double dlon = x(0)-lon;
+        double tmp1 = x.sinLat()*sinLat;
+        double tmp2 = x.cosLat()*cosLat*cos(dlon);
+        double tmp3 = min(1.0, max(-1.0, tmp1+tmp2));
+        return _radius*acos(tmp3);
+    }
+
+    /**
+     *  Calculate the distances from the given point to the points on one
+     *  latitude circle (e.g. the polar ring of RLL mesh), whose longitudes are
+     *  given by their cosines and sines.
+     *
+     *  @param x      the point (SphereCoord or FixedSphereCoord).
+     *  @param n      the point number on the latitude circle.
+     *  @param cosLon the cosines of the longitudes.
+     *  @param sinLon the sines of the longitudes.
+     *  @param cosLat the cosine of the latitude.
+     *  @param sinLat the sine of the latitude.
+     *  @param d      the output distances.
+     *  @param type   the distance type.
+     */
+    template <class CoordType>
+    void
+    calcDistances(const CoordType &x, uword n, const double *cosLon,
+                  const double *sinLon, double cosLat, double sinLat,
+                  double *d, DistanceType type = GREAT_CIRCLE) const {
+        const double x0 = x.cosLat()*x.cosLon();
+        const double y0 = x.cosLat()*x.sinLon();
+        const double z0 = x.sinLat()-sinLat;
+        for (uword i = 0; i < n; ++i) {
+            double dx = cosLat*cosLon[i]-x0;
+            double dy = cosLat*sinLon[i]-y0;
+            d[i] = sqrt(dx*dx+dy*dy+z0*z0);
+        }
+        chordToDistance(n, d, type);
+    }
+
+    /**
+     *  Calculate the distances from the given point to the points given by
+     *  the trigonometric functions of their coordinates in separate arrays.
+     */
+    template <class CoordType>
+    void
+    calcDistances(const CoordType &x, uword n, const double *cosLon,
+                  const double *sinLon, const double *cosLat,
+                  const double *sinLat, double *d,
+                  DistanceType type = GREAT_CIRCLE) const {
+        const double x0 = x.cosLat()*x.cosLon();
+        const double y0 = x.cosLat()*x.sinLon();
+        const double z0 = x.sinLat();
+        for (uword i = 0; i < n; ++i) {
+            double dx = cosLat[i]*cosLon[i]-x0;
+            double dy = cosLat[i]*sinLon[i]-y0;
+            double dz = sinLat[i]-z0;
+            d[i] = sqrt(dx*dx+dy*dy+dz*dz);
+        }
+        chordToDistance(n, d, type);
+    }
+
     virtual vec
     diffCoord(const SphereCoord &x, const SphereCoord &y) const;
 
@@ -81,8 +154,37 @@ public:
     void
     rotateBack(const SphereCoord &xp, SphereCoord &xo, double lonR, double latR) const;
 
+    /**
+     *  Rotate the points given in separate longitude and latitude arrays. The
+     *  trigonometric functions of the rotated North Pole are used for all
+     *  points.
+     *
+     *  @param xp   the rotated North Pole coordinate.
+     *  @param n    the point number.
+     *  @param lon  the original longitudes.
+     *  @param lat  the original latitudes.
+     *  @param lonR the output rotated longitudes.
+     *  @param latR the output rotated latitudes.
+     */
+    void
+    rotate(const SphereCoord &xp, uword n, const double *lon, const double *lat,
+           double *lonR, double *latR) const;
+
+    void
+    rotateBack(const SphereCoord &xp, uword n, const double *lonR,
+               const double *latR, double *lon, double *lat) const;
+
     void
     project(ProjectionType projType, const SphereCoord &xp, const SphereCoord &xo, vec &xs) const;
+
+    /**
+     *  Project the points given in separate longitude and latitude arrays.
+     *  The projected coordinates are also output in separate arrays.
+     */
+    void
+    project(ProjectionType projType, const SphereCoord &xp, uword n,
+            const double *lon, const double *lat, double *xs0,
+            double *xs1) const;
     
     void
     projectBack(ProjectionType projType, const SphereCoord &xp, SphereCoord &xo, const vec &xs) const;
@@ -94,6 +196,23 @@ public:
      */
     virtual string
     brief() const;
+protected:
+    /**
+     *  Convert the chord lengths on the unit sphere into the distances with
+     *  the given type in place.
+     */
+    void
+    chordToDistance(uword n, double *d, DistanceType type) const {
+        if (type == GREAT_CIRCLE) {
+            for (uword i = 0; i < n; ++i) {
+                d[i] = 2*_radius*asin(fmin(1.0, 0.5*d[i]));
+            }
+        } else {
+            for (uword i = 0; i < n; ++i) {
+                d[i] *= _radius;
+            }
+        }
+    }
 }; // SphereDomain
 
 } // geomtk
@@ -69,24 +69,13 @@ transformToPS(const SphereCoord &x) {
 
 void SphereVelocity::
 transformToPS(double sinLat, double sinLat2, double sinLon, double cosLon) {
-    if (sinLat < 0.0) { // South Pole
-        vt[0] = -sinLon/sinLat*v[0]-cosLon/sinLat2*v[1];
-        vt[1] = -cosLon/sinLat*v[0]+sinLon/sinLat2*v[1];
-    } else { // North Pole
-        vt[0] = -sinLon/sinLat*v[0]-cosLon/sinLat2*v[1];
-        vt[1] =  cosLon/sinLat*v[0]-sinLon/sinLat2*v[1];
-    }
+    transformVelocityToPS(sinLat, sinLat2, sinLon, cosLon, v.memptr(), vt.memptr());
 } // transformToPS
 
 void SphereVelocity::
 transformFromPS(const SphereCoord &x) {
-    if (x(1) < 0.0) { // South Pole
-        v[0] = (-x.sinLon()*vt[0]-x.cosLon()*vt[1])*x.sinLat();
-        v[1] = (-x.cosLon()*vt[0]+x.sinLon()*vt[1])*x.sinLat()*x.sinLat();
-    } else { // North Pole
-        v[0] = (-x.sinLon()*vt[0]+x.cosLon()*vt[1])*x.sinLat();
-        v[1] = (-x.cosLon()*vt[0]-x.sinLon()*vt[1])*x.sinLat()*x.sinLat();
-    }
+    transformVelocityFromPS(x(1), x.sinLat(), x.sinLon(), x.cosLon(),
+                            vt.memptr(), v.memptr());
 } // transformFromPS
 
 void SphereVelocity::
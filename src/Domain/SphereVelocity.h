@@ -3,6 +3,7 @@
 
 #include "Velocity.h"
 #include "SphereCoord.h"
+#include "FixedSphereVelocity.h"
 
 namespace geomtk {
 
@@ -27,6 +28,34 @@ public:
     SphereVelocity&
     operator=(const SphereVelocity &other);
 
+    /**
+     *  Copy from the lightweight velocity. Only the components within the
+     *  dimension size of this velocity are copied.
+     */
+    template <int NumDim>
+    SphereVelocity&
+    operator=(const FixedSphereVelocity<NumDim> &other) {
+        for (uword m = 0; m < v.size() && m < static_cast<uword>(NumDim); ++m) {
+            v[m] = other(m);
+        }
+        vt[0] = other.psVelocity()[0];
+        vt[1] = other.psVelocity()[1];
+        return *this;
+    }
+
+    /**
+     *  Copy into the lightweight velocity for hot loops.
+     */
+    template <int NumDim>
+    void
+    get(FixedSphereVelocity<NumDim> &u) const {
+        for (int m = 0; m < NumDim; ++m) {
+            u(m) = m < static_cast<int>(v.size()) ? v[m] : 0.0;
+        }
+        u.psVelocity()[0] = vt[0];
+        u.psVelocity()[1] = vt[1];
+    }
+
     const SphereVelocity
     operator+(const SphereVelocity &other) const;
 
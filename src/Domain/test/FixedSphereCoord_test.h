@@ -0,0 +1,53 @@
+#ifndef __GEOMTK_FixedSphereCoord_test__
+#define __GEOMTK_FixedSphereCoord_test__
+
+#include "SphereCoord.h"
+#include "SphereVelocity.h"
+#include "SphereDomain.h"
+#include <type_traits>
+
+using namespace geomtk;
+
+TEST(FixedSphereCoord, Basic) {
+    ASSERT_TRUE(std::is_trivially_copyable<FixedSpaceCoord<2> >::value);
+    ASSERT_TRUE(std::is_trivially_copyable<FixedSphereCoord<3> >::value);
+    ASSERT_TRUE(std::is_trivially_copyable<FixedVelocity<3> >::value);
+    ASSERT_TRUE(std::is_trivially_copyable<FixedSphereVelocity<3> >::value);
+    ASSERT_EQ(6*sizeof(double), sizeof(FixedSphereCoord<2>));
+    ASSERT_EQ(5*sizeof(double), sizeof(FixedSphereVelocity<3>));
+}
+
+TEST(FixedSphereCoord, SameAsSphereCoord) {
+    SphereDomain domain(2);
+    SphereCoord x(2);
+    FixedSphereCoord<2> y;
+    x.set(30.0/RAD, -60.0/RAD);
+    x.get(y);
+    ASSERT_EQ(x(0), y(0));
+    ASSERT_EQ(x(1), y(1));
+    ASSERT_EQ(x.cosLat(), y.cosLat());
+    ASSERT_EQ(x.sinLon(), y.sinLon());
+    double xt[2];
+    x.transformToPS(domain);
+    y.transformToPS(domain.radius(), xt);
+    ASSERT_EQ(x.psCoord()[0], xt[0]);
+    ASSERT_EQ(x.psCoord()[1], xt[1]);
+    y.transformFromPS(domain.radius(), SOUTH_POLE, xt);
+    ASSERT_GT(1.0e-14, fabs(y(0)-30.0/RAD));
+    ASSERT_GT(1.0e-14, fabs(y(1)+60.0/RAD));
+    // Velocity transformation
+    SphereVelocity u(2);
+    FixedSphereVelocity<2> v;
+    u(0) = 10.0; u(1) = -5.0;
+    u.get(v);
+    u.transformToPS(x);
+    v.transformToPS(y);
+    ASSERT_GT(1.0e-12, fabs(u.psVelocity()[0]-v.psVelocity()[0]));
+    ASSERT_GT(1.0e-12, fabs(u.psVelocity()[1]-v.psVelocity()[1]));
+    v = (v+v)*0.5;
+    v.transformFromPS(y);
+    ASSERT_GT(1.0e-12, fabs(v(0)-10.0));
+    ASSERT_GT(1.0e-12, fabs(v(1)+5.0));
+}
+
+#endif // __GEOMTK_FixedSphereCoord_test__
@@ -0,0 +1,106 @@
+#ifndef __GEOMTK_PointIndex_test__
+#define __GEOMTK_PointIndex_test__
+
+#include "SphereDomain.h"
+#include "PointIndex.h"
+
+using namespace geomtk;
+
+class PointIndexTest : public ::testing::Test {
+protected:
+    SphereDomain *domain;
+    mat points, queries;
+
+    virtual void SetUp() {
+        domain = new SphereDomain(2);
+        domain->radius() = 1.0;
+        setPoints(200, 0.0, points);
+        setPoints(20, 0.5, queries);
+    }
+
+    virtual void TearDown() {
+        delete domain;
+    }
+
+    void
+    setPoints(uword n, double shift, mat &x) {
+        SphereCoord y(2);
+        x.set_size(3, n);
+        for (uword i = 0; i < n; ++i) {
+            y.set(fmod(i*2.39996+shift, PI2), asin(2.0*(i+0.5)/n-1.0));
+            y.transformToCart(*domain);
+            x.col(i) = y.cartCoord();
+        }
+    }
+
+    void
+    checkRadius(PointIndex<SphereDomain> &index, double radius) {
+        vector<vector<uword> > neighbors;
+        vector<vector<double> > distances;
+        index.searchRadius(queries, radius, neighbors, distances);
+        ASSERT_EQ(queries.n_cols, neighbors.size());
+        for (uword q = 0; q < queries.n_cols; ++q) {
+            uword n = 0;
+            for (uword i = 0; i < points.n_cols; ++i) {
+                if (norm(queries.col(q)-points.col(i)) <= radius) n++;
+            }
+            ASSERT_EQ(n, neighbors[q].size());
+            for (uword l = 0; l < neighbors[q].size(); ++l) {
+                double d = norm(queries.col(q)-points.col(neighbors[q][l]));
+                ASSERT_NEAR(d, distances[q][l], 1.0e-12);
+            }
+        }
+    }
+
+    void
+    checkNearest(PointIndex<SphereDomain> &index, uword k) {
+        umat neighbors;
+        mat distances;
+        index.searchNearest(queries, k, neighbors, distances);
+        for (uword q = 0; q < queries.n_cols; ++q) {
+            vec d(points.n_cols);
+            for (uword i = 0; i < points.n_cols; ++i) {
+                d[i] = norm(queries.col(q)-points.col(i));
+            }
+            // brute force neighbors (the test points have no distance ties)
+            uvec order = sort_index(d);
+            for (uword l = 0; l < k; ++l) {
+                ASSERT_EQ(order[l], neighbors(l, q));
+                ASSERT_NEAR(d[order[l]], distances(l, q), 1.0e-12);
+            }
+        }
+    }
+};
+
+TEST_F(PointIndexTest, Search) {
+    PointIndex<SphereDomain> index(*domain);
+    index.build(points);
+    checkRadius(index, 0.3);
+    checkNearest(index, 5);
+}
+
+TEST_F(PointIndexTest, Update) {
+    PointIndex<SphereDomain> index(*domain);
+    index.setRebuildThreshold(0.1);
+    index.build(points);
+    checkNearest(index, 5);
+    // Move the points a little and unevenly, so the trees are kept but the
+    // neighbors may change.
+    for (uword i = 0; i < points.n_cols; ++i) {
+        points(0, i) += 0.03*sin(i*0.7);
+        points(2, i) += 0.03*cos(i*1.3);
+    }
+    index.update(points);
+    ASSERT_LT(0.0, index.maxDisplacement());
+    ASSERT_GT(index.rebuildThreshold(), index.maxDisplacement());
+    checkRadius(index, 0.3);
+    checkNearest(index, 5);
+    // Move the points far away, so the trees are rebuilt.
+    setPoints(200, 1.0, points);
+    index.update(points);
+    ASSERT_EQ(0.0, index.maxDisplacement());
+    checkRadius(index, 0.3);
+    checkNearest(index, 5);
+}
+
+#endif // __GEOMTK_PointIndex_test__
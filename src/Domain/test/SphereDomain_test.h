@@ -54,6 +54,49 @@ TEST_F(SphereDomainTest, CalculateDistance) {
     ASSERT_EQ(x(1)-y(1), d);
 }
 
+TEST_F(SphereDomainTest, BatchedKernels) {
+    const int n = 8;
+    SphereCoord x(2), y(2), xp(2);
+    x.set(0.3*M_PI, 0.41*M_PI);
+    xp.set(1.2*M_PI, 0.1*M_PI);
+    double lon[n], lat[n], cosLon[n], sinLon[n], cosLat[n], sinLat[n], d[n];
+    for (int i = 0; i < n; ++i) {
+        lon[i] = i*PI2/n;
+        lat[i] = (i-3.5)*0.2;
+        cosLon[i] = cos(lon[i]);
+        sinLon[i] = sin(lon[i]);
+        cosLat[i] = cos(lat[i]);
+        sinLat[i] = sin(lat[i]);
+    }
+    domain->calcDistances(x, n, cosLon, sinLon, cosLat, sinLat, d);
+    for (int i = 0; i < n; ++i) {
+        ASSERT_NEAR(domain->calcDistance(x, lon[i], lat[i]), d[i], 1.0e-12);
+    }
+    domain->calcDistances(x, n, cosLon, sinLon, cosLat[0], sinLat[0], d,
+                          SphereDomain::CHORD);
+    for (int i = 0; i < n; ++i) {
+        double dist = domain->calcDistance(x, lon[i], lat[0]);
+        ASSERT_NEAR(2*sin(0.5*dist), d[i], 1.0e-12);
+    }
+    // The same point gives zero distance exactly.
+    cosLon[0] = x.cosLon();
+    sinLon[0] = x.sinLon();
+    domain->calcDistances(x, 1, cosLon, sinLon, x.cosLat(), x.sinLat(), d);
+    ASSERT_EQ(0.0, d[0]);
+    double lonR[n], latR[n], lon1[n], lat1[n];
+    domain->rotate(xp, n, lon, lat, lonR, latR);
+    domain->rotateBack(xp, n, lonR, latR, lon1, lat1);
+    for (int i = 0; i < n; ++i) {
+        y.set(lon[i], lat[i]);
+        double lonR0, latR0;
+        domain->rotate(xp, y, lonR0, latR0);
+        ASSERT_NEAR(lonR0, lonR[i], 1.0e-12);
+        ASSERT_NEAR(latR0, latR[i], 1.0e-12);
+        ASSERT_NEAR(lat[i], lat1[i], 1.0e-12);
+        ASSERT_NEAR(0.0, sin(0.5*(lon[i]-lon1[i])), 1.0e-12);
+    }
+}
+
 TEST_F(SphereDomainTest, TransformPS) {
     SphereCoord x(2);
     double lon = 0.34*M_PI;
@@ -8,6 +8,7 @@ calcDivergence(const TimeLevelIndex<2> &timeIdx) {
     case 2:
         if (v[0].staggerLocation() == Location::CENTER &&
             v[1].staggerLocation() == Location::CENTER) {
+            #pragma omp parallel for
             for (uword j = mesh().js(GridType::FULL); j <= mesh().je(GridType::FULL); ++j) {
                 for (uword i = mesh().is(GridType::FULL); i <= mesh().ie(GridType::FULL); ++i) {
                     double u1 = v[0](timeIdx, i-1, j);
@@ -25,6 +26,7 @@ calcDivergence(const TimeLevelIndex<2> &timeIdx) {
             }
         } else if (v[0].staggerLocation() == Location::X_FACE &&
                    v[1].staggerLocation() == Location::Y_FACE) {
+            #pragma omp parallel for
             for (uword j = mesh().js(GridType::FULL); j <= mesh().je(GridType::FULL); ++j) {
                 for (uword i = mesh().is(GridType::FULL); i <= mesh().ie(GridType::FULL); ++i) {
                     double u1 = v[0](timeIdx, i-1, j);
@@ -46,7 +48,8 @@ calcDivergence(const TimeLevelIndex<2> &timeIdx) {
         if (v[0].staggerLocation() == Location::CENTER &&
             v[1].staggerLocation() == Location::CENTER &&
             v[2].staggerLocation() == Location::CENTER) {
-            for (uword k = mesh().ks(GridType::FULL); k <= mesh().ks(GridType::FULL); ++k) {
+            #pragma omp parallel for collapse(2)
+            for (uword k = mesh().ks(GridType::FULL); k <= mesh().ke(GridType::FULL); ++k) {
                 for (uword j = mesh().js(GridType::FULL); j <= mesh().je(GridType::FULL); ++j) {
                     for (uword i = mesh().is(GridType::FULL); i <= mesh().ie(GridType::FULL); ++i) {
                         double u1 = v[0](timeIdx, i-1, j, k);
@@ -61,17 +64,18 @@ calcDivergence(const TimeLevelIndex<2> &timeIdx) {
                         double dvdy = (v2-v1)/dy;
                         double w1 = v[2](timeIdx, i, j, k-1);
                         double w2 = v[2](timeIdx, i, j, k+1);
-                        double dz = (mesh().gridInterval(2, GridType::FULL, j-1)+
-                                     mesh().gridInterval(2, GridType::FULL, j));
+                        double dz = (mesh().gridInterval(2, GridType::FULL, k-1)+
+                                     mesh().gridInterval(2, GridType::FULL, k));
                         double dwdz = (w2-w1)/dz;
-                        div(timeIdx, i, j) = dudx+dvdy+dwdz;
+                        div(timeIdx, i, j, k) = dudx+dvdy+dwdz;
                     }
                 }
             }
         } else if (v[0].staggerLocation() == Location::X_FACE &&
                    v[1].staggerLocation() == Location::Y_FACE &&
                    v[2].staggerLocation() == Location::Z_FACE) {
-            for (uword k = mesh().ks(GridType::FULL); k <= mesh().ks(GridType::FULL); ++k) {
+            #pragma omp parallel for collapse(2)
+            for (uword k = mesh().ks(GridType::FULL); k <= mesh().ke(GridType::FULL); ++k) {
                 for (uword j = mesh().js(GridType::FULL); j <= mesh().je(GridType::FULL); ++j) {
                     for (uword i = mesh().is(GridType::FULL); i <= mesh().ie(GridType::FULL); ++i) {
                         double u1 = v[0](timeIdx, i-1, j, k);
@@ -86,7 +90,7 @@ calcDivergence(const TimeLevelIndex<2> &timeIdx) {
                         double w2 = v[2](timeIdx, i, j, k+1);
                         double dz = mesh().gridInterval(2, GridType::HALF, k);
                         double dwdz = (w2-w1)/dz;
-                        div(timeIdx, i, j) = dudx+dvdy+dwdz;
+                        div(timeIdx, i, j, k) = dudx+dvdy+dwdz;
                     }
                 }
             }
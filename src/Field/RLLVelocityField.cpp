@@ -25,9 +25,9 @@ create(const RLLMesh &mesh, bool hasHalfLevel) {
                   mesh.numGrid(2, GridType::FULL));
     for (uword k = 0; k < vr.n_cols; ++k) {
         for (uword i = 0; i < vr.n_rows; ++i) {
-            vr(i, k) = new TimeLevels<SphereVelocity, 2>(hasHalfLevel);
+            vr(i, k) = new TimeLevels<FixedSphereVelocity<3>, 2>(hasHalfLevel);
             for (int l = 0; l < vr(i, k)->numLevel(INCLUDE_HALF_LEVEL); ++l) {
-                vr(i, k)->level(l).setNumDim(mesh.domain().numDim());
+                vr(i, k)->level(l).fill(0.0);
             }
             divr(i, k) = new TimeLevels<double, 2>(hasHalfLevel);
         }
@@ -42,6 +42,7 @@ update(const TimeLevelIndex<2> &timeIdx, Pole pole,
     // Set zonal wind speed.
     int j = pole == SOUTH_POLE ? mesh->js(GridType::FULL)+1 : mesh->je(GridType::FULL)-1; // off the Pole
     if (v[0].staggerLocation() == Location::X_FACE) { // C-grid
+        #pragma omp parallel for collapse(2)
         for (uword k = mesh->ks(GridType::FULL); k <= mesh->ke(GridType::FULL); ++k) {
             for (uword i = mesh->is(GridType::FULL); i <= mesh->ie(GridType::FULL); ++i) {
                 vr(i, k)->level(timeIdx)(0) =
@@ -56,6 +57,7 @@ update(const TimeLevelIndex<2> &timeIdx, Pole pole,
             vr(mesh->is(GridType::FULL), k)->level(timeIdx)(0);
         }
     } else if (v[0].staggerLocation() == Location::CENTER) { // A-grid
+        #pragma omp parallel for collapse(2)
         for (uword k = mesh->ks(GridType::FULL); k <= mesh->ke(GridType::FULL); ++k) {
             for (uword i = mesh->is(GridType::FULL)-1; i <= mesh->ie(GridType::FULL)+1; ++i) {
                 vr(i, k)->level(timeIdx)(0) = v[0](timeIdx, i, j, k);
@@ -65,6 +67,7 @@ update(const TimeLevelIndex<2> &timeIdx, Pole pole,
     // Set vertical wind speed.
     if (mesh->domain().numDim() == 3) {
         if (v[2].staggerLocation() == Location::Z_FACE) { // C-grid
+            #pragma omp parallel for collapse(2)
             for (uword k = mesh->ks(GridType::FULL); k <= mesh->ke(GridType::FULL); ++k) {
                 for (uword i = mesh->is(GridType::FULL)-1; i <= mesh->ie(GridType::FULL)+1; ++i) {
                     vr(i, k)->level(timeIdx)(2) =
@@ -72,6 +75,7 @@ update(const TimeLevelIndex<2> &timeIdx, Pole pole,
                 }
             }
         } else if (v[2].staggerLocation() == Location::CENTER) { // A-grid
+            #pragma omp parallel for collapse(2)
             for (uword k = mesh->ks(GridType::FULL); k <= mesh->ke(GridType::FULL); ++k) {
                 for (uword i = mesh->is(GridType::FULL)-1; i <= mesh->ie(GridType::FULL)+1; ++i) {
                     vr(i, k)->level(timeIdx)(2) = v[2](timeIdx, i, j, k);
@@ -80,6 +84,7 @@ update(const TimeLevelIndex<2> &timeIdx, Pole pole,
         }
     }
     // Set divergence.
+    #pragma omp parallel for collapse(2)
     for (uword k = mesh->ks(GridType::FULL); k <= mesh->ke(GridType::FULL); ++k) {
         for (uword i = mesh->is(GridType::FULL)-1; i <= mesh->ie(GridType::FULL)+1; ++i) {
             divr(i, k)->level(timeIdx) = div(timeIdx, i, j, k);
@@ -88,6 +93,7 @@ update(const TimeLevelIndex<2> &timeIdx, Pole pole,
     // Set meridional wind speed.
     j = pole == SOUTH_POLE ? mesh->js(GridType::HALF) : mesh->je(GridType::HALF)-1;
     if (v[1].staggerLocation() == Location::Y_FACE) { // C-grid
+        #pragma omp parallel for collapse(2)
         for (uword k = mesh->ks(GridType::FULL); k <= mesh->ke(GridType::FULL); ++k) {
             for (uword i = mesh->is(GridType::FULL)-1; i <= mesh->ie(GridType::FULL)+1; ++i) {
                 vr(i, k)->level(timeIdx)(1) =
@@ -95,6 +101,7 @@ update(const TimeLevelIndex<2> &timeIdx, Pole pole,
             }
         }
     } else if (v[1].staggerLocation() == Location::CENTER) { // A-grid
+        #pragma omp parallel for collapse(2)
         for (uword k = mesh->ks(GridType::FULL); k <= mesh->ke(GridType::FULL); ++k) {
             for (uword i = mesh->is(GridType::FULL)-1; i <= mesh->ie(GridType::FULL)+1; ++i) {
                 vr(i, k)->level(timeIdx)(1) = v[1](timeIdx, i, j, k);
@@ -102,26 +109,28 @@ update(const TimeLevelIndex<2> &timeIdx, Pole pole,
         }
     }
     // Transform velocity.
-    double cosLon, sinLon, sinLat, sinLat2;
     j = pole == SOUTH_POLE ? mesh->js(GridType::FULL)+1 : mesh->je(GridType::FULL)-1; // off the Pole
-    sinLat = mesh->sinLat(GridType::FULL, j);
-    sinLat2 = mesh->sinLat2(GridType::FULL, j);
+    double sinLat = mesh->sinLat(GridType::FULL, j);
+    double sinLat2 = mesh->sinLat2(GridType::FULL, j);
+    // The half level is computed in the same loop, since the ring is small and
+    // the new level is already in cache.
+    bool hasHalfLevel = updateHalfLevel && vr(0, 0)->hasHalfLevel();
+    TimeLevelIndex<2> halfTimeIdx, oldTimeIdx;
+    if (hasHalfLevel) {
+        halfTimeIdx = timeIdx-0.5;
+        oldTimeIdx = timeIdx-1;
+    }
+    #pragma omp parallel for collapse(2)
     for (uword k = mesh->ks(GridType::FULL); k <= mesh->ke(GridType::FULL); ++k) {
         for (uword i = mesh->is(GridType::FULL)-1; i <= mesh->ie(GridType::FULL)+1; ++i) {
-            cosLon = mesh->cosLon(GridType::FULL, i);
-            sinLon = mesh->sinLon(GridType::FULL, i);
-            vr(i, k)->level(timeIdx).transformToPS(sinLat, sinLat2, sinLon, cosLon);
-        }
-    }
-    // Update half level.
-    if (updateHalfLevel && vr(0, 0)->hasHalfLevel()) {
-        TimeLevelIndex<2> halfTimeIdx = timeIdx-0.5;
-        TimeLevelIndex<2> oldTimeIdx = timeIdx-1;
-        for (uword k = 0; k < vr.n_cols; ++k) {
-            for (uword i = 0; i < vr.n_rows; ++i) {
-                vr(i, k)->level(halfTimeIdx) =
-                    (vr(i, k)->level(oldTimeIdx)+
-                     vr(i, k)->level(timeIdx))*0.5;
+            double cosLon = mesh->cosLon(GridType::FULL, i);
+            double sinLon = mesh->sinLon(GridType::FULL, i);
+            TimeLevels<FixedSphereVelocity<3>, 2> &x = *vr(i, k);
+            x.level(timeIdx).transformToPS(sinLat, sinLat2, sinLon, cosLon);
+            if (hasHalfLevel) {
+                x.level(halfTimeIdx.get()) =
+                    (x.level(oldTimeIdx)+x.level(timeIdx))*0.5;
+                x.setHalfLevelUpdated(halfTimeIdx);
             }
         }
     }
@@ -213,6 +222,7 @@ void RLLVelocityField::
 calcDivergence(const TimeLevelIndex<2> &timeIdx) {
     if (v[0].staggerLocation() == Location::CENTER &&
         v[1].staggerLocation() == Location::CENTER) {
+        #pragma omp parallel for
         for (uword j = mesh().js(GridType::FULL)+1; j <= mesh().je(GridType::FULL)-1; ++j) {
             double ReCosLat = mesh().domain().radius()*mesh().cosLat(GridType::FULL, j);
             for (uword i = mesh().is(GridType::FULL); i <= mesh().ie(GridType::FULL); ++i) {
@@ -229,6 +239,7 @@ calcDivergence(const TimeLevelIndex<2> &timeIdx) {
         }
     } else if (v[0].staggerLocation() == Location::X_FACE &&
                v[1].staggerLocation() == Location::Y_FACE) {
+        #pragma omp parallel for
         for (uword j = mesh().js(GridType::FULL)+1; j <= mesh().je(GridType::FULL)-1; ++j) {
             double ReCosLat = mesh().domain().radius()*mesh().cosLat(GridType::FULL, j);
             for (uword i = mesh().is(GridType::FULL); i <= mesh().ie(GridType::FULL); ++i) {
@@ -251,6 +262,7 @@ calcVorticity(const TimeLevelIndex<2> &timeIdx) {
     if (v[0].staggerLocation() == Location::CENTER &&
         v[1].staggerLocation() == Location::CENTER) {
         if (mesh().domain().numDim() == 2) {
+            #pragma omp parallel for
             for (uword j = mesh().js(GridType::FULL)+1; j <= mesh().je(GridType::FULL)-1; ++j) {
                 double ReCosLat = mesh().domain().radius()*mesh().cosLat(GridType::FULL, j);
                 for (uword i = mesh().is(GridType::FULL); i <= mesh().ie(GridType::FULL); ++i) {
@@ -271,6 +283,7 @@ calcVorticity(const TimeLevelIndex<2> &timeIdx) {
     } else if (v[0].staggerLocation() == Location::X_FACE &&
                v[1].staggerLocation() == Location::Y_FACE) {
         if (mesh().domain().numDim() == 2) {
+            #pragma omp parallel for
             for (uword j = mesh().js(GridType::FULL)+1; j <= mesh().je(GridType::FULL)-1; ++j) {
                 double ReCosLat = mesh().domain().radius()*mesh().cosLat(GridType::FULL, j);
                 for (uword i = mesh().is(GridType::FULL); i <= mesh().ie(GridType::FULL); ++i) {
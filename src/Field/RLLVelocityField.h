@@ -20,7 +20,10 @@ public:
     typedef RLLStagger::GridType GridType;
     typedef RLLStagger::Location Location;
 protected:
-    field<TimeLevels<SphereVelocity, 2>*> vr;
+    // NOTE: The velocity is always stored with 3 components (the vertical one
+    //       is zero for 2D domain), so it can be copied and averaged without
+    //       allocation.
+    field<TimeLevels<FixedSphereVelocity<3>, 2>*> vr;
     field<TimeLevels<double, 2>*> divr;
     const RLLMesh *mesh;
 public:
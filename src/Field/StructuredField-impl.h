@@ -51,7 +51,7 @@ create(const string &name, const string &units, const string &longName,
             REPORT_ERROR("Unsupported stagger location!");
             break;
     }
-    data = new TimeLevels<field<DataType>, NumTimeLevel>(hasHalfLevel);
+    data = new TimeLevels<StorageType, NumTimeLevel>(hasHalfLevel);
     for (int i = 0; i < data->numLevel(INCLUDE_HALF_LEVEL); ++i) {
         if (numDim == 2) {
             data->level(i).set_size(this->mesh().numGrid(0, gridTypes[0], true),
@@ -68,77 +68,33 @@ create(const string &name, const string &units, const string &longName,
 template <class MeshType, typename DataType, int NumTimeLevel>
 const DataType& StructuredField<MeshType, DataType, NumTimeLevel>::
 at(const TimeLevelIndex<NumTimeLevel> &timeIdx, int cellIdx) const {
-    uword i, j, k;
-    switch (this->mesh().domain().numDim()) {
-        case 1:
-            this->mesh().unwrapIndex(staggerLocation(), cellIdx, i);
-            return data->level(timeIdx)(i);
-        case 2:
-            this->mesh().unwrapIndex(staggerLocation(), cellIdx, i, j);
-            return data->level(timeIdx)(i, j);
-        case 3:
-            this->mesh().unwrapIndex(staggerLocation(), cellIdx, i, j, k);
-            return data->level(timeIdx)(i, j, k);
-        default:
-            REPORT_ERROR("Invalid dimension number!");
-    }
+    int i, j, k;
+    this->mesh().indexMap(_staggerLocation).unwrap(cellIdx, i, j, k);
+    return data->level(timeIdx)(i, j, k);
 } // at
 
 template <class MeshType, typename DataType, int NumTimeLevel>
 DataType& StructuredField<MeshType, DataType, NumTimeLevel>::
 at(const TimeLevelIndex<NumTimeLevel> &timeIdx, int cellIdx) {
-    uword i, j, k;
-    switch (this->mesh().domain().numDim()) {
-        case 1:
-            this->mesh().unwrapIndex(staggerLocation(), cellIdx, i);
-            return data->level(timeIdx)(i);
-        case 2:
-            this->mesh().unwrapIndex(staggerLocation(), cellIdx, i, j);
-            return data->level(timeIdx)(i, j);
-        case 3:
-            this->mesh().unwrapIndex(staggerLocation(), cellIdx, i, j, k);
-            return data->level(timeIdx)(i, j, k);
-        default:
-            REPORT_ERROR("Invalid dimension number!");
-    }
+    int i, j, k;
+    this->mesh().indexMap(_staggerLocation).unwrap(cellIdx, i, j, k);
+    return data->level(timeIdx)(i, j, k);
 } // at
 
 template <class MeshType, typename DataType, int NumTimeLevel>
 const DataType& StructuredField<MeshType, DataType, NumTimeLevel>::
 at(int cellIdx) const {
-    uword i, j, k;
-    switch (this->mesh().domain().numDim()) {
-        case 1:
-            this->mesh().unwrapIndex(staggerLocation(), cellIdx, i);
-            return data->level(0)(i);
-        case 2:
-            this->mesh().unwrapIndex(staggerLocation(), cellIdx, i, j);
-            return data->level(0)(i, j);
-        case 3:
-            this->mesh().unwrapIndex(staggerLocation(), cellIdx, i, j, k);
-            return data->level(0)(i, j, k);
-        default:
-            REPORT_ERROR("Invalid dimension number!");
-    }
+    int i, j, k;
+    this->mesh().indexMap(_staggerLocation).unwrap(cellIdx, i, j, k);
+    return data->level(0)(i, j, k);
 } // at
 
 template <class MeshType, typename DataType, int NumTimeLevel>
 DataType& StructuredField<MeshType, DataType, NumTimeLevel>::
 at(int cellIdx) {
-    uword i, j, k;
-    switch (this->mesh().domain().numDim()) {
-        case 1:
-            this->mesh().unwrapIndex(staggerLocation(), cellIdx, i);
-            return data->level(0)(i);
-        case 2:
-            this->mesh().unwrapIndex(staggerLocation(), cellIdx, i, j);
-            return data->level(0)(i, j);
-        case 3:
-            this->mesh().unwrapIndex(staggerLocation(), cellIdx, i, j, k);
-            return data->level(0)(i, j, k);
-        default:
-            REPORT_ERROR("Invalid dimension number!");
-    }
+    int i, j, k;
+    this->mesh().indexMap(_staggerLocation).unwrap(cellIdx, i, j, k);
+    return data->level(0)(i, j, k);
 } // at
 
 template <class MeshType, typename DataType, int NumTimeLevel>
@@ -153,7 +109,7 @@ operator=(const StructuredField<MeshType, DataType, NumTimeLevel> &other) {
         assert(other.data != NULL);
 #endif
         if (data == NULL) {
-            data = new TimeLevels<field<DataType>, NumTimeLevel>(this->hasHalfLevel);
+            data = new TimeLevels<StorageType, NumTimeLevel>(this->hasHalfLevel);
             for (int i = 0; i < data->numLevel(INCLUDE_HALF_LEVEL); ++i) {
                 data->level(i).set_size(this->mesh().numGrid(0, gridTypes[0], true),
                                         this->mesh().numGrid(1, gridTypes[1], true),
@@ -161,16 +117,174 @@ operator=(const StructuredField<MeshType, DataType, NumTimeLevel> &other) {
             }
         }
         for (int l = 0; l < other.data->numLevel(); ++l) {
-            for (uword k = 0; k < other.data->level(l).n_slices; ++k) {
-                for (uword j = 0; j < other.data->level(l).n_cols; ++j) {
-                    for (uword i = 0; i < other.data->level(l).n_rows; ++i) {
-                        data->level(l)(i, j, k) = other.data->level(l)(i, j, k);
-                    }
-                }
-            }
+            data->level(l) = other.data->level(l);
         }
     }
     return *this;
 } // operator=
 
+template <class MeshType, typename DataType, int NumTimeLevel>
+FieldStatistics StructuredField<MeshType, DataType, NumTimeLevel>::
+statisticsOfLevel(const StorageType &d, SummationMode mode) const {
+    const auto &mesh = this->mesh();
+    int is = mesh.is(gridType(0)), ie = mesh.ie(gridType(0));
+    int js = 0, je = 0;
+    if (this->numDim() >= 2) {
+        js = mesh.js(gridType(1));
+        je = mesh.je(gridType(1));
+    }
+    int ks = 0, ke = 0;
+    if (this->numDim() == 3) {
+        ks = mesh.ks(gridType(2));
+        ke = mesh.ke(gridType(2));
+    }
+    int ni = ie-is+1, nj = je-js+1, numRow = nj*(ke-ks+1);
+    bool hasWeight = staggerLocation() == Location::CENTER;
+    vector<PartialStatistics> partials(numRow);
+    #pragma omp parallel
+    {
+        vector<double> w(hasWeight ? ni : 0);
+        #pragma omp for
+        for (int l = 0; l < numRow; ++l) {
+            // The cells are numbered as "at", so the row l starts at l*ni.
+            int cellIdx = l*ni;
+            if (hasWeight) {
+                for (int i = 0; i < ni; ++i) {
+                    w[i] = mesh.cellVolume(cellIdx+i);
+                }
+            }
+            rowStatistics(&d(is, js+l%nj, ks+l/nj), hasWeight ? &w[0] : NULL,
+                          ni, cellIdx, mode, partials[l]);
+        }
+    }
+    // Merge the rows by a fixed pairwise tree.
+    for (int stride = 1; stride < numRow; stride *= 2) {
+        for (int l = 0; l+stride < numRow; l += 2*stride) {
+            mergeStatistics(partials[l], partials[l+stride], mode);
+        }
+    }
+    const PartialStatistics &p = partials[0];
+    FieldStatistics res;
+    res.sum = p.sum+p.sumErr;
+    res.integral = hasWeight ? p.integral+p.integralErr : NAN;
+    res.numFinite = p.numFinite;
+    res.numNan = p.numNan;
+    res.numInf = p.numInf;
+    if (p.numFinite > 0) {
+        res.mean = res.sum/p.numFinite;
+        res.min = p.min;
+        res.max = p.max;
+    } else {
+        res.mean = res.min = res.max = NAN;
+    }
+    res.minIndex = p.minIndex;
+    res.maxIndex = p.maxIndex;
+    return res;
+} // statisticsOfLevel
+
+template <class MeshType, typename DataType, int NumTimeLevel>
+void StructuredField<MeshType, DataType, NumTimeLevel>::
+rowStatistics(const DataType *x, const double *w, uword n, int cellIdx,
+              SummationMode mode, PartialStatistics &res) {
+    double s = 0, se = 0, si = 0, sie = 0;
+    uword numNan = 0, numInf = 0;
+    if (mode == PLAIN_SUMMATION) {
+        if (w != NULL) {
+            #pragma omp simd reduction(+:s,si,numNan,numInf)
+            for (uword i = 0; i < n; ++i) {
+                double v = static_cast<double>(x[i]);
+                numNan += std::isnan(v);
+                numInf += std::isinf(v);
+                v = std::isfinite(v) ? v : 0.0;
+                s += v;
+                si += v*w[i];
+            }
+        } else {
+            #pragma omp simd reduction(+:s,numNan,numInf)
+            for (uword i = 0; i < n; ++i) {
+                double v = static_cast<double>(x[i]);
+                numNan += std::isnan(v);
+                numInf += std::isinf(v);
+                s += std::isfinite(v) ? v : 0.0;
+            }
+        }
+    } else {
+        // Neumaier's variant of Kahan summation
+        for (uword i = 0; i < n; ++i) {
+            double v = static_cast<double>(x[i]);
+            if (!std::isfinite(v)) {
+                numNan += std::isnan(v);
+                numInf += std::isinf(v);
+                continue;
+            }
+            double t = s+v;
+            se += fabs(s) >= fabs(v) ? (s-t)+v : (v-t)+s;
+            s = t;
+            if (w != NULL) {
+                double vw = v*w[i];
+                t = si+vw;
+                sie += fabs(si) >= fabs(vw) ? (si-t)+vw : (vw-t)+si;
+                si = t;
+            }
+        }
+    }
+    res.sum = s;
+    res.sumErr = se;
+    res.integral = si;
+    res.integralErr = sie;
+    res.numNan = numNan;
+    res.numInf = numInf;
+    res.numFinite = n-numNan-numInf;
+    res.min = std::numeric_limits<double>::infinity();
+    res.max = -std::numeric_limits<double>::infinity();
+    res.minIndex = -1;
+    res.maxIndex = -1;
+    if (res.numFinite == 0) return;
+    // The row is still in cache, so the extrema are searched in another loop
+    // without breaking the vectorization of the sums.
+    for (uword i = 0; i < n; ++i) {
+        double v = static_cast<double>(x[i]);
+        if (!std::isfinite(v)) continue;
+        if (v < res.min) {
+            res.min = v;
+            res.minIndex = cellIdx+i;
+        }
+        if (v > res.max) {
+            res.max = v;
+            res.maxIndex = cellIdx+i;
+        }
+    }
+} // rowStatistics
+
+template <class MeshType, typename DataType, int NumTimeLevel>
+void StructuredField<MeshType, DataType, NumTimeLevel>::
+mergeStatistics(PartialStatistics &a, const PartialStatistics &b,
+                SummationMode mode) {
+    if (mode == PLAIN_SUMMATION) {
+        a.sum += b.sum;
+        a.integral += b.integral;
+    } else {
+        // Knuth's TwoSum keeps the exact rounding error of each addition.
+        double t = a.sum+b.sum, z = t-a.sum;
+        a.sumErr += ((a.sum-(t-z))+(b.sum-z))+b.sumErr;
+        a.sum = t;
+        t = a.integral+b.integral;
+        z = t-a.integral;
+        a.integralErr += ((a.integral-(t-z))+(b.integral-z))+b.integralErr;
+        a.integral = t;
+    }
+    a.numFinite += b.numFinite;
+    a.numNan += b.numNan;
+    a.numInf += b.numInf;
+    // The rows of a are before the ones of b, so the first extremum is kept.
+    if (b.min < a.min) {
+        a.min = b.min;
+        a.minIndex = b.minIndex;
+    }
+    if (b.max > a.max) {
+        a.max = b.max;
+        a.maxIndex = b.maxIndex;
+    }
+} // mergeStatistics
+
 } // geomtk
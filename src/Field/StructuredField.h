@@ -3,20 +3,73 @@
 
 #include "Field.h"
 #include "StructuredMesh.h"
+#include "StructuredRange.h"
+#include "AlignedArray.h"
 
 namespace geomtk {
 
+/**
+ *  This trait selects the storage of one time level of a structured field.
+ *  Arithmetic types are stored in a contiguous aligned buffer, whereas other
+ *  types (e.g. classes) fall back to arma::field.
+ */
+template <typename DataType, bool IsArithmetic = is_arithmetic<DataType>::value>
+struct StructuredFieldStorage {
+    typedef field<DataType> type;
+};
+
+template <typename DataType>
+struct StructuredFieldStorage<DataType, true> {
+    typedef AlignedArray<DataType> type;
+};
+
+/**
+ *  The summation modes of the field reductions. The data are reduced row by
+ *  row and the row results are combined by a fixed pairwise tree, so both
+ *  modes give the same bits for any thread number. COMPENSATED_SUMMATION also
+ *  carries the rounding error of each addition, so the result is nearly
+ *  correctly rounded and hardly depends on the data order.
+ */
+enum SummationMode {
+    PLAIN_SUMMATION, COMPENSATED_SUMMATION
+};
+
+/**
+ *  The statistics of the interior grids of a field computed in one pass. The
+ *  NaN and Inf values are counted and excluded from the others. The extremum
+ *  indices are the cell indices used by "at" (-1 when there is no finite
+ *  value), and the first one is taken when there is a tie. The integral is
+ *  weighted by Mesh::cellVolume, so it is only computed for the fields on
+ *  CENTER location, otherwise it is NaN.
+ */
+struct FieldStatistics {
+    double sum;
+    double integral;
+    double mean;
+    double min;
+    double max;
+    int minIndex;
+    int maxIndex;
+    uword numFinite;
+    uword numNan;
+    uword numInf;
+};
+
 /**
  *  This class specifies the scalar field on structured mesh. The data type is
  *  templated, so any proper basic type (e.g. double) and classes can be used.
+ *  For basic types, each time level is a contiguous aligned buffer (see
+ *  AlignedArray), so "(*this)(timeIdx).memptr()" and "stride" can be used by
+ *  the performance-critical loops.
  */
 template <class MeshType, typename DataType, int NumTimeLevel = 1>
 class StructuredField : public Field<MeshType> {
 public:
     typedef StructuredStagger::GridType GridType;
     typedef StructuredStagger::Location Location;
+    typedef typename StructuredFieldStorage<DataType>::type StorageType;
 protected:
-    TimeLevels<field<DataType>, NumTimeLevel> *data;
+    TimeLevels<StorageType, NumTimeLevel> *data;
     int _staggerLocation;
     vector<int> gridTypes;
 public:
@@ -27,22 +80,22 @@ public:
     create(const string &name, const string &units, const string &longName,
            const MeshType &mesh, int loc, int numDim, bool hasHalfLevel = false);
 
-    const field<DataType>&
+    const StorageType&
     operator()(const TimeLevelIndex<NumTimeLevel> &timeIdx) const {
         return data->level(timeIdx);
     }
 
-    field<DataType>&
+    StorageType&
     operator()(const TimeLevelIndex<NumTimeLevel> &timeIdx) {
         return data->level(timeIdx);
     }
 
-    const field<DataType>&
+    const StorageType&
     operator()() const {
         return data->level(0);
     }
 
-    field<DataType>&
+    StorageType&
     operator()() {
         return data->level(0);
     }
@@ -79,6 +132,47 @@ public:
     DataType&
     at(int cellIdx);
 
+    /**
+     *  Get the element by the cell index with the given index map, which is
+     *  usually StructuredIndexMap<NumDim> converted from "indexMap()" once
+     *  before the loop, so the index arithmetic is resolved for the dimension
+     *  at compile time.
+     */
+    template <int NumDim>
+    const DataType&
+    at(const TimeLevelIndex<NumTimeLevel> &timeIdx,
+       const StructuredIndexMap<NumDim> &map, int cellIdx) const {
+        int i, j, k;
+        map.unwrap(cellIdx, i, j, k);
+        return data->level(timeIdx)(i, j, k);
+    }
+
+    template <int NumDim>
+    DataType&
+    at(const TimeLevelIndex<NumTimeLevel> &timeIdx,
+       const StructuredIndexMap<NumDim> &map, int cellIdx) {
+        int i, j, k;
+        map.unwrap(cellIdx, i, j, k);
+        return data->level(timeIdx)(i, j, k);
+    }
+
+    const StructuredIndexMap<>&
+    indexMap() const {
+        return this->mesh().indexMap(_staggerLocation);
+    }
+
+    /**
+     *  Get the range of the interior grids or the grids with halos, whose
+     *  cell offsets are in the storage of one time level. The latitude rows
+     *  and vertical columns are got by "row" and "column" of the range.
+     *
+     *  @param hasHalo the flag for including halos.
+     */
+    StructuredRange
+    cells(bool hasHalo = false) const {
+        return StructuredRange(indexMap(), hasHalo, this->numDim());
+    }
+
     StructuredField<MeshType, DataType, NumTimeLevel>&
     operator=(const StructuredField<MeshType, DataType, NumTimeLevel> &other);
 
@@ -89,13 +183,17 @@ public:
     template <typename Q = DataType>
     typename enable_if<has_operator_plus<Q>::value || is_arithmetic<Q>::value, void>::type
     applyBndCond(const TimeLevelIndex<NumTimeLevel> &timeIdx, bool updateHalfLevel = false) {
+        if (this->mesh().isDecomposed()) {
+            REPORT_ERROR("Field \"" << this->name() << "\" is on decomposed " <<
+                         "mesh, so use StructuredHaloExchange for its halos!");
+        }
         int nx = data->level(0).n_rows;
         int ny = data->level(0).n_cols;
         int nz = data->level(0).n_slices;
         const auto &domain = this->mesh().domain();
-        field<DataType> &d = data->level(timeIdx);
+        StorageType &d = data->level(timeIdx);
         if (domain.axisStartBndType(0) == PERIODIC) {
-            // TODO: Need to modify when doing parallel.
+            #pragma omp parallel for collapse(2)
             for (int k = 0; k < nz; ++k) {
                 for (int j = 0; j < ny; ++j) {
                     for (uword i = 0; i < this->mesh().haloWidth(); ++i) {
@@ -106,6 +204,7 @@ public:
             }
         }
         if (domain.axisStartBndType(1) == PERIODIC) {
+            #pragma omp parallel for collapse(2)
             for (int k = 0; k < nz; ++k) {
                 for (int i = 0; i < nx; ++i) {
                     for (uword j = 0; j < this->mesh().haloWidth(); ++j) {
@@ -117,6 +216,7 @@ public:
         }
         if (domain.numDim() == 3) {
             if (domain.axisStartBndType(2) == PERIODIC) {
+                #pragma omp parallel for collapse(2)
                 for (int j = 0; j < ny; ++j) {
                     for (int i = 0; i < nx; ++i) {
                         for (uword k = 0; k < this->mesh().haloWidth(); ++k) {
@@ -127,35 +227,56 @@ public:
                 }
             }
         }
-        if (updateHalfLevel && data->hasHalfLevel()) {
-            if (NumTimeLevel < 2) {
-                REPORT_ERROR("Time level (" << NumTimeLevel << ") is less than 2, " <<
-                             "so there is no half time level!");
-            }
-            TimeLevelIndex<NumTimeLevel> halfTimeIdx = timeIdx-0.5;
-            TimeLevelIndex<NumTimeLevel> oldTimeIdx = timeIdx-1;
-            for (int k = 0; k < nz; ++k) {
-                for (int j = 0; j < ny; ++j) {
-                    for (int i = 0; i < nx; ++i) {
-                        data->level(halfTimeIdx)(i, j, k) =
-                            (data->level(oldTimeIdx)(i, j, k)+
-                             data->level(timeIdx   )(i, j, k))*0.5;
+        if (updateHalfLevel) {
+            invalidateHalfLevel(timeIdx);
+        }
+    }
+
+    /**
+     *  Mark the half level (if any) around the given time level to be updated
+     *  on its next access. It is called by applyBndCond(timeIdx, true), and
+     *  also by StructuredHaloUpdate after the halos are filled.
+     */
+    template <typename Q = DataType>
+    typename enable_if<has_operator_plus<Q>::value || is_arithmetic<Q>::value, void>::type
+    invalidateHalfLevel(const TimeLevelIndex<NumTimeLevel> &timeIdx) {
+        if (!data->hasHalfLevel()) return;
+        if (NumTimeLevel < 2) {
+            REPORT_ERROR("Time level (" << NumTimeLevel << ") is less than 2, " <<
+                         "so there is no half time level!");
+        }
+        if (!data->hasHalfLevelUpdater()) {
+            data->setHalfLevelUpdater(
+                [](const StorageType &a, const StorageType &b, StorageType &c) {
+                    int nx = a.n_rows, ny = a.n_cols, nz = a.n_slices;
+                    #pragma omp parallel for collapse(2)
+                    for (int k = 0; k < nz; ++k) {
+                        for (int j = 0; j < ny; ++j) {
+                            for (int i = 0; i < nx; ++i) {
+                                c(i, j, k) = (a(i, j, k)+b(i, j, k))*0.5;
+                            }
+                        }
                     }
-                }
-            }
+                });
         }
+        // The half level is computed on its first access.
+        data->invalidateHalfLevel(timeIdx);
     }
 
     template <typename Q = DataType>
     typename enable_if<has_operator_plus<Q>::value || is_arithmetic<Q>::value, void>::type
     applyBndCond() {
+        if (this->mesh().isDecomposed()) {
+            REPORT_ERROR("Field \"" << this->name() << "\" is on decomposed " <<
+                         "mesh, so use StructuredHaloExchange for its halos!");
+        }
         int nx = data->level(0).n_rows;
         int ny = data->level(0).n_cols;
         int nz = data->level(0).n_slices;
         const auto &domain = this->mesh().domain();
-        field<DataType> &d = data->level(0);
+        StorageType &d = data->level(0);
         if (domain.axisStartBndType(0) == PERIODIC) {
-            // TODO: Need to modify when doing parallel.
+            #pragma omp parallel for collapse(2)
             for (int k = 0; k < nz; ++k) {
                 for (int j = 0; j < ny; ++j) {
                     for (int i = 0; i < this->mesh().haloWidth(); ++i) {
@@ -166,6 +287,7 @@ public:
             }
         }
         if (domain.axisStartBndType(1) == PERIODIC) {
+            #pragma omp parallel for collapse(2)
             for (int k = 0; k < nz; ++k) {
                 for (int i = 0; i < nx; ++i) {
                     for (int j = 0; j < this->mesh().haloWidth(); ++j) {
@@ -177,6 +299,7 @@ public:
         }
         if (domain.numDim() == 3) {
             if (domain.axisStartBndType(2) == PERIODIC) {
+                #pragma omp parallel for collapse(2)
                 for (int j = 0; j < ny; ++j) {
                     for (int i = 0; i < nx; ++i) {
                         for (int k = 0; k < this->mesh().haloWidth(); ++k) {
@@ -192,92 +315,167 @@ public:
     template <typename Q = DataType>
     typename enable_if<is_arithmetic<Q>::value, DataType>::type
     max(const TimeLevelIndex<NumTimeLevel> &timeIdx) const {
-        DataType res = -999999;
-        for (uword i = 0; i < this->mesh().totalNumGrid(staggerLocation(), this->numDim()); ++i) {
-            if (res < (*this).at(timeIdx, i)) {
-                res = (*this).at(timeIdx, i);
-            }
-        }
-        return res;
+        return maxOfLevel(data->level(timeIdx));
     }
 
     template <typename Q = DataType>
     typename enable_if<is_arithmetic<Q>::value, DataType>::type
     max() const {
-        DataType res = -999999;
-        for (uword i = 0; i < this->mesh().totalNumGrid(staggerLocation(), this->numDim()); ++i) {
-            if (res < (*this).at(i)) {
-                res = (*this).at(i);
-            }
-        }
-        return res;
+        return maxOfLevel(data->level(0));
     }
 
     template <typename Q = DataType>
     typename enable_if<is_arithmetic<Q>::value, DataType>::type
     min(const TimeLevelIndex<NumTimeLevel> &timeIdx) const {
-        DataType res = 999999;
-        for (uword i = 0; i < this->mesh().totalNumGrid(staggerLocation(), this->numDim()); ++i) {
-            if (res > (*this).at(timeIdx, i)) {
-                res = (*this).at(timeIdx, i);
-            }
-        }
-        return res;
+        return minOfLevel(data->level(timeIdx));
     }
 
     template <typename Q = DataType>
     typename enable_if<is_arithmetic<Q>::value, DataType>::type
     min() const {
-        DataType res = 999999;
-        for (uword i = 0; i < this->mesh().totalNumGrid(staggerLocation(), this->numDim()); ++i) {
-            if (res > (*this).at(i)) {
-                res = (*this).at(i);
-            }
-        }
-        return res;
+        return minOfLevel(data->level(0));
     }
 
     template <typename Q = DataType>
     typename enable_if<is_arithmetic<Q>::value, DataType>::type
     sum(const TimeLevelIndex<NumTimeLevel> &timeIdx) const {
-        DataType res = 0;
-        for (uword i = 0; i < this->mesh().totalNumGrid(staggerLocation(), this->numDim()); ++i) {
-            res += (*this).at(timeIdx, i);
-        }
-        return res;
+        return sumOfLevel(data->level(timeIdx));
     }
 
     template <typename Q = DataType>
     typename enable_if<is_arithmetic<Q>::value, DataType>::type
     sum() const {
-        DataType res = 0;
-        for (uword i = 0; i < this->mesh().totalNumGrid(staggerLocation(), this->numDim()); ++i) {
-            res += (*this).at(i);
-        }
-        return res;
+        return sumOfLevel(data->level(0));
     }
 
     template <typename Q = DataType>
     typename enable_if<is_arithmetic<Q>::value, bool>::type
     hasNan(const TimeLevelIndex<NumTimeLevel> &timeIdx) const {
-        for (uword i = 0; i < this->mesh().totalNumGrid(staggerLocation(), this->numDim()); ++i) {
-            if (std::isnan((*this).at(timeIdx, i))) {
-                return true;
-            }
-        }
-        return false;
+        return hasNanInLevel(data->level(timeIdx));
     }
 
     template <typename Q = DataType>
     typename enable_if<is_arithmetic<Q>::value, bool>::type
     hasNan() const {
-        for (uword i = 0; i < this->mesh().totalNumGrid(staggerLocation(), this->numDim()); ++i) {
-            if (std::isnan((*this).at(i))) {
-                return true;
-            }
+        return hasNanInLevel(data->level(0));
+    }
+
+    /**
+     *  Compute the sum, integral, mean, extrema and NaN/Inf counts together.
+     *
+     *  @param timeIdx the time level index.
+     *  @param mode    the summation mode.
+     *
+     *  @return The statistics.
+     */
+    template <typename Q = DataType>
+    typename enable_if<is_arithmetic<Q>::value, FieldStatistics>::type
+    statistics(const TimeLevelIndex<NumTimeLevel> &timeIdx,
+               SummationMode mode = PLAIN_SUMMATION) const {
+        return statisticsOfLevel(data->level(timeIdx), mode);
+    }
+
+    template <typename Q = DataType>
+    typename enable_if<is_arithmetic<Q>::value, FieldStatistics>::type
+    statistics(SummationMode mode = PLAIN_SUMMATION) const {
+        return statisticsOfLevel(data->level(0), mode);
+    }
+protected:
+    /**
+     *  Apply the operation on each interior row (along x axis) of the given
+     *  time level in parallel. The results are returned in row order, so the
+     *  further reduction does not depend on the thread number.
+     *
+     *  @param d  the data on one time level.
+     *  @param op the operation with signature "ResultType (const DataType *row, uword n)".
+     *
+     *  @return The results of each row.
+     */
+    template <typename ResultType, class RowOp>
+    vector<ResultType>
+    reduceRows(const StorageType &d, RowOp op) const {
+        const auto &mesh = this->mesh();
+        int is = mesh.is(gridType(0)), ie = mesh.ie(gridType(0));
+        int js = 0, je = 0;
+        if (this->numDim() >= 2) {
+            js = mesh.js(gridType(1));
+            je = mesh.je(gridType(1));
+        }
+        int ks = 0, ke = 0;
+        if (this->numDim() == 3) {
+            ks = mesh.ks(gridType(2));
+            ke = mesh.ke(gridType(2));
+        }
+        int nj = je-js+1, numRow = nj*(ke-ks+1);
+        vector<ResultType> res(numRow);
+        #pragma omp parallel for
+        for (int l = 0; l < numRow; ++l) {
+            res[l] = op(&d(is, js+l%nj, ks+l/nj), ie-is+1);
         }
-        return false;
+        return res;
     }
+
+    DataType
+    maxOfLevel(const StorageType &d) const {
+        vector<DataType> res = reduceRows<DataType>(d,
+            [](const DataType *x, uword n) { return *std::max_element(x, x+n); });
+        return *std::max_element(res.begin(), res.end());
+    }
+
+    DataType
+    minOfLevel(const StorageType &d) const {
+        vector<DataType> res = reduceRows<DataType>(d,
+            [](const DataType *x, uword n) { return *std::min_element(x, x+n); });
+        return *std::min_element(res.begin(), res.end());
+    }
+
+    DataType
+    sumOfLevel(const StorageType &d) const {
+        vector<DataType> res = reduceRows<DataType>(d,
+            [](const DataType *x, uword n) {
+                DataType s = 0;
+                for (uword i = 0; i < n; ++i) s += x[i];
+                return s;
+            });
+        DataType s = 0;
+        for (uword l = 0; l < res.size(); ++l) s += res[l];
+        return s;
+    }
+
+    bool
+    hasNanInLevel(const StorageType &d) const {
+        vector<int> res = reduceRows<int>(d,
+            [](const DataType *x, uword n) {
+                for (uword i = 0; i < n; ++i) {
+                    if (std::isnan(x[i])) return 1;
+                }
+                return 0;
+            });
+        return std::find(res.begin(), res.end(), 1) != res.end();
+    }
+
+    /**
+     *  The partial statistics of one row or a group of rows. The sums are kept
+     *  as unevaluated pairs (value plus rounding error) in compensated mode.
+     */
+    struct PartialStatistics {
+        double sum, sumErr;
+        double integral, integralErr;
+        double min, max;
+        int minIndex, maxIndex;
+        uword numFinite, numNan, numInf;
+    };
+
+    FieldStatistics
+    statisticsOfLevel(const StorageType &d, SummationMode mode) const;
+
+    static void
+    rowStatistics(const DataType *x, const double *w, uword n, int cellIdx,
+                  SummationMode mode, PartialStatistics &res);
+
+    static void
+    mergeStatistics(PartialStatistics &a, const PartialStatistics &b,
+                    SummationMode mode);
 }; // StructuredField
 
 } // geomtk
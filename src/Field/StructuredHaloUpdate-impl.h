@@ -0,0 +1,167 @@
+namespace geomtk {
+
+template <class MeshType>
+StructuredHaloUpdate<MeshType>::
+StructuredHaloUpdate() {
+    mesh = NULL;
+    for (int loc = 0; loc < 8; ++loc) {
+        isPlanSet[loc] = false;
+    }
+}
+
+template <class MeshType>
+StructuredHaloUpdate<MeshType>::
+~StructuredHaloUpdate() {
+}
+
+template <class MeshType>
+void StructuredHaloUpdate<MeshType>::
+init(const MeshType &mesh) {
+    this->mesh = &mesh;
+    for (int loc = 0; loc < 8; ++loc) {
+        isPlanSet[loc] = false;
+        plans[loc].clear();
+    }
+    clearFields();
+} // init
+
+template <class MeshType>
+void StructuredHaloUpdate<MeshType>::
+addField(int loc, int numDim, AlignedArray<double> &data, int numTracer) {
+    if (mesh == NULL) {
+        REPORT_ERROR("Halo update is not initialized!");
+    }
+    Entry entry;
+    entry.data = &data;
+    entry.numDim = numDim;
+    entry.numTracer = numTracer;
+    entry.slabs = &plan(loc);
+    int entryIdx = entries.size();
+    entries.push_back(entry);
+    for (uword s = 0; s < entry.slabs->size(); ++s) {
+        int m = (*entry.slabs)[s].axisIdx;
+        if (m >= numDim) continue;
+        Task task;
+        task.entryIdx = entryIdx;
+        task.slabIdx = s;
+        if (m < 2) {
+            for (uword k = 0; k < data.n_slices; ++k) {
+                task.k = k;
+                tasks[m].push_back(task);
+            }
+        } else {
+            task.k = -1;
+            tasks[m].push_back(task);
+        }
+    }
+} // addField
+
+template <class MeshType>
+template <int N>
+void StructuredHaloUpdate<MeshType>::
+addField(const TimeLevelIndex<N> &timeIdx,
+         StructuredField<MeshType, double, N> &f, bool updateHalfLevel) {
+    addField(f.staggerLocation(), f.numDim(), f(timeIdx));
+    if (updateHalfLevel) {
+        postActions.push_back([&f, timeIdx]() { f.invalidateHalfLevel(timeIdx); });
+    }
+} // addField
+
+template <class MeshType>
+template <int N>
+void StructuredHaloUpdate<MeshType>::
+addField(const TimeLevelIndex<N> &timeIdx,
+         StructuredTracerBundle<MeshType, N> &bundle, bool updateHalfLevel) {
+    addField(bundle.staggerLocation(), bundle.numDim(), bundle(timeIdx),
+             bundle.numTracer());
+    if (updateHalfLevel) {
+        postActions.push_back([&bundle, timeIdx]() { bundle.invalidateHalfLevel(timeIdx); });
+    }
+} // addField
+
+template <class MeshType>
+void StructuredHaloUpdate<MeshType>::
+clearFields() {
+    entries.clear();
+    for (int m = 0; m < 3; ++m) {
+        tasks[m].clear();
+    }
+    postActions.clear();
+} // clearFields
+
+template <class MeshType>
+void StructuredHaloUpdate<MeshType>::
+run() {
+    if (mesh->isDecomposed()) {
+        REPORT_ERROR("Mesh is decomposed, so use StructuredHaloExchange " <<
+                     "for the halos!");
+    }
+    // NOTE: The axes are done in order, since the slabs along the latter axes
+    //       contain the halos along the former ones (i.e. corners).
+    for (int m = 0; m < 3; ++m) {
+        const vector<Task> &t = tasks[m];
+        const int n = t.size();
+        #pragma omp parallel for schedule(dynamic)
+        for (int l = 0; l < n; ++l) {
+            const Entry &entry = entries[t[l].entryIdx];
+            copySlab(*entry.data, entry.numTracer,
+                     (*entry.slabs)[t[l].slabIdx], t[l].k);
+        }
+    }
+    for (uword i = 0; i < postActions.size(); ++i) {
+        postActions[i]();
+    }
+} // run
+
+template <class MeshType>
+const vector<typename StructuredHaloUpdate<MeshType>::Slab>& StructuredHaloUpdate<MeshType>::
+plan(int loc) {
+    if (!isPlanSet[loc]) {
+        const StructuredIndexMap<> &map = mesh->indexMap(loc);
+        const int hw = mesh->haloWidth();
+        plans[loc].clear();
+        for (int m = 0; m < map.numDim(); ++m) {
+            if (!map.isPeriodic(m)) continue;
+            int is = map.startIndex(m);
+            int ie = is+map.numGrid(m)-1;
+            Slab slab;
+            slab.axisIdx = m;
+            slab.width = hw;
+            slab.dst = is-hw;
+            slab.src = ie-hw+1;
+            plans[loc].push_back(slab);
+            slab.dst = ie+1;
+            slab.src = is;
+            plans[loc].push_back(slab);
+        }
+        isPlanSet[loc] = true;
+    }
+    return plans[loc];
+} // plan
+
+template <class MeshType>
+void StructuredHaloUpdate<MeshType>::
+copySlab(AlignedArray<double> &d, int numTracer, const Slab &slab, int k) {
+    switch (slab.axisIdx) {
+        case 0: {
+            const int T = numTracer;
+            const uword size = T*slab.width*sizeof(double);
+            for (uword j = 0; j < d.n_cols; ++j) {
+                memcpy(&d(T*slab.dst, j, k), &d(T*slab.src, j, k), size);
+            }
+            break;
+        }
+        case 1:
+            memcpy(&d(0, slab.dst, k), &d(0, slab.src, k),
+                   d.stride(1)*slab.width*sizeof(double));
+            break;
+        case 2:
+            memcpy(d.slice_memptr(slab.dst), d.slice_memptr(slab.src),
+                   d.stride(2)*slab.width*sizeof(double));
+            break;
+        default:
+            REPORT_ERROR("Invalid axis index!");
+    }
+} // copySlab
+
+} // geomtk
@@ -0,0 +1,115 @@
+#ifndef __GEOMTK_StructuredHaloUpdate__
+#define __GEOMTK_StructuredHaloUpdate__
+
+#include "StructuredTracerBundle.h"
+
+namespace geomtk {
+
+/**
+ *  This class fills the periodic halos of several fields and tracer bundles
+ *  on one mesh in one call. The copies are planned once for each stagger
+ *  location as slabs along each periodic axis. The halos along the second and
+ *  third axes are whole rows and slices, so each slab is one memcpy on one
+ *  level, and the ones along the first axis are one memcpy per row (numTracer
+ *  times wider for the tracer bundles). The slab copies of all the fields
+ *  along one axis run in parallel, and the axes are done in order, so the
+ *  corners are the same as applyBndCond. For example,
+ *
+ *      haloUpdate.clearFields();
+ *      haloUpdate.addField(newIdx, u);
+ *      haloUpdate.addField(newIdx, v);
+ *      haloUpdate.addField(newIdx, tracers, true);
+ *      haloUpdate.run();
+ *
+ *  For decomposed meshes, use StructuredHaloExchange instead.
+ */
+template <class MeshType>
+class StructuredHaloUpdate {
+protected:
+    struct Slab {
+        int axisIdx;
+        // start indices of the destination and source along the axis
+        int dst, src;
+        int width;
+    };
+
+    struct Entry {
+        AlignedArray<double> *data;
+        int numDim;
+        int numTracer;
+        const vector<Slab> *slabs;
+    };
+
+    // copy of one slab on one level (k < 0 for the slabs along third axis)
+    struct Task {
+        int entryIdx;
+        int slabIdx;
+        int k;
+    };
+
+    const MeshType *mesh;
+    bool isPlanSet[8];
+    vector<Slab> plans[8];
+    vector<Entry> entries;
+    vector<Task> tasks[3];
+    vector<std::function<void()> > postActions;
+public:
+    StructuredHaloUpdate();
+    virtual ~StructuredHaloUpdate();
+
+    void
+    init(const MeshType &mesh);
+
+    /**
+     *  Add an array whose halos will be filled.
+     *
+     *  @param loc       the stagger location of the array.
+     *  @param numDim    the dimension of the array.
+     *  @param data      the array of one time level (halos included).
+     *  @param numTracer the number of values on each grid, which are
+     *                   contiguous (see StructuredTracerBundle).
+     */
+    void
+    addField(int loc, int numDim, AlignedArray<double> &data,
+             int numTracer = 1);
+
+    /**
+     *  Add one time level of a field. The half level (if required) is marked
+     *  to be updated on its next access after the halos are filled.
+     */
+    template <int N>
+    void
+    addField(const TimeLevelIndex<N> &timeIdx,
+             StructuredField<MeshType, double, N> &f,
+             bool updateHalfLevel = false);
+
+    template <int N>
+    void
+    addField(const TimeLevelIndex<N> &timeIdx,
+             StructuredTracerBundle<MeshType, N> &bundle,
+             bool updateHalfLevel = false);
+
+    void
+    clearFields();
+
+    uword
+    numField() const { return entries.size(); }
+
+    /**
+     *  Fill the halos of all the added fields.
+     */
+    void
+    run();
+protected:
+    const vector<Slab>&
+    plan(int loc);
+
+    static void
+    copySlab(AlignedArray<double> &d, int numTracer, const Slab &slab, int k);
+}; // StructuredHaloUpdate
+
+} // geomtk
+
+#include "StructuredHaloUpdate-impl.h"
+
+#endif // __GEOMTK_StructuredHaloUpdate__
@@ -0,0 +1,177 @@
+namespace geomtk {
+
+template <class MeshType, int NumTimeLevel>
+StructuredTracerBundle<MeshType, NumTimeLevel>::
+StructuredTracerBundle() : Field<MeshType>() {
+    data = NULL;
+    _numTracer = 0;
+    nx = ny = nz = 0;
+}
+
+template <class MeshType, int NumTimeLevel>
+StructuredTracerBundle<MeshType, NumTimeLevel>::
+~StructuredTracerBundle() {
+    if (data != NULL) {
+        delete data;
+    }
+}
+
+template <class MeshType, int NumTimeLevel>
+void StructuredTracerBundle<MeshType, NumTimeLevel>::
+create(const string &name, const string &units, const string &longName,
+       const MeshType &mesh, int loc, int numDim, int numTracer,
+       bool hasHalfLevel) {
+    if (numTracer <= 0) {
+        REPORT_ERROR("Tracer number should be positive!");
+    }
+    Field<MeshType>::create(name, units, longName, mesh, numDim, hasHalfLevel);
+    _staggerLocation = loc;
+    _numTracer = numTracer;
+    gridTypes.resize(numDim);
+    for (int m = 0; m < numDim; ++m) {
+        gridTypes[m] = mesh.gridType(m, loc);
+    }
+    nx = mesh.numGrid(0, gridTypes[0], true);
+    ny = mesh.numGrid(1, gridTypes[1], true);
+    nz = numDim == 3 ? mesh.numGrid(2, gridTypes[2], true) : 1;
+    if (data != NULL) {
+        delete data;
+    }
+    data = new TimeLevels<StorageType, NumTimeLevel>(hasHalfLevel);
+    for (int i = 0; i < data->numLevel(INCLUDE_HALF_LEVEL); ++i) {
+        data->level(i).set_size(_numTracer*nx, ny, nz);
+    }
+    if (hasHalfLevel) {
+        data->setHalfLevelUpdater(
+            [](const StorageType &a, const StorageType &b, StorageType &c) {
+                const double *x = a.memptr(), *y = b.memptr();
+                double *z = c.memptr();
+                const uword n = c.n_elem;
+                #pragma omp parallel for simd
+                for (uword l = 0; l < n; ++l) {
+                    z[l] = (x[l]+y[l])*0.5;
+                }
+            });
+    }
+} // create
+
+template <class MeshType, int NumTimeLevel>
+const double& StructuredTracerBundle<MeshType, NumTimeLevel>::
+at(const TimeLevelIndex<NumTimeLevel> &timeIdx, int tracerIdx, int cellIdx) const {
+    int i, j, k;
+    this->mesh().indexMap(_staggerLocation).unwrap(cellIdx, i, j, k);
+    return (*this)(timeIdx, tracerIdx, i, j, k);
+} // at
+
+template <class MeshType, int NumTimeLevel>
+double& StructuredTracerBundle<MeshType, NumTimeLevel>::
+at(const TimeLevelIndex<NumTimeLevel> &timeIdx, int tracerIdx, int cellIdx) {
+    const StructuredTracerBundle &self = *this;
+    return const_cast<double&>(self.at(timeIdx, tracerIdx, cellIdx));
+} // at
+
+template <class MeshType, int NumTimeLevel>
+template <int N>
+void StructuredTracerBundle<MeshType, NumTimeLevel>::
+setTracer(const TimeLevelIndex<NumTimeLevel> &timeIdx, int tracerIdx,
+          const TimeLevelIndex<N> &fieldTimeIdx,
+          const StructuredField<MeshType, double, N> &f) {
+    checkField(f.staggerLocation());
+    const double *x = f(fieldTimeIdx).memptr();
+    double *y = data->level(timeIdx).memptr()+tracerIdx;
+    const uword n = f(fieldTimeIdx).n_elem;
+    const int T = _numTracer;
+    #pragma omp parallel for
+    for (uword l = 0; l < n; ++l) {
+        y[l*T] = x[l];
+    }
+} // setTracer
+
+template <class MeshType, int NumTimeLevel>
+template <int N>
+void StructuredTracerBundle<MeshType, NumTimeLevel>::
+getTracer(const TimeLevelIndex<NumTimeLevel> &timeIdx, int tracerIdx,
+          const TimeLevelIndex<N> &fieldTimeIdx,
+          StructuredField<MeshType, double, N> &f) const {
+    checkField(f.staggerLocation());
+    const double *x = data->level(timeIdx).memptr()+tracerIdx;
+    double *y = f(fieldTimeIdx).memptr();
+    const uword n = f(fieldTimeIdx).n_elem;
+    const int T = _numTracer;
+    #pragma omp parallel for
+    for (uword l = 0; l < n; ++l) {
+        y[l] = x[l*T];
+    }
+} // getTracer
+
+template <class MeshType, int NumTimeLevel>
+void StructuredTracerBundle<MeshType, NumTimeLevel>::
+applyBndCond(const TimeLevelIndex<NumTimeLevel> &timeIdx, bool updateHalfLevel) {
+    if (this->mesh().isDecomposed()) {
+        REPORT_ERROR("Tracer bundle is on decomposed mesh, so use " <<
+                     "StructuredHaloExchange for its halos!");
+    }
+    const auto &domain = this->mesh().domain();
+    const int T = _numTracer;
+    const int hw = this->mesh().haloWidth();
+    StorageType &d = data->level(timeIdx);
+    if (domain.axisStartBndType(0) == PERIODIC) {
+        // The halo of all tracers on one row is a contiguous slab.
+        const int is = this->mesh().is(gridType(0));
+        const int ie = this->mesh().ie(gridType(0));
+        #pragma omp parallel for collapse(2)
+        for (int k = 0; k < nz; ++k) {
+            for (int j = 0; j < ny; ++j) {
+                memcpy(&d(0, j, k), &d(T*(ie-hw+1), j, k), T*hw*sizeof(double));
+                memcpy(&d(T*(ie+1), j, k), &d(T*is, j, k), T*hw*sizeof(double));
+            }
+        }
+    }
+    if (domain.axisStartBndType(1) == PERIODIC) {
+        const int js = this->mesh().js(gridType(1));
+        const int je = this->mesh().je(gridType(1));
+        #pragma omp parallel for collapse(2)
+        for (int k = 0; k < nz; ++k) {
+            for (int j = 0; j < hw; ++j) {
+                memcpy(&d(0, j, k), &d(0, je-hw+1+j, k), d.n_rows*sizeof(double));
+                memcpy(&d(0, je+1+j, k), &d(0, js+j, k), d.n_rows*sizeof(double));
+            }
+        }
+    }
+    if (this->numDim() == 3 && domain.axisStartBndType(2) == PERIODIC) {
+        const int ks = this->mesh().ks(gridType(2));
+        const int ke = this->mesh().ke(gridType(2));
+        for (int k = 0; k < hw; ++k) {
+            memcpy(d.slice_memptr(k), d.slice_memptr(ke-hw+1+k),
+                   d.stride(2)*sizeof(double));
+            memcpy(d.slice_memptr(ke+1+k), d.slice_memptr(ks+k),
+                   d.stride(2)*sizeof(double));
+        }
+    }
+    if (updateHalfLevel) {
+        invalidateHalfLevel(timeIdx);
+    }
+} // applyBndCond
+
+template <class MeshType, int NumTimeLevel>
+void StructuredTracerBundle<MeshType, NumTimeLevel>::
+invalidateHalfLevel(const TimeLevelIndex<NumTimeLevel> &timeIdx) {
+    if (!data->hasHalfLevel()) return;
+    if (NumTimeLevel < 2) {
+        REPORT_ERROR("Time level (" << NumTimeLevel << ") is less than 2, " <<
+                     "so there is no half time level!");
+    }
+    data->invalidateHalfLevel(timeIdx);
+} // invalidateHalfLevel
+
+template <class MeshType, int NumTimeLevel>
+void StructuredTracerBundle<MeshType, NumTimeLevel>::
+checkField(int loc) const {
+    if (loc != _staggerLocation) {
+        REPORT_ERROR("Field stagger location (" << loc << ") does not match " <<
+                     "tracer bundle \"" << this->name() << "\" (" <<
+                     _staggerLocation << ")!");
+    }
+} // checkField
+
+} // geomtk
@@ -0,0 +1,258 @@
+#ifndef __GEOMTK_StructuredTracerBundle__
+#define __GEOMTK_StructuredTracerBundle__
+
+#include "StructuredField.h"
+
+namespace geomtk {
+
+template <class MeshType, int NumTimeLevel>
+class StructuredTracerBundle;
+
+/**
+ *  This class views one tracer in StructuredTracerBundle with the element
+ *  accessors, the mesh and stagger queries and the boundary condition of
+ *  StructuredField. It is not a StructuredField, and there is no contiguous
+ *  storage of the tracer, so the code that needs the whole field (e.g. the
+ *  I/O or the field regridding) should copy the tracer by "getTracer" and
+ *  "setTracer" of the bundle. The elements are strided by the tracer number,
+ *  so it is for the occasional per-tracer accesses, and the heavy loops
+ *  should work on the bundle directly.
+ */
+template <class MeshType, int NumTimeLevel = 1>
+class StructuredTracerView {
+protected:
+    StructuredTracerBundle<MeshType, NumTimeLevel> *_bundle;
+    int tracerIdx;
+public:
+    StructuredTracerView(StructuredTracerBundle<MeshType, NumTimeLevel> &bundle,
+                         int tracerIdx) {
+        this->_bundle = &bundle;
+        this->tracerIdx = tracerIdx;
+    }
+
+    int
+    tracerIndex() const {
+        return tracerIdx;
+    }
+
+    const StructuredTracerBundle<MeshType, NumTimeLevel>&
+    bundle() const {
+        return *_bundle;
+    }
+
+    StructuredTracerBundle<MeshType, NumTimeLevel>&
+    bundle() {
+        return *_bundle;
+    }
+
+    const MeshType&
+    mesh() const {
+        return _bundle->mesh();
+    }
+
+    int
+    numDim() const {
+        return _bundle->numDim();
+    }
+
+    int
+    staggerLocation() const {
+        return _bundle->staggerLocation();
+    }
+
+    int
+    gridType(int axisIdx) const {
+        return _bundle->gridType(axisIdx);
+    }
+
+    const double&
+    operator()(const TimeLevelIndex<NumTimeLevel> &timeIdx, int i, int j = 0, int k = 0) const {
+        return (*_bundle)(timeIdx, tracerIdx, i, j, k);
+    }
+
+    double&
+    operator()(const TimeLevelIndex<NumTimeLevel> &timeIdx, int i, int j = 0, int k = 0) {
+        return (*_bundle)(timeIdx, tracerIdx, i, j, k);
+    }
+
+    const double&
+    at(const TimeLevelIndex<NumTimeLevel> &timeIdx, int cellIdx) const {
+        return _bundle->at(timeIdx, tracerIdx, cellIdx);
+    }
+
+    double&
+    at(const TimeLevelIndex<NumTimeLevel> &timeIdx, int cellIdx) {
+        return _bundle->at(timeIdx, tracerIdx, cellIdx);
+    }
+
+    /**
+     *  Update the halos of the tracer. The halos of all tracers are updated
+     *  together, since they are interleaved.
+     */
+    void
+    applyBndCond(const TimeLevelIndex<NumTimeLevel> &timeIdx,
+                 bool updateHalfLevel = false) {
+        _bundle->applyBndCond(timeIdx, updateHalfLevel);
+    }
+}; // StructuredTracerView
+
+/**
+ *  This class stores several tracers on structured mesh in one contiguous
+ *  aligned buffer for each time level with the tracer index changing the
+ *  fastest, i.e. the element (t,i,j,k) is at
+ *
+ *      t+numTracer*(i+nx*(j+ny*k)),
+ *
+ *  where nx and ny include the halos. So the values of all tracers on one
+ *  grid are contiguous, and the regrid or update kernels can compute each
+ *  weight once and apply it on all tracers in a vectorized loop (e.g. see
+ *  RegridPlan::apply). The storage offsets of the grids are the same as the
+ *  ones of StructuredField times the tracer number, so the regrid plans built
+ *  for the fields can be used on the bundles.
+ *
+ *  Each tracer can be accessed element by element through "view" (see
+ *  StructuredTracerView), or copied from and into an ordinary StructuredField
+ *  by "setTracer" and "getTracer" when the whole field is needed.
+ */
+template <class MeshType, int NumTimeLevel = 1>
+class StructuredTracerBundle : public Field<MeshType> {
+public:
+    typedef StructuredStagger::GridType GridType;
+    typedef StructuredStagger::Location Location;
+    typedef AlignedArray<double> StorageType;
+    typedef StructuredTracerView<MeshType, NumTimeLevel> ViewType;
+protected:
+    TimeLevels<StorageType, NumTimeLevel> *data;
+    int _staggerLocation;
+    vector<int> gridTypes;
+    int _numTracer;
+    // grid numbers along each axis (halos included)
+    int nx, ny, nz;
+public:
+    StructuredTracerBundle();
+    virtual ~StructuredTracerBundle();
+
+    virtual void
+    create(const string &name, const string &units, const string &longName,
+           const MeshType &mesh, int loc, int numDim, int numTracer,
+           bool hasHalfLevel = false);
+
+    int
+    numTracer() const {
+        return _numTracer;
+    }
+
+    virtual int
+    staggerLocation() const {
+        return _staggerLocation;
+    }
+
+    int
+    gridType(int axisIdx) const {
+        return gridTypes[axisIdx];
+    }
+
+    /**
+     *  Get the storage of one time level, which has numTracer*nx rows.
+     */
+    const StorageType&
+    operator()(const TimeLevelIndex<NumTimeLevel> &timeIdx) const {
+        return data->level(timeIdx);
+    }
+
+    StorageType&
+    operator()(const TimeLevelIndex<NumTimeLevel> &timeIdx) {
+        return data->level(timeIdx);
+    }
+
+    const double&
+    operator()(const TimeLevelIndex<NumTimeLevel> &timeIdx, int tracerIdx,
+               int i, int j = 0, int k = 0) const {
+        return data->level(timeIdx)(tracerIdx+_numTracer*i, j, k);
+    }
+
+    double&
+    operator()(const TimeLevelIndex<NumTimeLevel> &timeIdx, int tracerIdx,
+               int i, int j = 0, int k = 0) {
+        return data->level(timeIdx)(tracerIdx+_numTracer*i, j, k);
+    }
+
+    /**
+     *  Get the contiguous values of all tracers on one grid.
+     *
+     *  @param timeIdx the time level index.
+     *  @param i, j, k the grid indices (halos included).
+     *
+     *  @return The pointer to the tracer values.
+     */
+    const double*
+    tracers(const TimeLevelIndex<NumTimeLevel> &timeIdx, int i, int j = 0, int k = 0) const {
+        return &data->level(timeIdx)(_numTracer*i, j, k);
+    }
+
+    double*
+    tracers(const TimeLevelIndex<NumTimeLevel> &timeIdx, int i, int j = 0, int k = 0) {
+        return &data->level(timeIdx)(_numTracer*i, j, k);
+    }
+
+    const double&
+    at(const TimeLevelIndex<NumTimeLevel> &timeIdx, int tracerIdx, int cellIdx) const;
+
+    double&
+    at(const TimeLevelIndex<NumTimeLevel> &timeIdx, int tracerIdx, int cellIdx);
+
+    ViewType
+    view(int tracerIdx) {
+        return ViewType(*this, tracerIdx);
+    }
+
+    /**
+     *  Get the read-only view of one tracer.
+     */
+    const ViewType
+    view(int tracerIdx) const {
+        return ViewType(const_cast<StructuredTracerBundle&>(*this), tracerIdx);
+    }
+
+    /**
+     *  Copy one tracer from an ordinary field (halos included).
+     */
+    template <int N>
+    void
+    setTracer(const TimeLevelIndex<NumTimeLevel> &timeIdx, int tracerIdx,
+              const TimeLevelIndex<N> &fieldTimeIdx,
+              const StructuredField<MeshType, double, N> &f);
+
+    /**
+     *  Copy one tracer into an ordinary field (halos included).
+     */
+    template <int N>
+    void
+    getTracer(const TimeLevelIndex<NumTimeLevel> &timeIdx, int tracerIdx,
+              const TimeLevelIndex<N> &fieldTimeIdx,
+              StructuredField<MeshType, double, N> &f) const;
+
+    /**
+     *  Update the periodic halos of all tracers. The half level (if any) is
+     *  marked to be updated on its next access.
+     */
+    void
+    applyBndCond(const TimeLevelIndex<NumTimeLevel> &timeIdx,
+                 bool updateHalfLevel = false);
+
+    /**
+     *  Mark the half level (if any) around the given time level to be updated
+     *  on its next access.
+     */
+    void
+    invalidateHalfLevel(const TimeLevelIndex<NumTimeLevel> &timeIdx);
+protected:
+    void
+    checkField(int loc) const;
+}; // StructuredTracerBundle
+
+} // geomtk
+
+#include "StructuredTracerBundle-impl.h"
+
+#endif // __GEOMTK_StructuredTracerBundle__
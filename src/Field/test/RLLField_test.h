@@ -2,6 +2,9 @@
 #define __GEOMTK_RLLField_test__
 
 #include "RLLField.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace geomtk;
 
@@ -54,6 +57,202 @@ TEST_F(RLLFieldTest, AccessElements) {
     }
 }
 
+TEST_F(RLLFieldTest, Ranges) {
+    int n = mesh->totalNumGrid(CENTER, f.numDim());
+    for (int l = 0; l < n; ++l) {
+        f.at(timeIdx, l) = l;
+    }
+    const double *p = f(timeIdx).memptr();
+    StructuredRange range = f.cells();
+    ASSERT_EQ(n, range.size());
+    ASSERT_EQ(n, range.end()-range.begin());
+    int l = 0;
+    for (const StructuredCell &cell : range) {
+        ASSERT_EQ(&f(timeIdx, cell.i, cell.j), p+cell.offset);
+        ASSERT_EQ(l++, p[cell.offset]);
+    }
+    auto it = range.begin()+37;
+    ASSERT_EQ(37, p[(*it).offset]);
+    ASSERT_EQ(36, p[(*--it).offset]);
+    ASSERT_EQ(40, p[it[4].offset]);
+    // The iterators copy the range, so they outlive the temporary ranges.
+    auto first = f.cells().begin();
+    ASSERT_EQ(0, p[(*first).offset]);
+    ASSERT_EQ(n-1, p[(*(first+(n-1))).offset]);
+    ASSERT_TRUE((is_same<std::iterator_traits<StructuredRange::iterator>::iterator_category,
+                         std::input_iterator_tag>::value));
+    auto last = range.end();
+    ASSERT_EQ(n-1, p[(*--last).offset]);
+    ASSERT_EQ(n-2, p[(*--last).offset]);
+    for (int r = 0; r < range.numRow(); ++r) {
+        for (int i = 0; i < range.rowLength(); ++i) {
+            ASSERT_EQ(r*range.rowLength()+i, p[range.rowOffset(r)+i]);
+        }
+    }
+    // The periodic halos are included.
+    range = f.cells(true);
+    ASSERT_EQ(static_cast<int>(f(timeIdx).n_elem), range.size());
+    l = 0;
+    std::for_each(range.begin(), range.end(), [&](const StructuredCell &cell) {
+        ASSERT_EQ(l++, cell.offset);
+    });
+    // latitude row and vertical column
+    range = f.cells().row(mesh->js(FULL)+2);
+    ASSERT_EQ(10, range.size());
+    ASSERT_EQ(20, p[(*range.begin()).offset]);
+    range = f.cells().column(mesh->is(FULL)+3, mesh->js(FULL)+2);
+    ASSERT_EQ(1, range.size());
+    ASSERT_EQ(23, p[(*range.begin()).offset]);
+}
+
+TEST_F(RLLFieldTest, RangesStaggered) {
+    const int X_FACE = RLLStagger::Location::X_FACE;
+    // 2D field on X_FACE location
+    g.create("g", "1", "g", *mesh, X_FACE, 2);
+    int n = mesh->totalNumGrid(X_FACE, g.numDim());
+    for (int l = 0; l < n; ++l) {
+        g.at(timeIdx, l) = l;
+    }
+    const double *p = g(timeIdx).memptr();
+    StructuredRange range = g.cells();
+    ASSERT_EQ(n, range.size());
+    int l = 0;
+    for (const StructuredCell &cell : range) {
+        ASSERT_EQ(&g(timeIdx, cell.i, cell.j), p+cell.offset);
+        ASSERT_EQ(l, p[range[l].offset]);
+        ASSERT_EQ(l++, p[cell.offset]);
+    }
+    // 3D field and 2D field on 3D mesh
+    SphereDomain domain(CLASSIC_PRESSURE_SIGMA);
+    RLLMesh mesh3(domain);
+    mesh3.init(10, 10, 4);
+    Field h3, h2;
+    h3.create("h3", "1", "h3", mesh3, CENTER, 3);
+    h2.create("h2", "1", "h2", mesh3, CENTER, 2);
+    n = mesh3.totalNumGrid(CENTER, 3);
+    for (l = 0; l < n; ++l) {
+        h3.at(timeIdx, l) = l;
+    }
+    p = h3(timeIdx).memptr();
+    range = h3.cells();
+    ASSERT_EQ(n, range.size());
+    ASSERT_EQ(4, range.count(2));
+    l = 0;
+    for (const StructuredCell &cell : range) {
+        ASSERT_EQ(&h3(timeIdx, cell.i, cell.j, cell.k), p+cell.offset);
+        ASSERT_EQ(l++, p[cell.offset]);
+    }
+    range = h3.cells().level(mesh3.ks(FULL)+2);
+    ASSERT_EQ(100, range.size());
+    ASSERT_EQ(200, p[(*range.begin()).offset]);
+    range = h3.cells().column(mesh3.is(FULL)+3, mesh3.js(FULL)+2);
+    ASSERT_EQ(4, range.size());
+    l = 0;
+    for (const StructuredCell &cell : range) {
+        ASSERT_EQ(23+100*l++, p[cell.offset]);
+    }
+    n = mesh3.totalNumGrid(CENTER, 2);
+    for (l = 0; l < n; ++l) {
+        h2.at(timeIdx, l) = l;
+    }
+    p = h2(timeIdx).memptr();
+    range = h2.cells();
+    ASSERT_EQ(n, range.size());
+    ASSERT_EQ(1, range.count(2));
+    l = 0;
+    for (const StructuredCell &cell : range) {
+        ASSERT_EQ(0, cell.k);
+        ASSERT_EQ(&h2(timeIdx, cell.i, cell.j), p+cell.offset);
+        ASSERT_EQ(l++, p[cell.offset]);
+    }
+}
+
+TEST_F(RLLFieldTest, IndexMap) {
+    int n = mesh->totalNumGrid(CENTER, f.numDim());
+    for (int l = 0; l < n; ++l) {
+        f.at(timeIdx, l) = l;
+    }
+    // The fixed-dimension map and the runtime one get the same elements.
+    StructuredIndexMap<2> map(f.indexMap());
+    ASSERT_EQ(n, map.numCell());
+    for (int l = 0; l < n; ++l) {
+        ASSERT_EQ(&f.at(timeIdx, l), &f.at(timeIdx, map, l));
+        ASSERT_EQ(&f.at(timeIdx, l), &f.at(timeIdx, f.indexMap(), l));
+        ASSERT_EQ(l, f.at(timeIdx, map, l));
+    }
+    const Field &cf = f;
+    ASSERT_EQ(n-1, cf.at(timeIdx, map, n-1));
+}
+
+TEST_F(RLLFieldTest, Statistics) {
+    uword n = mesh->totalNumGrid(CENTER, f.numDim());
+    for (uword i = 0; i < n; ++i) {
+        f.at(timeIdx, i) = 1.0;
+    }
+    f.at(timeIdx, 3) = -2.0;
+    f.at(timeIdx, 7) = 5.0;
+    f.at(timeIdx, 8) = 5.0;
+    f.at(timeIdx, 11) = NAN;
+    f.at(timeIdx, 12) = INFINITY;
+    SummationMode modes[2] = { PLAIN_SUMMATION, COMPENSATED_SUMMATION };
+    for (int m = 0; m < 2; ++m) {
+        FieldStatistics s = f.statistics(timeIdx, modes[m]);
+        ASSERT_EQ(n-2, s.numFinite);
+        ASSERT_EQ(1, s.numNan);
+        ASSERT_EQ(1, s.numInf);
+        ASSERT_EQ(n-5+(-2.0)+5.0+5.0, s.sum);
+        ASSERT_EQ(s.sum/(n-2), s.mean);
+        ASSERT_EQ(-2.0, s.min);
+        ASSERT_EQ(3, s.minIndex);
+        ASSERT_EQ(5.0, s.max);
+        ASSERT_EQ(7, s.maxIndex);
+    }
+    // The integral of constant is the sphere area.
+    for (uword i = 0; i < n; ++i) {
+        f.at(timeIdx, i) = 1.0;
+    }
+    FieldStatistics s = f.statistics(timeIdx, COMPENSATED_SUMMATION);
+    ASSERT_NEAR(4*M_PI, s.integral, 1.0e-12);
+}
+
+TEST_F(RLLFieldTest, StatisticsThreadCount) {
+    RLLMesh mesh(*sphere);
+    mesh.init(90, 45);
+    Field h;
+    h.create("h", "1", "h", mesh, CENTER, 2);
+    uword n = mesh.totalNumGrid(CENTER, h.numDim());
+    for (uword i = 0; i < n; ++i) {
+        h.at(timeIdx, i) = sin(i*0.37)*1.0e8+cos(i*i*0.01);
+    }
+    SummationMode modes[2] = { PLAIN_SUMMATION, COMPENSATED_SUMMATION };
+#ifdef _OPENMP
+    int numThread = omp_get_max_threads();
+    omp_set_num_threads(1);
+#endif
+    FieldStatistics s[2];
+    for (int m = 0; m < 2; ++m) {
+        s[m] = h.statistics(timeIdx, modes[m]);
+    }
+    // The rows are merged in a fixed order, so the sums are bitwise the same
+    // for any thread number.
+    for (int t = 2; t <= 5; ++t) {
+#ifdef _OPENMP
+        omp_set_num_threads(t);
+#endif
+        for (int m = 0; m < 2; ++m) {
+            FieldStatistics r = h.statistics(timeIdx, modes[m]);
+            ASSERT_EQ(s[m].sum, r.sum);
+            ASSERT_EQ(s[m].integral, r.integral);
+            ASSERT_EQ(s[m].mean, r.mean);
+            ASSERT_EQ(s[m].minIndex, r.minIndex);
+            ASSERT_EQ(s[m].maxIndex, r.maxIndex);
+        }
+    }
+#ifdef _OPENMP
+    omp_set_num_threads(numThread);
+#endif
+}
+
 TEST_F(RLLFieldTest, AssignmentOperator) {
     for (uword i = 0; i < mesh->totalNumGrid(CENTER, f.numDim()); ++i) {
         f.at(timeIdx, i) = i;
@@ -0,0 +1,168 @@
+#ifndef __GEOMTK_StructuredHaloUpdate_test__
+#define __GEOMTK_StructuredHaloUpdate_test__
+
+#include "StructuredHaloUpdate.h"
+#include "CartesianField.h"
+#include "RLLField.h"
+
+using namespace geomtk;
+
+class StructuredHaloUpdateTest : public ::testing::Test {
+protected:
+    typedef CartesianField<double, 2> Field;
+    typedef StructuredTracerBundle<CartesianMesh, 2> Bundle;
+
+    const int CENTER = StructuredStagger::Location::CENTER;
+    const int X_FACE = StructuredStagger::Location::X_FACE;
+    const int Y_FACE = StructuredStagger::Location::Y_FACE;
+    const int Z_FACE = StructuredStagger::Location::Z_FACE;
+    const int numTracer = 3;
+
+    CartesianDomain *domain;
+    CartesianMesh *mesh;
+    TimeLevelIndex<2> timeIdx;
+
+    virtual void SetUp() {
+        domain = new CartesianDomain(3);
+        domain->setAxis(0, "x", "x axis", "m", 0, PERIODIC, 1, PERIODIC);
+        domain->setAxis(1, "y", "y axis", "m", 0, PERIODIC, 1, PERIODIC);
+        domain->setAxis(2, "z", "z axis", "m", 0, PERIODIC, 1, PERIODIC);
+        mesh = new CartesianMesh(*domain);
+        mesh->init(6, 5, 4);
+    }
+
+    virtual void TearDown() {
+        delete mesh;
+        delete domain;
+    }
+
+    template <class T>
+    void
+    fill(AlignedArray<double> &d, T value) {
+        for (uword l = 0; l < d.n_elem; ++l) {
+            d.memptr()[l] = value(l);
+        }
+    }
+};
+
+TEST_F(StructuredHaloUpdateTest, Run) {
+    int locs[3] = {CENTER, X_FACE, Z_FACE};
+    vector<Field> fields(3), answers(3);
+    Bundle q, answer;
+    StructuredHaloUpdate<CartesianMesh> haloUpdate;
+    haloUpdate.init(*mesh);
+    for (int l = 0; l < 3; ++l) {
+        fields[l].create("f", "1", "f", *mesh, locs[l], 3);
+        answers[l].create("f", "1", "f", *mesh, locs[l], 3);
+        fill(fields[l](timeIdx), [l](uword i) { return (l+1)*1000.0+i; });
+        answers[l] = fields[l];
+        answers[l].applyBndCond(timeIdx);
+        haloUpdate.addField(timeIdx, fields[l]);
+    }
+    q.create("q", "1", "q", *mesh, CENTER, 3, numTracer);
+    answer.create("q", "1", "q", *mesh, CENTER, 3, numTracer);
+    fill(q(timeIdx), [](uword i) { return -1.0*i; });
+    fill(answer(timeIdx), [](uword i) { return -1.0*i; });
+    answer.applyBndCond(timeIdx);
+    haloUpdate.addField(timeIdx, q);
+    ASSERT_EQ(4u, haloUpdate.numField());
+    haloUpdate.run();
+    for (int l = 0; l < 3; ++l) {
+        const AlignedArray<double> &a = fields[l](timeIdx);
+        const AlignedArray<double> &b = answers[l](timeIdx);
+        for (uword i = 0; i < a.n_elem; ++i) {
+            ASSERT_EQ(b.memptr()[i], a.memptr()[i]);
+        }
+    }
+    for (uword i = 0; i < q(timeIdx).n_elem; ++i) {
+        ASSERT_EQ(answer(timeIdx).memptr()[i], q(timeIdx).memptr()[i]);
+    }
+}
+
+TEST_F(StructuredHaloUpdateTest, RLLMesh) {
+    // x axis is periodic and y axis ends at the Poles
+    SphereDomain sphere(2);
+    RLLMesh rllMesh(sphere);
+    rllMesh.init(10, 9);
+    int locs[2] = {CENTER, Y_FACE};
+    vector<RLLField<double, 2> > fields(2), answers(2);
+    StructuredHaloUpdate<RLLMesh> haloUpdate;
+    haloUpdate.init(rllMesh);
+    for (int l = 0; l < 2; ++l) {
+        fields[l].create("f", "1", "f", rllMesh, locs[l], 2);
+        answers[l].create("f", "1", "f", rllMesh, locs[l], 2);
+        fill(fields[l](timeIdx), [l](uword i) { return (l+1)*1000.0+i; });
+        answers[l] = fields[l];
+        answers[l].applyBndCond(timeIdx);
+        haloUpdate.addField(timeIdx, fields[l]);
+    }
+    // only the slabs along x axis are planned
+    ASSERT_EQ(0u, haloUpdate.tasks[1].size());
+    haloUpdate.run();
+    for (int l = 0; l < 2; ++l) {
+        const AlignedArray<double> &a = fields[l](timeIdx);
+        const AlignedArray<double> &b = answers[l](timeIdx);
+        for (uword i = 0; i < a.n_elem; ++i) {
+            ASSERT_EQ(b.memptr()[i], a.memptr()[i]);
+        }
+    }
+}
+
+TEST_F(StructuredHaloUpdateTest, FieldOf2DOn3DMesh) {
+    int locs[2] = {CENTER, X_FACE};
+    vector<Field> fields(2), answers(2);
+    StructuredHaloUpdate<CartesianMesh> haloUpdate;
+    haloUpdate.init(*mesh);
+    for (int l = 0; l < 2; ++l) {
+        fields[l].create("f", "1", "f", *mesh, locs[l], 2);
+        answers[l].create("f", "1", "f", *mesh, locs[l], 2);
+        fill(fields[l](timeIdx), [l](uword i) { return (l+1)*1000.0+i; });
+        answers[l] = fields[l];
+        answers[l].applyBndCond(timeIdx);
+        haloUpdate.addField(timeIdx, fields[l]);
+    }
+    // The slabs along z axis are skipped, since the fields have one level.
+    ASSERT_EQ(0u, haloUpdate.tasks[2].size());
+    ASSERT_LT(0u, haloUpdate.tasks[1].size());
+    haloUpdate.run();
+    for (int l = 0; l < 2; ++l) {
+        const AlignedArray<double> &a = fields[l](timeIdx);
+        const AlignedArray<double> &b = answers[l](timeIdx);
+        ASSERT_EQ(1u, a.n_slices);
+        for (uword i = 0; i < a.n_elem; ++i) {
+            ASSERT_EQ(b.memptr()[i], a.memptr()[i]);
+        }
+    }
+}
+
+TEST_F(StructuredHaloUpdateTest, UpdateHalfLevel) {
+    TimeLevelIndex<2> oldIdx = timeIdx, newIdx = timeIdx+1, halfIdx = timeIdx+0.5;
+    Field f, answer;
+    Bundle q;
+    f.create("f", "1", "f", *mesh, CENTER, 3, HAS_HALF_LEVEL);
+    answer.create("f", "1", "f", *mesh, CENTER, 3);
+    q.create("q", "1", "q", *mesh, CENTER, 3, numTracer, HAS_HALF_LEVEL);
+    fill(f(oldIdx), [](uword i) { return 1.0*i; });
+    f.applyBndCond(oldIdx);
+    fill(f(newIdx), [](uword i) { return 3.0*i; });
+    fill(answer(newIdx), [](uword i) { return 3.0*i; });
+    answer.applyBndCond(newIdx);
+    fill(q(newIdx), [](uword i) { return -1.0*i; });
+    ASSERT_FALSE(f.data->isHalfLevelStale(halfIdx));
+    ASSERT_FALSE(q.data->isHalfLevelStale(halfIdx));
+    StructuredHaloUpdate<CartesianMesh> haloUpdate;
+    haloUpdate.init(*mesh);
+    haloUpdate.addField(newIdx, f, true);
+    haloUpdate.addField(newIdx, q, true);
+    haloUpdate.run();
+    ASSERT_TRUE(f.data->isHalfLevelStale(halfIdx));
+    ASSERT_TRUE(q.data->isHalfLevelStale(halfIdx));
+    // The half level is computed from the filled full levels on access.
+    const AlignedArray<double> &a = f(oldIdx), &b = answer(newIdx), &c = f(halfIdx);
+    ASSERT_FALSE(f.data->isHalfLevelStale(halfIdx));
+    for (uword i = 0; i < c.n_elem; ++i) {
+        ASSERT_EQ((a.memptr()[i]+b.memptr()[i])*0.5, c.memptr()[i]);
+    }
+}
+
+#endif // __GEOMTK_StructuredHaloUpdate_test__
@@ -0,0 +1,124 @@
+#ifndef __GEOMTK_StructuredTracerBundle_test__
+#define __GEOMTK_StructuredTracerBundle_test__
+
+#include "StructuredTracerBundle.h"
+#include "RLLField.h"
+#include "RLLRegrid.h"
+
+using namespace geomtk;
+
+class StructuredTracerBundleTest : public ::testing::Test {
+protected:
+    typedef StructuredTracerBundle<RLLMesh, 2> Bundle;
+
+    const int FULL = RLLStagger::GridType::FULL;
+    const int CENTER = RLLStagger::Location::CENTER;
+    const int numTracer = 3;
+
+    SphereDomain *domain;
+    RLLMesh *mesh;
+    TimeLevelIndex<2> timeIdx;
+    vector<RLLField<double, 2> > fields;
+    Bundle q;
+
+    virtual void SetUp() {
+        domain = new SphereDomain(2);
+        mesh = new RLLMesh(*domain);
+        mesh->init(10, 10);
+        fields.resize(numTracer);
+        q.create("q", "1", "tracers", *mesh, CENTER, 2, numTracer);
+        for (int t = 0; t < numTracer; ++t) {
+            fields[t].create("f", "1", "f", *mesh, CENTER, 2);
+            for (uword j = mesh->js(FULL); j <= mesh->je(FULL); ++j) {
+                for (uword i = mesh->is(FULL); i <= mesh->ie(FULL); ++i) {
+                    fields[t](timeIdx, i, j) = (t+1)*cos(mesh->gridCoordComp(0, FULL, i))*
+                                               cos(mesh->gridCoordComp(1, FULL, j));
+                }
+            }
+            fields[t].applyBndCond(timeIdx);
+        }
+    }
+
+    virtual void TearDown() {
+        delete mesh;
+        delete domain;
+    }
+};
+
+TEST_F(StructuredTracerBundleTest, Access) {
+    ASSERT_EQ(numTracer, q.numTracer());
+    ASSERT_EQ(numTracer*12, q(timeIdx).n_rows);
+    for (int t = 0; t < numTracer; ++t) {
+        for (uword i = 0; i < mesh->totalNumGrid(CENTER, 2); ++i) {
+            q.at(timeIdx, t, i) = fields[t].at(timeIdx, i);
+        }
+    }
+    q.applyBndCond(timeIdx);
+    for (int t = 0; t < numTracer; ++t) {
+        Bundle::ViewType v = q.view(t);
+        for (uword j = 0; j < fields[t](timeIdx).n_cols; ++j) {
+            for (uword i = 0; i < fields[t](timeIdx).n_rows; ++i) {
+                ASSERT_EQ(fields[t](timeIdx, i, j), v(timeIdx, i, j));
+                ASSERT_EQ(fields[t](timeIdx, i, j), q.tracers(timeIdx, i, j)[t]);
+            }
+        }
+    }
+    RLLField<double, 2> g;
+    g.create("g", "1", "g", *mesh, CENTER, 2);
+    q.getTracer(timeIdx, 1, timeIdx, g);
+    for (uword l = 0; l < g(timeIdx).n_elem; ++l) {
+        ASSERT_EQ(fields[1](timeIdx)(l), g(timeIdx)(l));
+    }
+}
+
+TEST_F(StructuredTracerBundleTest, View) {
+    // Write the interior grids through the views and update the halos.
+    for (int t = 0; t < numTracer; ++t) {
+        Bundle::ViewType v = q.view(t);
+        ASSERT_EQ(&q, &v.bundle());
+        ASSERT_EQ(mesh, &v.mesh());
+        ASSERT_EQ(CENTER, v.staggerLocation());
+        for (uword j = mesh->js(FULL); j <= mesh->je(FULL); ++j) {
+            for (uword i = mesh->is(FULL); i <= mesh->ie(FULL); ++i) {
+                v(timeIdx, i, j) = fields[t](timeIdx, i, j);
+            }
+        }
+        v.applyBndCond(timeIdx);
+    }
+    const Bundle &cq = q;
+    for (int t = 0; t < numTracer; ++t) {
+        const Bundle::ViewType v = cq.view(t);
+        ASSERT_EQ(t, v.tracerIndex());
+        for (uword j = 0; j < fields[t](timeIdx).n_cols; ++j) {
+            for (uword i = 0; i < fields[t](timeIdx).n_rows; ++i) {
+                ASSERT_EQ(fields[t](timeIdx, i, j), v(timeIdx, i, j));
+            }
+        }
+    }
+}
+
+TEST_F(StructuredTracerBundleTest, RegridPlan) {
+    for (int t = 0; t < numTracer; ++t) {
+        q.setTracer(timeIdx, t, timeIdx, fields[t]);
+    }
+    RLLRegrid regrid(*mesh);
+    vector<SphereCoord> xs(3, SphereCoord(2));
+    xs[0].set(1.9*M_PI, 0.2*M_PI);
+    xs[1].set(0.3*M_PI, -0.1*M_PI);
+    xs[2].set(0.1*M_PI, 0.45*M_PI);
+    RegridPlan plan;
+    regrid.initPlan(LINEAR, CENTER, xs, plan);
+    mat y;
+    plan.applyTracers(timeIdx, q, y);
+    ASSERT_EQ(numTracer, y.n_rows);
+    ASSERT_EQ(3, y.n_cols);
+    for (int t = 0; t < numTracer; ++t) {
+        vec z;
+        plan.apply(timeIdx, fields[t], z);
+        for (int p = 0; p < 3; ++p) {
+            ASSERT_NEAR(z[p], y(t, p), 1.0e-14);
+        }
+    }
+}
+
+#endif // __GEOMTK_StructuredTracerBundle_test__
@@ -6,7 +6,7 @@
 namespace geomtk {
 
 enum FilterScheme {
-    NINE_POINT_SMOOTHING
+    NINE_POINT_SMOOTHING, POLAR_FOURIER_FILTER
 };
 
 template <class MeshType>
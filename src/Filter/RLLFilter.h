@@ -2,16 +2,131 @@
 #define __GEOMTK_RLLFilter__
 
 #include "StructuredFilter.h"
+#include "RealFFT.h"
 
 namespace geomtk {
 
+/**
+ *  This class adds the polar Fourier filter for RLL mesh. Poleward of the
+ *  critical latitude, the zonal wavenumber k of each latitude row is damped
+ *  by
+ *
+ *      S(k) = min(1, cos(lat)/(cos(latc)*sin(k*dlon/2))),
+ *
+ *  so the effective zonal resolution is not finer than that on the critical
+ *  latitude, which relaxes the CFL condition near the Poles. The rows and
+ *  levels are filtered in parallel, and the responses are computed once for
+ *  each grid type combination.
+ */
 template <class MeshType>
 class RLLFilter : public StructuredFilter<MeshType> {
 protected:
+    typedef RealFFT::Complex Complex;
+
+    double _criticalLatitude;
+    // indexed by the grid types along x and y axes
+    bool isResponseSet[2][2];
+    RealFFT ffts[2][2];
+    vector<int> filterRows[2][2];
+    vector<vec> responses[2][2];
 public:
-    RLLFilter(const MeshType &mesh, FilterScheme scheme) : StructuredFilter<MeshType>(mesh, scheme) {}
+    RLLFilter(const MeshType &mesh, FilterScheme scheme,
+              double criticalLatitude = 60.0*RAD)
+        : StructuredFilter<MeshType>(mesh, scheme) {
+        setCriticalLatitude(criticalLatitude);
+    }
     virtual ~RLLFilter() {}
-};
+
+    double
+    criticalLatitude() const {
+        return _criticalLatitude;
+    }
+
+    void
+    setCriticalLatitude(double lat) {
+        _criticalLatitude = fabs(lat);
+        for (int i = 0; i < 2; ++i) {
+            for (int j = 0; j < 2; ++j) {
+                isResponseSet[i][j] = false;
+            }
+        }
+    }
+
+    template <class FieldType, int N>
+    void run(const TimeLevelIndex<N> &timeIdx, FieldType &field, int numPass = 1);
+protected:
+    template <class FieldType, int N>
+    void runPolarFourierFilter(const TimeLevelIndex<N> &timeIdx, FieldType &field);
+
+    void
+    setResponses(int gtx, int gty);
+}; // RLLFilter
+
+template <class MeshType>
+template <class FieldType, int N>
+void RLLFilter<MeshType>::
+run(const TimeLevelIndex<N> &timeIdx, FieldType &field, int numPass) {
+    if (this->scheme == POLAR_FOURIER_FILTER) {
+        runPolarFourierFilter(timeIdx, field);
+    } else {
+        StructuredFilter<MeshType>::run(timeIdx, field, numPass);
+    }
+} // run
+
+template <class MeshType>
+template <class FieldType, int N>
+void RLLFilter<MeshType>::
+runPolarFourierFilter(const TimeLevelIndex<N> &timeIdx, FieldType &field) {
+    int gtx = field.gridType(0), gty = field.gridType(1);
+    if (!isResponseSet[gtx][gty]) setResponses(gtx, gty);
+    const RealFFT &fft = ffts[gtx][gty];
+    const vector<int> &rows = filterRows[gtx][gty];
+    const vector<vec> &S = responses[gtx][gty];
+    const int is = this->mesh->is(gtx);
+    const int nk = fft.size()/2+1;
+    auto &d = field(timeIdx);
+    const int numRow = rows.size();
+    const int numTask = numRow*d.n_slices;
+    #pragma omp parallel
+    {
+        vector<Complex> work(fft.workSize()), X(nk);
+        #pragma omp for schedule(dynamic)
+        for (int t = 0; t < numTask; ++t) {
+            int l = t%numRow, k = t/numRow;
+            double *x = &d(is, rows[l], k);
+            fft.forward(x, X.data(), work.data());
+            for (int m = 1; m < nk; ++m) {
+                X[m] *= S[l][m];
+            }
+            fft.backward(X.data(), x, work.data());
+        }
+    }
+    field.applyBndCond(timeIdx);
+} // runPolarFourierFilter
+
+template <class MeshType>
+void RLLFilter<MeshType>::
+setResponses(int gtx, int gty) {
+    const int nx = this->mesh->numGrid(0, gtx);
+    const double dlon = PI2/nx;
+    const double cosLatc = cos(_criticalLatitude);
+    ffts[gtx][gty].init(nx);
+    filterRows[gtx][gty].clear();
+    responses[gtx][gty].clear();
+    for (int j = this->mesh->js(gty); j <= this->mesh->je(gty); ++j) {
+        double cosLat = this->mesh->cosLat(gty, j);
+        // NOTE: The Pole grids are single points, so they are skipped.
+        if (cosLat >= cosLatc || cosLat < 1.0e-12) continue;
+        vec S(nx/2+1);
+        S[0] = 1.0;
+        for (int k = 1; k <= nx/2; ++k) {
+            S[k] = min(1.0, cosLat/(cosLatc*sin(k*dlon*0.5)));
+        }
+        filterRows[gtx][gty].push_back(j);
+        responses[gtx][gty].push_back(S);
+    }
+    isResponseSet[gtx][gty] = true;
+} // setResponses
 
 } // geomtk
 
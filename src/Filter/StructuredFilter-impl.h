@@ -3,45 +3,116 @@ namespace geomtk {
 template <class MeshType>
 template <class FieldType, int N>
 void StructuredFilter<MeshType>::
-run(const TimeLevelIndex<N> &timeIdx, FieldType &field) {
+run(const TimeLevelIndex<N> &timeIdx, FieldType &field, int numPass) {
     switch (this->scheme) {
     case NINE_POINT_SMOOTHING:
-        runNinePointSmoothing(timeIdx, field);
+        runNinePointSmoothing(timeIdx, field, numPass);
         break;
+    default:
+        REPORT_ERROR("Unsupported filter scheme!");
     }
 }
 
 template <class MeshType>
 template <class FieldType, int N>
 void StructuredFilter<MeshType>::
-runNinePointSmoothing(const TimeLevelIndex<N> &timeIdx, FieldType &field) {
+runNinePointSmoothing(const TimeLevelIndex<N> &timeIdx, FieldType &field,
+                      int numPass) {
+    static_assert(is_same<typename FieldType::StorageType, AlignedArray<double> >::value,
+                  "Nine-point smoothing only supports double fields!");
     assert(field.staggerLocation() == Location::CENTER);
     assert(this->mesh->domain().axisStartBndType(0) == PERIODIC);
-    assert(this->mesh->domain().numDim() == 2);
-    const double p = 0.5;
-    const double q = 0.25;
-    double tmp[this->mesh->totalNumGrid(field.staggerLocation())];
-    int l = 0;
-    for (int j = this->mesh->js(GridType::FULL)+1; j < this->mesh->je(GridType::FULL); ++j) {
-        for (int i = this->mesh->is(GridType::FULL); i <= this->mesh->ie(GridType::FULL); ++i) {
-            double f0 = field(timeIdx, i,   j  );
-            double f1 = field(timeIdx, i-1, j-1);
-            double f2 = field(timeIdx, i-1, j  );
-            double f3 = field(timeIdx, i-1, j+1);
-            double f4 = field(timeIdx, i,   j+1);
-            double f5 = field(timeIdx, i+1, j+1);
-            double f6 = field(timeIdx, i+1, j  );
-            double f7 = field(timeIdx, i+1, j-1);
-            double f8 = field(timeIdx, i,   j-1);
-            tmp[l++] = f0+p*0.25*(f2+f4+f6+f8-4*f0)+q*0.25*(f1+f3+f5+f7-4*f0);
+    if (numPass < 1) return;
+    const int P = numPass;
+    const int is = this->mesh->is(GridType::FULL);
+    const int js = this->mesh->js(GridType::FULL);
+    const int je = this->mesh->je(GridType::FULL);
+    const int nx = this->mesh->numGrid(0, GridType::FULL);
+    auto &d = field(timeIdx);
+    const int nz = d.n_slices;
+    // NOTE: The first and last rows are not changed.
+    const int numRowPerBand = 32;
+    const int numBand = (je-js-1+numRowPerBand-1)/numRowPerBand;
+    if (numBand <= 0) return;
+    const int L = nx+2; // line buffer length with one halo on each side
+    vector<vector<double> > ghosts(nz*numBand);
+    // Copy the rows around each band before any band is changed.
+    #pragma omp parallel for collapse(2)
+    for (int k = 0; k < nz; ++k) {
+        for (int b = 0; b < numBand; ++b) {
+            int j0 = js+1+b*numRowPerBand;
+            int j1 = min(j0+numRowPerBand-1, je-1);
+            int a = max(js, j0-P), z = min(je, j1+P);
+            vector<double> &ghost = ghosts[k*numBand+b];
+            ghost.resize((j0-a+z-j1)*nx);
+            double *g = ghost.data();
+            for (int j = a; j <= z; ++j) {
+                if (j >= j0 && j <= j1) continue;
+                memcpy(g, &d(is, j, k), nx*sizeof(double));
+                g += nx;
+            }
         }
     }
-    l = 0;
-    for (int j = this->mesh->js(GridType::FULL)+1; j < this->mesh->je(GridType::FULL); ++j) {
-        for (int i = this->mesh->is(GridType::FULL); i <= this->mesh->ie(GridType::FULL); ++i) {
-            field(timeIdx, i, j) = tmp[l++];
+    #pragma omp parallel for collapse(2)
+    for (int k = 0; k < nz; ++k) {
+        for (int b = 0; b < numBand; ++b) {
+            int j0 = js+1+b*numRowPerBand;
+            int j1 = min(j0+numRowPerBand-1, je-1);
+            int a = max(js, j0-P), z = min(je, j1+P);
+            const double *ghost = ghosts[k*numBand+b].data();
+            // lines[s][j%3] is the row j after s passes (s = 0 is the input).
+            vector<double> lines((P+1)*3*L);
+            auto line = [&](int s, int j) { return &lines[(s*3+j%3)*L+1]; };
+            for (int r = a; r <= z+P; ++r) {
+                if (r <= z) {
+                    const double *src;
+                    if (r < j0) {
+                        src = ghost+(r-a)*nx;
+                    } else if (r > j1) {
+                        src = ghost+(j0-a+r-j1-1)*nx;
+                    } else {
+                        src = &d(is, r, k);
+                    }
+                    double *dst = line(0, r);
+                    memcpy(dst, src, nx*sizeof(double));
+                    dst[-1] = dst[nx-1];
+                    dst[nx] = dst[0];
+                }
+                for (int s = 1; s <= P; ++s) {
+                    int j = r-s;
+                    // The rows near the band edges are valid for fewer passes.
+                    if (j < (a == js ? js : a+s) || j > (z == je ? je : z-s)) continue;
+                    double *res = line(s, j);
+                    if (j == js || j == je) {
+                        memcpy(res-1, line(s-1, j)-1, L*sizeof(double));
+                    } else {
+                        smoothLine(line(s-1, j-1), line(s-1, j), line(s-1, j+1), res, nx);
+                        res[-1] = res[nx-1];
+                        res[nx] = res[0];
+                    }
+                }
+                int j = r-P;
+                if (j >= j0 && j <= j1) {
+                    memcpy(&d(is, j, k), line(P, j), nx*sizeof(double));
+                }
+            }
         }
     }
+    field.applyBndCond(timeIdx);
+}
+
+template <class MeshType>
+void StructuredFilter<MeshType>::
+smoothLine(const double *__restrict s, const double *__restrict c,
+           const double *__restrict n, double *__restrict res, int nx) {
+    const double p = 0.5;
+    const double q = 0.25;
+    #pragma omp simd
+    for (int i = 0; i < nx; ++i) {
+        double f0 = c[i];
+        res[i] = f0+p*0.25*(c[i-1]+n[i]+c[i+1]+s[i]-4*f0)+
+                    q*0.25*(s[i-1]+n[i-1]+n[i+1]+s[i+1]-4*f0);
+    }
 }
 
 } // geomtk
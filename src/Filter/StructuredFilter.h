@@ -14,11 +14,36 @@ public:
     StructuredFilter(const MeshType &mesh, FilterScheme scheme) : Filter<MeshType>(mesh, scheme) {}
     virtual ~StructuredFilter() {}
 
+    /**
+     *  Filter the field in place.
+     *
+     *  @param timeIdx the time level index.
+     *  @param field   the field.
+     *  @param numPass the number of repeated filter passes, which are fused
+     *                 into one sweep through the field.
+     */
     template <class FieldType, int N>
-    void run(const TimeLevelIndex<N> &timeIdx, FieldType &field);
+    void run(const TimeLevelIndex<N> &timeIdx, FieldType &field, int numPass = 1);
 private:
+    /**
+     *  The rows are split into bands which are smoothed in parallel. Each
+     *  band streams through its rows with three rolling line buffers per pass,
+     *  so several passes are done in one sweep (the later passes lag behind
+     *  by one row each). The rows within numPass of the band edges are copied
+     *  before any band is updated, and they are smoothed redundantly by both
+     *  adjacent bands. The 3D fields are smoothed on each level independently.
+     */
     template <class FieldType, int N>
-    void runNinePointSmoothing(const TimeLevelIndex<N> &timeIdx, FieldType &field);
+    void runNinePointSmoothing(const TimeLevelIndex<N> &timeIdx, FieldType &field,
+                               int numPass);
+
+    /**
+     *  Smooth one row from its south, center and north rows, which have one
+     *  halo on each side and should not overlap with the result.
+     */
+    static void
+    smoothLine(const double *__restrict s, const double *__restrict c,
+               const double *__restrict n, double *__restrict res, int nx);
 }; // StructuredFilter
 
 } // geomtk
@@ -0,0 +1,66 @@
+#ifndef __GEOMTK_RLLFilter_test__
+#define __GEOMTK_RLLFilter_test__
+
+#include "RLLFilter.h"
+#include "RLLField.h"
+
+using namespace geomtk;
+
+class RLLFilterTest : public ::testing::Test {
+protected:
+    typedef RLLField<double, 2> Field;
+
+    const int CENTER = RLLStagger::Location::CENTER;
+    const int FULL = RLLStagger::GridType::FULL;
+
+    TimeLevelIndex<2> timeIdx;
+};
+
+TEST_F(RLLFilterTest, PolarFourierFilter) {
+    SphereDomain domain(2);
+    RLLMesh mesh(domain);
+    mesh.init(64, 33);
+    const double latc = 60.0*RAD;
+    const double cosLatc = cos(latc);
+    RLLFilter<RLLMesh> filter(mesh, POLAR_FOURIER_FILTER, latc);
+    Field f, g;
+    f.create("f", "1", "f", mesh, CENTER, 2);
+    g.create("g", "1", "g", mesh, CENTER, 2);
+    // grid-scale zonal wave on top of a row-dependent mean
+    AlignedArray<double> &d = f(timeIdx);
+    for (uword j = mesh.js(FULL); j <= mesh.je(FULL); ++j) {
+        for (uword i = mesh.is(FULL); i <= mesh.ie(FULL); ++i) {
+            d(i, j) = j+(i%2 == 0 ? 1.0 : -1.0);
+        }
+    }
+    f.applyBndCond(timeIdx);
+    g = f;
+    filter.run(timeIdx, f);
+    const AlignedArray<double> &a = f(timeIdx), &b = g(timeIdx);
+    int numFilteredRow = 0;
+    for (uword j = mesh.js(FULL); j <= mesh.je(FULL); ++j) {
+        double cosLat = mesh.cosLat(FULL, j);
+        if (cosLat >= cosLatc || cosLat < 1.0e-12) {
+            // rows equatorward of the critical latitude (and Poles) are kept
+            for (uword i = mesh.is(FULL); i <= mesh.ie(FULL); ++i) {
+                ASSERT_EQ(b(i, j), a(i, j));
+            }
+            continue;
+        }
+        ++numFilteredRow;
+        double mean = 0.0, amp = 0.0;
+        for (uword i = mesh.is(FULL); i <= mesh.ie(FULL); ++i) {
+            mean += a(i, j);
+            amp += (i%2 == 0 ? 1.0 : -1.0)*(a(i, j)-j);
+        }
+        mean /= mesh.numGrid(0, FULL);
+        amp /= mesh.numGrid(0, FULL);
+        // the zonal mean is preserved and the wave is damped by the response
+        ASSERT_NEAR(j, mean, 1.0e-12);
+        ASSERT_NEAR(cosLat/cosLatc, amp, 1.0e-12);
+        ASSERT_LT(amp, 1.0);
+    }
+    ASSERT_GT(numFilteredRow, 0);
+}
+
+#endif // __GEOMTK_RLLFilter_test__
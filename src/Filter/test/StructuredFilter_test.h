@@ -0,0 +1,111 @@
+#ifndef __GEOMTK_StructuredFilter_test__
+#define __GEOMTK_StructuredFilter_test__
+
+#include "StructuredFilter.h"
+#include "RLLField.h"
+
+using namespace geomtk;
+
+class StructuredFilterTest : public ::testing::Test {
+protected:
+    typedef RLLField<double, 2> Field;
+
+    const int CENTER = RLLStagger::Location::CENTER;
+
+    TimeLevelIndex<2> timeIdx;
+
+    void
+    fill(Field &f) {
+        AlignedArray<double> &d = f(timeIdx);
+        for (uword l = 0; l < d.n_elem; ++l) {
+            d.memptr()[l] = sin(l*0.37)+cos(l*l*0.01);
+        }
+        f.applyBndCond(timeIdx);
+    }
+
+    /**
+     *  Check that the fused passes are the same as the separate ones. There
+     *  are more rows than one band (32 rows), so the band edges are crossed.
+     */
+    void
+    checkFusedPasses(const RLLMesh &mesh, int numDim, int numPass) {
+        StructuredFilter<RLLMesh> filter(mesh, NINE_POINT_SMOOTHING);
+        Field f, g;
+        f.create("f", "1", "f", mesh, CENTER, numDim);
+        g.create("g", "1", "g", mesh, CENTER, numDim);
+        fill(f);
+        g = f;
+        filter.run(timeIdx, f, numPass);
+        for (int p = 0; p < numPass; ++p) {
+            filter.run(timeIdx, g, 1);
+        }
+        const AlignedArray<double> &a = f(timeIdx), &b = g(timeIdx);
+        for (uword l = 0; l < a.n_elem; ++l) {
+            ASSERT_NEAR(b.memptr()[l], a.memptr()[l], 1.0e-14);
+        }
+    }
+};
+
+TEST_F(StructuredFilterTest, NinePointFormula) {
+    const int FULL = RLLStagger::GridType::FULL;
+    SphereDomain domain(2);
+    RLLMesh mesh(domain);
+    mesh.init(20, 40);
+    StructuredFilter<RLLMesh> filter(mesh, NINE_POINT_SMOOTHING);
+    Field f, g;
+    f.create("f", "1", "f", mesh, CENTER, 2);
+    g.create("g", "1", "g", mesh, CENTER, 2);
+    fill(f);
+    g = f;
+    filter.run(timeIdx, f, 1);
+    const AlignedArray<double> &a = f(timeIdx), &b = g(timeIdx);
+    // one interior point and the first point (across the periodic boundary)
+    // of the row next to the South Pole
+    const uword is = mesh.is(FULL), js = mesh.js(FULL);
+    const uword points[2][2] = {{is+7, js+15}, {is, js+1}};
+    for (int l = 0; l < 2; ++l) {
+        uword i = points[l][0], j = points[l][1];
+        double f0 = b(i, j);
+        double res = f0+0.5*0.25*(b(i-1, j)+b(i, j+1)+b(i+1, j)+b(i, j-1)-4*f0)+
+                       0.25*0.25*(b(i-1, j-1)+b(i-1, j+1)+b(i+1, j+1)+b(i+1, j-1)-4*f0);
+        ASSERT_NEAR(res, a(i, j), 1.0e-14);
+    }
+    // the Pole row itself is not changed
+    for (uword i = is; i <= mesh.ie(FULL); ++i) {
+        ASSERT_EQ(b(i, js), a(i, js));
+    }
+}
+
+TEST_F(StructuredFilterTest, FusedPasses2D) {
+    SphereDomain domain(2);
+    RLLMesh mesh(domain);
+    mesh.init(20, 80);
+    checkFusedPasses(mesh, 2, 2);
+    checkFusedPasses(mesh, 2, 3);
+}
+
+TEST_F(StructuredFilterTest, FusedPasses3D) {
+    SphereDomain domain(CLASSIC_PRESSURE_SIGMA);
+    RLLMesh mesh(domain);
+    mesh.init(16, 70, 3);
+    checkFusedPasses(mesh, 3, 2);
+}
+
+TEST_F(StructuredFilterTest, ConstantField) {
+    SphereDomain domain(CLASSIC_PRESSURE_SIGMA);
+    RLLMesh mesh(domain);
+    mesh.init(16, 70, 3);
+    StructuredFilter<RLLMesh> filter(mesh, NINE_POINT_SMOOTHING);
+    Field f;
+    f.create("f", "1", "f", mesh, CENTER, 3);
+    AlignedArray<double> &d = f(timeIdx);
+    for (uword l = 0; l < d.n_elem; ++l) {
+        d.memptr()[l] = 2.5;
+    }
+    filter.run(timeIdx, f, 2);
+    for (uword l = 0; l < d.n_elem; ++l) {
+        ASSERT_NEAR(2.5, d.memptr()[l], 1.0e-14);
+    }
+}
+
+#endif // __GEOMTK_StructuredFilter_test__
@@ -4,7 +4,8 @@
 namespace geomtk {
 
 template <int NumTimeLevel, class DomainType, class MeshType,
-          template<typename, int> class FieldType, class VelocityFieldType>
+          template<typename, int> class FieldType, class VelocityFieldType,
+          template<class, int> class TracerBundleType = StructuredTracerBundle>
 class AdvectionManagerInterface {
 protected:
     const DomainType *domain;
@@ -36,6 +37,21 @@ public:
     virtual FieldType<double, NumTimeLevel>&
     density(int tracerIdx) = 0;
 
+    /**
+     *  Get the densities of all tracers in one bundle, so the kernels (e.g.
+     *  RegridPlan::applyTracers) can work on all tracers in one pass. The
+     *  managers that keep the tracers in separate fields do not provide it.
+     */
+    virtual const TracerBundleType<MeshType, NumTimeLevel>&
+    densities() const {
+        REPORT_ERROR("The tracers are not stored in a bundle!");
+    }
+
+    virtual TracerBundleType<MeshType, NumTimeLevel>&
+    densities() {
+        REPORT_ERROR("The tracers are not stored in a bundle!");
+    }
+
     virtual double&
     tendency(int tracerIdx, int cellIdx) = 0;
 
@@ -10,7 +10,6 @@ class CartesianMeshIndex : public StructuredMeshIndex<CartesianMesh, SpaceCoord>
 public:
     CartesianMeshIndex() : StructuredMeshIndex<CartesianMesh, SpaceCoord>() {}
 	CartesianMeshIndex(int numDim) : StructuredMeshIndex<CartesianMesh, SpaceCoord>(numDim) {}
-	virtual ~CartesianMeshIndex() {}
 };
 
 } // geomtk
@@ -0,0 +1,19 @@
+#ifndef __GEOMTK_CartesianMeshIndexBatch__
+#define __GEOMTK_CartesianMeshIndexBatch__
+
+#include "StructuredMeshIndexBatch.h"
+#include "CartesianMeshIndex.h"
+
+namespace geomtk {
+
+class CartesianMeshIndexBatch : public StructuredMeshIndexBatch<CartesianMesh, SpaceCoord> {
+public:
+    CartesianMeshIndexBatch() : StructuredMeshIndexBatch<CartesianMesh, SpaceCoord>() {}
+    CartesianMeshIndexBatch(uword numDim, uword numPoint)
+    : StructuredMeshIndexBatch<CartesianMesh, SpaceCoord>(numDim, numPoint) {}
+    virtual ~CartesianMeshIndexBatch() {}
+};
+
+} // geomtk
+
+#endif // __GEOMTK_CartesianMeshIndexBatch__
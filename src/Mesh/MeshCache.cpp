@@ -0,0 +1,215 @@
+#include "MeshCache.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace geomtk {
+
+static const char MESH_CACHE_MAGIC[8] = {'G', 'E', 'O', 'M', 'T', 'K', 'M', 'C'};
+static const uword MESH_CACHE_HEADER_SIZE = 4;
+
+MeshCache::
+MeshCache() {
+    _isReading = false;
+    mappedData = NULL;
+    mappedSize = 0;
+    words = NULL;
+    numWord = 0;
+    cursor = 0;
+}
+
+MeshCache::
+~MeshCache() {
+    close();
+}
+
+bool MeshCache::
+open(const string &filePath, uint64_t key) {
+    close();
+    int fd = ::open(filePath.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 ||
+        info.st_size < static_cast<off_t>(MESH_CACHE_HEADER_SIZE*sizeof(uint64_t))) {
+        ::close(fd);
+        return false;
+    }
+    mappedSize = info.st_size;
+    mappedData = mmap(NULL, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mappedData == MAP_FAILED) {
+        mappedData = NULL;
+        return false;
+    }
+    const uint64_t *header = static_cast<const uint64_t*>(mappedData);
+    if (memcmp(&header[0], MESH_CACHE_MAGIC, sizeof(MESH_CACHE_MAGIC)) != 0 ||
+        header[1] != VERSION || header[2] != key ||
+        (MESH_CACHE_HEADER_SIZE+header[3])*sizeof(uint64_t) != mappedSize) {
+        close();
+        return false;
+    }
+    _isReading = true;
+    words = header+MESH_CACHE_HEADER_SIZE;
+    numWord = header[3];
+    cursor = 0;
+    return true;
+} // open
+
+void MeshCache::
+create() {
+    close();
+    _isReading = false;
+    buffer.clear();
+} // create
+
+void MeshCache::
+close() {
+    if (mappedData != NULL) {
+        munmap(mappedData, mappedSize);
+        mappedData = NULL;
+    }
+    mappedSize = 0;
+    words = NULL;
+    numWord = 0;
+    cursor = 0;
+} // close
+
+void MeshCache::
+write(const string &filePath, uint64_t key) const {
+    if (_isReading) {
+        REPORT_ERROR("Mesh cache is opened for reading!");
+    }
+    uint64_t header[MESH_CACHE_HEADER_SIZE];
+    memcpy(&header[0], MESH_CACHE_MAGIC, sizeof(MESH_CACHE_MAGIC));
+    header[1] = VERSION;
+    header[2] = key;
+    header[3] = buffer.size();
+    string tmpFilePath = filePath+".tmp."+std::to_string(getpid());
+    FILE *file = fopen(tmpFilePath.c_str(), "wb");
+    if (file == NULL) {
+        REPORT_WARNING("Failed to write mesh cache \"" << filePath << "\"!");
+        return;
+    }
+    bool isOk = fwrite(header, sizeof(uint64_t), MESH_CACHE_HEADER_SIZE, file) == MESH_CACHE_HEADER_SIZE &&
+                fwrite(buffer.data(), sizeof(uint64_t), buffer.size(), file) == buffer.size();
+    isOk = fclose(file) == 0 && isOk;
+    if (!isOk || rename(tmpFilePath.c_str(), filePath.c_str()) != 0) {
+        remove(tmpFilePath.c_str());
+        REPORT_WARNING("Failed to write mesh cache \"" << filePath << "\"!");
+    }
+} // write
+
+const uint64_t* MeshCache::
+read(uword n) {
+    if (cursor+n > numWord) {
+        REPORT_ERROR("Mesh cache is corrupted!");
+    }
+    const uint64_t *res = words+cursor;
+    cursor += n;
+    return res;
+} // read
+
+void MeshCache::
+sync(uint64_t &x) {
+    if (_isReading) {
+        x = *read(1);
+    } else {
+        buffer.push_back(x);
+    }
+} // sync
+
+void MeshCache::
+sync(int &x) {
+    uint64_t tmp = static_cast<int64_t>(x);
+    sync(tmp);
+    x = static_cast<int64_t>(tmp);
+} // sync
+
+void MeshCache::
+sync(bool &x) {
+    uint64_t tmp = x;
+    sync(tmp);
+    x = tmp != 0;
+} // sync
+
+void MeshCache::
+sync(double &x) {
+    sync(&x, 1);
+} // sync
+
+void MeshCache::
+sync(double *x, uword n) {
+    if (_isReading) {
+        memcpy(x, read(n), n*sizeof(double));
+    } else {
+        uword offset = buffer.size();
+        buffer.resize(offset+n);
+        memcpy(&buffer[offset], x, n*sizeof(double));
+    }
+} // sync
+
+void MeshCache::
+sync(vec &x) {
+    uint64_t n = x.n_elem;
+    sync(n);
+    if (_isReading) x.set_size(n);
+    sync(x.memptr(), n);
+} // sync
+
+void MeshCache::
+sync(arma::Mat<int> &x) {
+    uint64_t n[2] = {x.n_rows, x.n_cols};
+    sync(n[0]);
+    sync(n[1]);
+    if (_isReading) x.set_size(n[0], n[1]);
+    for (uword i = 0; i < x.n_elem; ++i) {
+        sync(x(i));
+    }
+} // sync
+
+void MeshCache::
+sync(field<double> &x) {
+    uint64_t n[3] = {x.n_rows, x.n_cols, x.n_slices};
+    for (int m = 0; m < 3; ++m) {
+        sync(n[m]);
+    }
+    if (_isReading) {
+        x.set_size(n[0], n[1], n[2]);
+        const uint64_t *data = read(x.n_elem);
+        for (uword i = 0; i < x.n_elem; ++i) {
+            memcpy(&x(i), &data[i], sizeof(double));
+        }
+    } else {
+        uword offset = buffer.size();
+        buffer.resize(offset+x.n_elem);
+        for (uword i = 0; i < x.n_elem; ++i) {
+            memcpy(&buffer[offset+i], &x(i), sizeof(double));
+        }
+    }
+} // sync
+
+void MeshCache::
+hash(uint64_t &key, const void *data, size_t size) {
+    const unsigned char *bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        key ^= bytes[i];
+        key *= 1099511628211ULL;
+    }
+} // hash
+
+void MeshCache::
+hashFile(uint64_t &key, const string &filePath) {
+    FILE *file = fopen(filePath.c_str(), "rb");
+    if (file == NULL) {
+        REPORT_ERROR("Failed to open \"" << filePath << "\"!");
+    }
+    vector<unsigned char> chunk(1 << 20);
+    size_t size;
+    while ((size = fread(chunk.data(), 1, chunk.size(), file)) > 0) {
+        hash(key, chunk.data(), size);
+    }
+    fclose(file);
+} // hashFile
+
+} // geomtk
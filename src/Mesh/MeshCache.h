@@ -0,0 +1,118 @@
+#ifndef __GEOMTK_MeshCache__
+#define __GEOMTK_MeshCache__
+
+#include "geomtk_commons.h"
+#include <cstdint>
+
+namespace geomtk {
+
+/**
+ *  This class reads and writes the binary mesh cache, which stores the derived
+ *  mesh tables (grid coordinates, intervals, trigonometric tables, cell
+ *  volumes, etc.), so that the later runs can skip reading the grid files and
+ *  recomputing the tables.
+ *
+ *  The file starts with a header of four 64-bit words (magic, format version,
+ *  key and payload word number), followed by the payload of 64-bit words. The
+ *  key is a hash of the source grid files and the mesh parameters, and a cache
+ *  with different version or key is regarded as stale. The file is mapped into
+ *  memory when reading.
+ *
+ *  The same "sync" calls are used for both reading and writing, so the mesh
+ *  classes only need to list their tables once in the same order.
+ */
+class MeshCache {
+public:
+    static const uint64_t VERSION = 1;
+protected:
+    bool _isReading;
+    // writing mode
+    vector<uint64_t> buffer;
+    // reading mode
+    void *mappedData;
+    size_t mappedSize;
+    const uint64_t *words;
+    uword numWord;
+    uword cursor;
+public:
+    MeshCache();
+    virtual ~MeshCache();
+
+    /**
+     *  Map the cache file for reading.
+     *
+     *  @param filePath the cache file path.
+     *  @param key      the expected key.
+     *
+     *  @return False if the file does not exist, or it is stale or broken.
+     */
+    bool
+    open(const string &filePath, uint64_t key);
+
+    /**
+     *  Start to collect the tables for writing.
+     */
+    void
+    create();
+
+    /**
+     *  Write the collected tables. The file is written into a temporary file
+     *  and then renamed, so the concurrent runs will not see partial files.
+     *
+     *  @param filePath the cache file path.
+     *  @param key      the key.
+     */
+    void
+    write(const string &filePath, uint64_t key) const;
+
+    bool
+    isReading() const {
+        return _isReading;
+    }
+
+    void
+    sync(uint64_t &x);
+
+    void
+    sync(int &x);
+
+    void
+    sync(bool &x);
+
+    void
+    sync(double &x);
+
+    void
+    sync(double *x, uword n);
+
+    void
+    sync(vec &x);
+
+    void
+    sync(arma::Mat<int> &x);
+
+    void
+    sync(field<double> &x);
+
+    /**
+     *  Mix the given bytes into the key by FNV-1a hash.
+     */
+    static void
+    hash(uint64_t &key, const void *data, size_t size);
+
+    /**
+     *  Mix the contents of the given file into the key.
+     */
+    static void
+    hashFile(uint64_t &key, const string &filePath);
+protected:
+    void
+    close();
+
+    const uint64_t*
+    read(uword n);
+}; // MeshCache
+
+} // geomtk
+
+#endif // __GEOMTK_MeshCache__
@@ -3,6 +3,7 @@ namespace geomtk {
 template <class MeshType, class CoordType>
 MeshIndex<MeshType, CoordType>::
 MeshIndex() {
+    numDim = 0;
 }
 
 template <class MeshType, class CoordType>
@@ -11,24 +12,10 @@ MeshIndex(uword numDim) {
 	this->numDim = numDim;
 }
 
-template <class MeshType, class CoordType>
-MeshIndex<MeshType, CoordType>::
-~MeshIndex() {
-}
-
 template <class MeshType, class CoordType>
 void MeshIndex<MeshType, CoordType>::
 init(uword numDim) {
     this->numDim = numDim;
 } // init
 
-template <class MeshType, class CoordType>
-MeshIndex<MeshType, CoordType>& MeshIndex<MeshType, CoordType>::
-operator=(const MeshIndex &other) {
-    if (this != &other) {
-    	numDim = other.numDim;
-    }
-    return *this;
-} // operator=
-
 } // geomtk
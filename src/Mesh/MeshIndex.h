@@ -10,6 +10,18 @@ namespace geomtk {
 
 /**
  *  This class describes the index of grid cell that a point is at.
+ *
+ *  NOTE: Mesh indices are value types that are located and copied in hot
+ *        loops, so there is no virtual function (including destructor) and
+ *        heap memory in them and their subclasses, and they should be kept
+ *        trivially copyable. The subclasses should provide the following
+ *        methods:
+ *
+ *        void locate(const MeshType &mesh, const CoordType &x);
+ *        uword cellIndex(const MeshType &mesh, int loc) const;
+ *        bool isValid() const;
+ *        bool atBoundary(const MeshType &mesh) const;
+ *        void print() const;
  */
 template <class MeshType, class CoordType>
 class MeshIndex {
@@ -18,31 +30,9 @@ protected:
 public:
     MeshIndex();
     MeshIndex(uword numDim);
-    virtual ~MeshIndex();
 
-    virtual void
+    void
     init(uword numDim);
-
-    virtual MeshIndex&
-    operator=(const MeshIndex &other);
-
-    /**
-     *  Locate the given space coordinate in the mesh.
-     */
-    virtual void
-    locate(const MeshType &mesh, const CoordType &x) = 0;
-
-    virtual uword
-    cellIndex(const MeshType &mesh, int loc) const = 0;
-
-    virtual bool
-    isValid() const = 0;
-
-    virtual bool
-    atBoundary(const MeshType &mesh) const = 0;
-
-    virtual void
-    print() const = 0;
 }; // MeshIndex
 
 } // geomtk
@@ -46,6 +46,42 @@ init(uword nx, uword ny, uword nz) {
     StructuredMesh<SphereDomain, SphereCoord>::init(nx, ny, nz);
 } // init
 
+uint64_t RLLMesh::
+cacheKey(const vector<string> &filePaths) const {
+    uint64_t key = StructuredMesh<SphereDomain, SphereCoord>::cacheKey(filePaths);
+    // Cell volumes depend on the sphere radius.
+    double params[2] = {domain().radius(), _poleRadius};
+    MeshCache::hash(key, params, sizeof(params));
+    return key;
+} // cacheKey
+
+void RLLMesh::
+syncCache(MeshCache &cache) {
+    StructuredMesh<SphereDomain, SphereCoord>::syncCache(cache);
+    cache.sync(cosLonFull);
+    cache.sync(sinLonFull);
+    cache.sync(cosLonHalf);
+    cache.sync(sinLonHalf);
+    cache.sync(cosLatFull);
+    cache.sync(sinLatFull);
+    cache.sync(sinLatFull2);
+    cache.sync(cosLatHalf);
+    cache.sync(sinLatHalf);
+    cache.sync(sinLatHalf2);
+    cache.sync(tanLatFull);
+    cache.sync(tanLatHalf);
+} // syncCache
+
+void RLLMesh::
+inputVerticalDomain(const string &filePathV) {
+    IOManager<RLLDataFile> io;
+    int fileIdx = io.addInputFile(*this, filePathV);
+    io.open(fileIdx);
+    io.file(fileIdx).inputVerticalMesh();
+    io.close(fileIdx);
+    io.removeFile(fileIdx);
+} // inputVerticalDomain
+
 void RLLMesh::
 setGridCoordComps(uword axisIdx, uword size, const vec &full, const vec &half) {
     StructuredMesh<SphereDomain, SphereCoord>::
@@ -152,6 +188,7 @@ setCellVolumes() {
     double R2 = domain().radius()*domain().radius();
     for (uword k = 0; k < volumes.n_slices; ++k) {
         if (gridStyle(1) == FULL_LEAD) {
+            #pragma omp parallel for
             for (uword j = 1; j < volumes.n_cols-1; ++j) {
                 double dsinLat = sinLatHalf(j)-sinLatHalf(j-1);
                 for (uword i = 0; i < volumes.n_rows; ++i) {
@@ -165,6 +202,7 @@ setCellVolumes() {
                     (1.0-sinLatHalf(volumes.n_cols-2));
             }
         } else {
+            #pragma omp parallel for
             for (uword j = 0; j < volumes.n_cols; ++j) {
                 double dsinLat = sinLatHalf(j+1)-sinLatHalf(j);
                 for (uword i = 0; i < volumes.n_rows; ++i) {
@@ -230,6 +268,30 @@ sinLon(int gridType, int i) const {
     }
 } // sinLon
 
+const vec& RLLMesh::
+cosLons(int gridType) const {
+    switch (gridType) {
+        case GridType::FULL:
+            return cosLonFull;
+        case GridType::HALF:
+            return cosLonHalf;
+        default:
+            REPORT_ERROR("Unknown grid type!");
+    }
+} // cosLons
+
+const vec& RLLMesh::
+sinLons(int gridType) const {
+    switch (gridType) {
+        case GridType::FULL:
+            return sinLonFull;
+        case GridType::HALF:
+            return sinLonHalf;
+        default:
+            REPORT_ERROR("Unknown grid type!");
+    }
+} // sinLons
+
 double RLLMesh::
 cosLat(int gridType, int j) const {
     switch (gridType) {
@@ -312,25 +374,60 @@ move(const SphereCoord &x0, double dt, const SphereVelocity &v,
     x1.transformToCart(*_domain);
 } // move
 
+template <int NumDim>
 void RLLMesh::
-setGridCoords() {
-    StructuredMesh<SphereDomain, SphereCoord>::setGridCoords();
-    for (int loc = 0; loc < 8; ++loc) {
-        switch (this->domain().numDim()) {
-            case 1:
-                if (loc != Location::CENTER && loc != Location::VERTEX) continue;
-                break;
-            case 2:
-                if (loc != Location::CENTER && loc != Location::VERTEX &&
-                    loc != Location::X_FACE && loc != Location::Y_FACE &&
-                    loc != Location::XY_VERTEX) continue;
-                break;
-            default:
-                break;
+move(const FixedSphereCoord<NumDim> &x0, double dt,
+     const FixedSphereVelocity<NumDim> &v, const RLLMeshIndex &idx,
+     FixedSphereCoord<NumDim> &x1) const {
+    double lon, lat;
+    if (!idx.isOnPole()) {
+        double dlon = dt*v(0)/_domain->radius()/x0.cosLat();
+        double dlat = dt*v(1)/_domain->radius();
+        lon = x0(0)+dlon;
+        lat = x0(1)+dlat;
+        if (lat > M_PI_2) {
+            lon = M_PI+x0(0)-dlon;
+            lat = M_PI-x0(1)-dlat;
         }
-        for (uword cellIdx = 0; cellIdx < gridCoords[loc].size(); ++cellIdx) {
-            gridCoords[loc][cellIdx].transformToCart(*_domain);
+        if (lat < -M_PI_2) {
+            lon =  M_PI+x0(0)-dlon;
+            lat = -M_PI-x0(1)-dlat;
         }
+        if (lon < 0.0) {
+            lon = PI2+fmod(lon, PI2);
+        } else if (lon > PI2) {
+            lon = fmod(lon, PI2);
+        }
+    } else {
+        double xt[2];
+        x0.transformToPS(_domain->radius(), xt);
+        xt[0] += dt*v.psVelocity()[0];
+        xt[1] += dt*v.psVelocity()[1];
+        transformCoordFromPS(_domain->radius(), idx.pole(), xt, lon, lat);
+    }
+    if (NumDim == 3) {
+        x1.set(lon, lat, x0(2)+dt*v(2));
+    } else {
+        x1.set(lon, lat);
+    }
+} // move
+
+template void RLLMesh::
+move<2>(const FixedSphereCoord<2> &x0, double dt,
+        const FixedSphereVelocity<2> &v, const RLLMeshIndex &idx,
+        FixedSphereCoord<2> &x1) const;
+
+template void RLLMesh::
+move<3>(const FixedSphereCoord<3> &x0, double dt,
+        const FixedSphereVelocity<3> &v, const RLLMeshIndex &idx,
+        FixedSphereCoord<3> &x1) const;
+
+void RLLMesh::
+setGridCoords(int loc) const {
+    StructuredMesh<SphereDomain, SphereCoord>::setGridCoords(loc);
+    #pragma omp parallel for
+    for (uword cellIdx = 0; cellIdx < gridCoords[loc].size(); ++cellIdx) {
+        gridCoords[loc][cellIdx].transformToCart(*_domain);
     }
 } // setGridCoords
 
@@ -350,9 +447,9 @@ cellSize(int loc, int cellIdx) const {
     double _cosLat = cosLat(gridTypes(0, 1, loc), spanIdx[1]);
     if (loc == Location::CENTER && gridStyle(1) == FULL_LEAD) {
         if (spanIdx[1] == js(GridType::FULL)) {
-            _cosLat = cos(gridCoord(loc, cellIdx)(1)+gridInterval(1, GridType::FULL, js(GridType::FULL))*0.5);
+            _cosLat = cos(gridCoordComp(1, GridType::FULL, spanIdx[1])+gridInterval(1, GridType::FULL, js(GridType::FULL))*0.5);
         } else if (spanIdx[1] == je(GridType::FULL)) {
-            _cosLat = cos(gridCoord(loc, cellIdx)(1)-gridInterval(1, GridType::FULL, je(GridType::FULL)-1)*0.5);
+            _cosLat = cos(gridCoordComp(1, GridType::FULL, spanIdx[1])-gridInterval(1, GridType::FULL, je(GridType::FULL)-1)*0.5);
         }
     }
     res[0] *= this->domain().radius()*_cosLat;
@@ -12,6 +12,8 @@ class SphereDomain;
 class SphereCoord;
 class SphereVelocity;
 class RLLMeshIndex;
+template <int NumDim> class FixedSphereCoord;
+template <int NumDim> class FixedSphereVelocity;
 
 class RLLMesh : public StructuredMesh<SphereDomain, SphereCoord> {
 public:
@@ -39,6 +41,9 @@ public:
     virtual void
     init(uword nx, uword ny, uword nz = 1);
 
+    virtual uint64_t
+    cacheKey(const vector<string> &filePaths) const;
+
     double&
     poleRadius() {
         return _poleRadius;
@@ -86,6 +91,16 @@ public:
     double
     sinLon(int gridType, int i) const;
 
+    /**
+     *  Get the cosines (sines) of the longitudes including the halo grids, so
+     *  that they can be used by the batched calculations as arrays.
+     */
+    const vec&
+    cosLons(int gridType) const;
+
+    const vec&
+    sinLons(int gridType) const;
+
     double
     cosLat(int gridType, int j) const;
 
@@ -101,9 +116,25 @@ public:
     void
     move(const SphereCoord &x0, double dt, const SphereVelocity &v,
          const RLLMeshIndex &idx, SphereCoord &x1) const;
+
+    /**
+     *  Move the lightweight coordinate as above, but the Cartesian coordinate
+     *  is not calculated. It is instantiated for 2D and 3D.
+     */
+    template <int NumDim>
+    void
+    move(const FixedSphereCoord<NumDim> &x0, double dt,
+         const FixedSphereVelocity<NumDim> &v, const RLLMeshIndex &idx,
+         FixedSphereCoord<NumDim> &x1) const;
 protected:
     virtual void
-    setGridCoords();
+    setGridCoords(int loc) const;
+
+    virtual void
+    syncCache(MeshCache &cache);
+
+    virtual void
+    inputVerticalDomain(const string &filePathV);
 }; // RLLMesh
 
 } // geomtk
@@ -4,6 +4,7 @@ namespace geomtk {
 
 RLLMeshIndex::RLLMeshIndex()
 : StructuredMeshIndex<RLLMesh, SphereCoord>() {
+    reset();
 }
 
 RLLMeshIndex::RLLMeshIndex(uword numDim)
@@ -11,8 +12,11 @@ RLLMeshIndex::RLLMeshIndex(uword numDim)
     reset();
 }
 
-RLLMeshIndex::~RLLMeshIndex() {
-}
+void RLLMeshIndex::
+init(uword numDim) {
+    MeshIndex<RLLMesh, SphereCoord>::init(numDim);
+    reset();
+} // init
 
 void RLLMeshIndex::
 reset() {
@@ -23,41 +27,33 @@ reset() {
     moveOnPole = false;
 } // reset
 
-RLLMeshIndex& RLLMeshIndex::
-operator=(const RLLMeshIndex &other) {
-    StructuredMeshIndex<RLLMesh, SphereCoord>::operator=(other);
-    if (this != &other) {
-        _pole = other._pole;
-        inPolarCap = other.inPolarCap;
-        onPole = other.onPole;
-        moveOnPole = other.moveOnPole;
-    }
-    return *this;
-} // operator=
+void RLLMeshIndex::
+locate(const RLLMesh &mesh, const SphereCoord &x) {
+    StructuredMeshIndex<RLLMesh, SphereCoord>::locate(mesh, x);
+    checkPole(mesh, x(1), indices[1][GridType::FULL], _pole, inPolarCap, onPole);
+} // locate
 
 void RLLMeshIndex::
-locate(const RLLMesh &mesh_, const SphereCoord &x) {
-    StructuredMeshIndex<RLLMesh, SphereCoord>::locate(mesh_, x);
-    const RLLMesh &mesh = static_cast<const RLLMesh&>(mesh_);
-    if (indices[1][GridType::FULL] == 0) {
-        _pole = SOUTH_POLE;
+checkPole(const RLLMesh &mesh, double lat, int j, Pole &pole,
+          bool &inPolarCap, bool &onPole) {
+    if (j == 0) {
+        pole = SOUTH_POLE;
         inPolarCap = true;
-    } else if (indices[1][GridType::FULL] ==
-               static_cast<int>(mesh.numGrid(1, GridType::FULL))-2) {
-        _pole = NORTH_POLE;
+    } else if (j == static_cast<int>(mesh.numGrid(1, GridType::FULL))-2) {
+        pole = NORTH_POLE;
         inPolarCap = true;
     } else {
-        _pole = NOT_POLE;
+        pole = NOT_POLE;
         inPolarCap = false;
     }
-    double r = M_PI_2-fabs(x(1));
+    double r = M_PI_2-fabs(lat);
     if (r < mesh.poleRadius()) {
         onPole = true;
-        _pole = x(1) < 0.0 ? SOUTH_POLE : NORTH_POLE;
+        pole = lat < 0.0 ? SOUTH_POLE : NORTH_POLE;
     } else {
         onPole = false;
     }
-} // locate
+} // checkPole
 
 void RLLMeshIndex::
 print() const {
@@ -8,6 +8,7 @@
 namespace geomtk {
 
 class RLLMeshIndex : public StructuredMeshIndex<RLLMesh, SphereCoord> {
+    friend class RLLMeshIndexBatch;
 public:
     typedef RLLStagger::GridType GridType;
     typedef RLLStagger::Location Location;
@@ -19,13 +20,12 @@ protected:
 public:
     RLLMeshIndex();
     RLLMeshIndex(uword numDim);
-    virtual ~RLLMeshIndex();
 
-    virtual void
-    reset();
+    void
+    init(uword numDim);
 
-    virtual RLLMeshIndex&
-    operator=(const RLLMeshIndex &other);
+    void
+    reset();
 
     /**
      *  Toggle 'moveOnPole' boolean.
@@ -63,10 +63,31 @@ public:
      *
      *  @return None.
      */
-    virtual void
+    void
     locate(const RLLMesh &mesh, const SphereCoord &x);
 
-    virtual void
+    template <int NumDim>
+    void
+    locate(const RLLMesh &mesh, const FixedSphereCoord<NumDim> &x) {
+        StructuredMeshIndex<RLLMesh, SphereCoord>::locate(mesh, x);
+        checkPole(mesh, x(1), indices[1][GridType::FULL], _pole, inPolarCap, onPole);
+    }
+
+    /**
+     *  Judge the pole status from the latitude and its located full index.
+     *
+     *  @param mesh       the RLL mesh.
+     *  @param lat        the latitude.
+     *  @param j          the full grid index along latitude.
+     *  @param pole       the pole that is near.
+     *  @param inPolarCap the boolean flag of being in the polar cap.
+     *  @param onPole     the boolean flag of being within the pole radius.
+     */
+    static void
+    checkPole(const RLLMesh &mesh, double lat, int j, Pole &pole,
+              bool &inPolarCap, bool &onPole);
+
+    void
     print() const;
 }; // RLLMeshIndex
 
@@ -0,0 +1,66 @@
+#include "RLLMeshIndexBatch.h"
+
+namespace geomtk {
+
+const unsigned char RLLMeshIndexBatch::IN_POLAR_CAP;
+const unsigned char RLLMeshIndexBatch::ON_POLE;
+
+RLLMeshIndexBatch::RLLMeshIndexBatch()
+: StructuredMeshIndexBatch<RLLMesh, SphereCoord>() {
+}
+
+RLLMeshIndexBatch::RLLMeshIndexBatch(uword numDim, uword numPoint)
+: StructuredMeshIndexBatch<RLLMesh, SphereCoord>() {
+    init(numDim, numPoint);
+}
+
+RLLMeshIndexBatch::~RLLMeshIndexBatch() {
+}
+
+void RLLMeshIndexBatch::
+init(uword numDim, uword numPoint) {
+    poles.resize(numPoint);
+    flags.resize(numPoint);
+    StructuredMeshIndexBatch<RLLMesh, SphereCoord>::init(numDim, numPoint);
+} // init
+
+void RLLMeshIndexBatch::
+reset() {
+    StructuredMeshIndexBatch<RLLMesh, SphereCoord>::reset();
+    std::fill(poles.begin(), poles.end(), NOT_POLE);
+    std::fill(flags.begin(), flags.end(), 0);
+} // reset
+
+void RLLMeshIndexBatch::
+locate(const RLLMesh &mesh, const mat &x, bool useHint) {
+    if (x.n_rows != _numPoint || numDim != mesh.domain().numDim()) {
+        init(mesh.domain().numDim(), x.n_rows);
+        useHint = false;
+    }
+    #pragma omp parallel for
+    for (uword p = 0; p < _numPoint; ++p) {
+        locatePoint(mesh, x, p, useHint);
+        bool inPolarCap, onPole;
+        RLLMeshIndex::checkPole(mesh, x(p, 1), (*this)(p, 1, GridType::FULL),
+                                poles[p], inPolarCap, onPole);
+        flags[p] = (inPolarCap ? IN_POLAR_CAP : 0) | (onPole ? ON_POLE : 0);
+    }
+} // locate
+
+void RLLMeshIndexBatch::
+get(uword pointIdx, RLLMeshIndex &idx) const {
+    StructuredMeshIndexBatch<RLLMesh, SphereCoord>::get(pointIdx, idx);
+    idx._pole = poles[pointIdx];
+    idx.inPolarCap = isInPolarCap(pointIdx);
+    idx.onPole = isOnPole(pointIdx);
+} // get
+
+void RLLMeshIndexBatch::
+set(uword pointIdx, const RLLMeshIndex &idx) {
+    StructuredMeshIndexBatch<RLLMesh, SphereCoord>::set(pointIdx, idx);
+    poles[pointIdx] = idx.pole();
+    flags[pointIdx] = (idx.isInPolarCap() ? IN_POLAR_CAP : 0) |
+                      (idx.isOnPole() ? ON_POLE : 0);
+} // set
+
+} // geomtk
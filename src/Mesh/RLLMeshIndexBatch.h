@@ -0,0 +1,83 @@
+#ifndef __GEOMTK_RLLMeshIndexBatch__
+#define __GEOMTK_RLLMeshIndexBatch__
+
+#include "StructuredMeshIndexBatch.h"
+#include "RLLMeshIndex.h"
+
+namespace geomtk {
+
+/**
+ *  This class adds the pole judgement into the batched locating on RLL mesh.
+ *  The longitude and latitude are given as the first and second columns.
+ */
+class RLLMeshIndexBatch : public StructuredMeshIndexBatch<RLLMesh, SphereCoord> {
+public:
+    typedef RLLStagger::GridType GridType;
+    typedef RLLStagger::Location Location;
+
+    static const unsigned char IN_POLAR_CAP = 1;
+    static const unsigned char ON_POLE = 2;
+protected:
+    vector<Pole> poles;
+    vector<unsigned char> flags;
+public:
+    RLLMeshIndexBatch();
+    RLLMeshIndexBatch(uword numDim, uword numPoint);
+    virtual ~RLLMeshIndexBatch();
+
+    virtual void
+    init(uword numDim, uword numPoint);
+
+    virtual void
+    reset();
+
+    Pole
+    pole(uword pointIdx) const {
+        return poles[pointIdx];
+    }
+
+    bool
+    isInPolarCap(uword pointIdx) const {
+        return (flags[pointIdx] & IN_POLAR_CAP) != 0;
+    }
+
+    bool
+    isOnPole(uword pointIdx) const {
+        return (flags[pointIdx] & ON_POLE) != 0;
+    }
+
+    /**
+     *  Get the packed pole flags (IN_POLAR_CAP and ON_POLE bits).
+     *
+     *  @return The pointer to the flag array.
+     */
+    const unsigned char*
+    flagMemptr() const {
+        return &flags[0];
+    }
+
+    virtual void
+    locate(const RLLMesh &mesh, const mat &x, bool useHint = false);
+
+    /**
+     *  Copy the indices and pole status of one point into a single mesh index.
+     *
+     *  @param pointIdx the point index.
+     *  @param idx      the mesh index.
+     */
+    void
+    get(uword pointIdx, RLLMeshIndex &idx) const;
+
+    /**
+     *  Copy the indices and pole status of a single mesh index into one point.
+     *
+     *  @param pointIdx the point index.
+     *  @param idx      the mesh index.
+     */
+    void
+    set(uword pointIdx, const RLLMeshIndex &idx);
+}; // RLLMeshIndexBatch
+
+} // geomtk
+
+#endif // __GEOMTK_RLLMeshIndexBatch__
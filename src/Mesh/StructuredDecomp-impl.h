@@ -0,0 +1,173 @@
+namespace geomtk {
+
+template <class MeshType>
+StructuredDecomp<MeshType>::
+StructuredDecomp() {
+    _mesh = NULL;
+    numDim = 0;
+    _rank = 0;
+    _numRank = 1;
+    _haloWidth = 0;
+    isAttached = false;
+    for (int m = 0; m < 3; ++m) {
+        _numProc[m] = 1;
+        _procIdx[m] = 0;
+        hasHalo[m] = false;
+    }
+#ifdef GEOMTK_USE_MPI
+    _comm = MPI_COMM_NULL;
+    _rowComm = MPI_COMM_NULL;
+#endif
+}
+
+template <class MeshType>
+StructuredDecomp<MeshType>::
+~StructuredDecomp() {
+    detach();
+#ifdef GEOMTK_USE_MPI
+    int isFinalized;
+    MPI_Finalized(&isFinalized);
+    if (!isFinalized) {
+        if (_rowComm != MPI_COMM_NULL) MPI_Comm_free(&_rowComm);
+        if (_comm != MPI_COMM_NULL) MPI_Comm_free(&_comm);
+    }
+#endif
+}
+
+template <class MeshType>
+void StructuredDecomp<MeshType>::
+init(const MeshType &mesh, int numProcX, int numProcY, int numProcZ) {
+    int rank = 0, numRank = 1;
+#ifdef GEOMTK_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &numRank);
+#endif
+    if (numProcX*numProcY*numProcZ != numRank) {
+        REPORT_ERROR("Process numbers (" << numProcX << "x" << numProcY <<
+                     "x" << numProcZ << ") do not match rank number (" <<
+                     numRank << ")!");
+    }
+    detach();
+    init(mesh, numProcX, numProcY, numProcZ, rank);
+    if (_numRank > 1) {
+        _mesh->numDecomp++;
+        isAttached = true;
+    }
+#ifdef GEOMTK_USE_MPI
+    MPI_Comm_dup(MPI_COMM_WORLD, &_comm);
+    MPI_Comm_split(_comm, _procIdx[1]+numProcY*_procIdx[2], _procIdx[0], &_rowComm);
+#endif
+} // init
+
+template <class MeshType>
+void StructuredDecomp<MeshType>::
+init(const MeshType &mesh, int numProcX, int numProcY, int numProcZ,
+     int rank) {
+    _mesh = &mesh;
+    numDim = mesh.domain().numDim();
+    _numProc[0] = numProcX;
+    _numProc[1] = numProcY;
+    _numProc[2] = numDim > 2 ? numProcZ : 1;
+    if (numDim < 3 && numProcZ != 1) {
+        REPORT_ERROR("Domain is not 3D, but numProcZ is " << numProcZ << "!");
+    }
+    _numRank = _numProc[0]*_numProc[1]*_numProc[2];
+    if (rank < 0 || rank >= _numRank) {
+        REPORT_ERROR("Rank " << rank << " is out of range!");
+    }
+    _rank = rank;
+    _procIdx[0] = rank%_numProc[0];
+    _procIdx[1] = rank/_numProc[0]%_numProc[1];
+    _procIdx[2] = rank/(_numProc[0]*_numProc[1]);
+    _haloWidth = mesh.haloWidth();
+    for (uword m = 0; m < 3; ++m) {
+        hasHalo[m] = m < numDim && (_numProc[m] > 1 ||
+                                    mesh.domain().axisStartBndType(m) == PERIODIC);
+        setBlocks(m, GridType::FULL);
+        setBlocks(m, GridType::HALF);
+    }
+} // init
+
+template <class MeshType>
+void StructuredDecomp<MeshType>::
+setBlocks(uword axisIdx, int gridType) {
+    vector<int> &starts = blockStarts[axisIdx][gridType];
+    starts.resize(_numProc[axisIdx]+1);
+    if (axisIdx >= numDim) {
+        starts[0] = 0;
+        starts[1] = 1;
+        return;
+    }
+    int n = mesh().numGrid(axisIdx, gridType);
+    int s = mesh().startIndex(axisIdx, gridType);
+    if (n < _numProc[axisIdx]*_haloWidth) {
+        REPORT_ERROR("Too many processes (" << _numProc[axisIdx] <<
+                     ") along axis " << axisIdx << " with " << n << " grids!");
+    }
+    // Split the grids as evenly as possible.
+    for (int p = 0; p <= _numProc[axisIdx]; ++p) {
+        starts[p] = s+p*n/_numProc[axisIdx];
+    }
+} // setBlocks
+
+template <class MeshType>
+void StructuredDecomp<MeshType>::
+detach() {
+    if (isAttached) {
+        _mesh->numDecomp--;
+        isAttached = false;
+    }
+} // detach
+
+template <class MeshType>
+int StructuredDecomp<MeshType>::
+neighborRank(const int offsets[3]) const {
+    int procIdx[3];
+    for (uword m = 0; m < 3; ++m) {
+        procIdx[m] = _procIdx[m]+offsets[m];
+        if (procIdx[m] < 0 || procIdx[m] >= _numProc[m]) {
+            if (m < numDim && mesh().domain().axisStartBndType(m) == PERIODIC) {
+                procIdx[m] = (procIdx[m]+_numProc[m])%_numProc[m];
+            } else {
+                return -1;
+            }
+        }
+    }
+    return procIdx[0]+_numProc[0]*(procIdx[1]+_numProc[1]*procIdx[2]);
+} // neighborRank
+
+template <class MeshType>
+template <typename T>
+void StructuredDecomp<MeshType>::
+allocate(int loc, AlignedArray<T> &data) const {
+    uword n[3] = {1, 1, 1};
+    for (uword m = 0; m < numDim; ++m) {
+        n[m] = numGrid(m, mesh().gridType(m, loc), true);
+    }
+    data.set_size(n[0], n[1], n[2]);
+} // allocate
+
+template <class MeshType>
+void StructuredDecomp<MeshType>::
+gatherRow(int loc, const AlignedArray<double> &data, int j, int k,
+          vector<double> &ring) const {
+    int gridType = mesh().gridType(0, loc);
+    int nx = numGrid(0, gridType);
+    int lj = numDim > 1 ? localIndex(1, mesh().gridType(1, loc), j) : 0;
+    int lk = numDim > 2 ? localIndex(2, mesh().gridType(2, loc), k) : 0;
+    const double *row = &data(localHaloWidth(0), lj, lk);
+    ring.resize(mesh().numGrid(0, gridType));
+#ifdef GEOMTK_USE_MPI
+    vector<int> counts(_numProc[0]), displs(_numProc[0]);
+    for (int p = 0; p < _numProc[0]; ++p) {
+        displs[p] = startIndex(0, gridType, p)-startIndex(0, gridType, 0);
+        counts[p] = endIndex(0, gridType, p)-startIndex(0, gridType, p)+1;
+    }
+    MPI_Allgatherv(row, nx, MPI_DOUBLE, &ring[0], &counts[0], &displs[0],
+                   MPI_DOUBLE, _rowComm);
+#else
+    std::copy(row, row+nx, ring.begin());
+#endif
+} // gatherRow
+
+} // geomtk
@@ -0,0 +1,207 @@
+#ifndef __GEOMTK_StructuredDecomp__
+#define __GEOMTK_StructuredDecomp__
+
+#include "StructuredMesh.h"
+#include "AlignedArray.h"
+#ifdef GEOMTK_USE_MPI
+#include <mpi.h>
+#endif
+
+namespace geomtk {
+
+/**
+ *  This class decomposes a structured mesh into blocks along each axis, and
+ *  each MPI rank owns one block. The mesh itself (coordinates, intervals) is
+ *  kept global, since it is small, and only the field data are allocated for
+ *  the local block with halos on both sides of each decomposed or periodic
+ *  axis. The index ranges returned by this class are in the global index
+ *  space of the mesh (e.g. startIndex(0, FULL) is in [is, ie] of the mesh),
+ *  and localIndex maps them into the local arrays.
+ *
+ *  When GEOMTK_USE_MPI is not defined, there is only one rank, but the
+ *  layout of any rank can still be inspected by init with explicit rank.
+ *
+ *  Ranks are ordered as rank = px+numProc(0)*(py+numProc(1)*pz).
+ */
+template <class MeshType>
+class StructuredDecomp {
+public:
+    typedef StructuredStagger::GridType GridType;
+    typedef StructuredStagger::Location Location;
+protected:
+    const MeshType *_mesh;
+    uword numDim;
+    int _rank, _numRank;
+    int _numProc[3];
+    int _procIdx[3];
+    int _haloWidth;
+    // global start indices of all blocks (numProc+1 elements)
+    vector<int> blockStarts[3][2];
+    bool hasHalo[3];
+    // whether the mesh is marked as decomposed by this object
+    bool isAttached;
+#ifdef GEOMTK_USE_MPI
+    MPI_Comm _comm;
+    MPI_Comm _rowComm; // ranks with the same y and z process indices
+#endif
+public:
+    StructuredDecomp();
+    virtual ~StructuredDecomp();
+
+    /**
+     *  Decompose the mesh for the current MPI rank. When there are more than
+     *  one rank, the mesh is marked as decomposed (see
+     *  StructuredMesh::isDecomposed) until this object is destroyed.
+     *
+     *  @param mesh the global mesh.
+     *  @param numProcX the number of processes along x axis.
+     *  @param numProcY the number of processes along y axis.
+     *  @param numProcZ the number of processes along z axis.
+     */
+    void
+    init(const MeshType &mesh, int numProcX, int numProcY, int numProcZ = 1);
+
+    /**
+     *  Compute the block layout for the given rank without communicators.
+     */
+    void
+    init(const MeshType &mesh, int numProcX, int numProcY, int numProcZ,
+         int rank);
+
+    const MeshType&
+    mesh() const { return *_mesh; }
+
+    int
+    rank() const { return _rank; }
+
+    int
+    numRank() const { return _numRank; }
+
+    int
+    numProc(uword axisIdx) const { return _numProc[axisIdx]; }
+
+    int
+    procIdx(uword axisIdx) const { return _procIdx[axisIdx]; }
+
+    int
+    haloWidth() const { return _haloWidth; }
+
+    /**
+     *  Return the global index of the first interior grid of the block.
+     */
+    int
+    startIndex(uword axisIdx, int gridType) const {
+        return blockStarts[axisIdx][gridType][_procIdx[axisIdx]];
+    }
+
+    /**
+     *  Return the global index of the last interior grid of the block.
+     */
+    int
+    endIndex(uword axisIdx, int gridType) const {
+        return blockStarts[axisIdx][gridType][_procIdx[axisIdx]+1]-1;
+    }
+
+    int
+    startIndex(uword axisIdx, int gridType, int procIdx) const {
+        return blockStarts[axisIdx][gridType][procIdx];
+    }
+
+    int
+    endIndex(uword axisIdx, int gridType, int procIdx) const {
+        return blockStarts[axisIdx][gridType][procIdx+1]-1;
+    }
+
+    /**
+     *  Return the local grid number along the given axis.
+     *
+     *  @param axisIdx the axis index.
+     *  @param gridType the grid type.
+     *  @param hasHaloGrids the flag for including halo grids.
+     *
+     *  @return The grid number.
+     */
+    uword
+    numGrid(uword axisIdx, int gridType, bool hasHaloGrids = false) const {
+        uword res = endIndex(axisIdx, gridType)-startIndex(axisIdx, gridType)+1;
+        if (hasHaloGrids && hasHalo[axisIdx]) res += 2*_haloWidth;
+        return res;
+    }
+
+    /**
+     *  Return the local halo width along the given axis (zero if the axis is
+     *  neither decomposed nor periodic).
+     */
+    int
+    localHaloWidth(uword axisIdx) const {
+        return hasHalo[axisIdx] ? _haloWidth : 0;
+    }
+
+    /**
+     *  Map a global grid index into the index of the local arrays.
+     */
+    int
+    localIndex(uword axisIdx, int gridType, int globalIdx) const {
+        return globalIdx-startIndex(axisIdx, gridType)+localHaloWidth(axisIdx);
+    }
+
+    /**
+     *  Return the rank of the neighbor block.
+     *
+     *  @param offsets the block offsets along each axis (-1, 0 or 1).
+     *
+     *  @return The rank, or -1 if there is no neighbor (e.g. beyond poles).
+     */
+    int
+    neighborRank(const int offsets[3]) const;
+
+    bool
+    isAtAxisStart(uword axisIdx) const { return _procIdx[axisIdx] == 0; }
+
+    bool
+    isAtAxisEnd(uword axisIdx) const {
+        return _procIdx[axisIdx] == _numProc[axisIdx]-1;
+    }
+
+    /**
+     *  Allocate the local array of a field on the given stagger location,
+     *  including halos.
+     */
+    template <typename T>
+    void
+    allocate(int loc, AlignedArray<T> &data) const;
+
+#ifdef GEOMTK_USE_MPI
+    MPI_Comm
+    comm() const { return _comm; }
+
+    MPI_Comm
+    rowComm() const { return _rowComm; }
+#endif
+
+    /**
+     *  Gather one whole latitude row (e.g. the polar ring) from the ranks in
+     *  the same process row, which is an all-to-all along the row.
+     *
+     *  @param loc the stagger location of the local array.
+     *  @param data the local array.
+     *  @param j the global y index of the row.
+     *  @param k the global z index of the row.
+     *  @param ring the output ring with numGrid(0, gridType) elements.
+     */
+    void
+    gatherRow(int loc, const AlignedArray<double> &data, int j, int k,
+              vector<double> &ring) const;
+protected:
+    void
+    setBlocks(uword axisIdx, int gridType);
+
+    void
+    detach();
+}; // StructuredDecomp
+
+} // geomtk
+
+#include "StructuredDecomp-impl.h"
+
+#endif // __GEOMTK_StructuredDecomp__
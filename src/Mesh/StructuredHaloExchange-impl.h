@@ -0,0 +1,200 @@
+namespace geomtk {
+
+template <class MeshType>
+StructuredHaloExchange<MeshType>::
+StructuredHaloExchange() {
+    decomp = NULL;
+    isStarted = false;
+}
+
+template <class MeshType>
+StructuredHaloExchange<MeshType>::
+~StructuredHaloExchange() {
+}
+
+template <class MeshType>
+void StructuredHaloExchange<MeshType>::
+init(const StructuredDecomp<MeshType> &decomp) {
+    this->decomp = &decomp;
+    neighbors.clear();
+    fields.clear();
+    int offsets[3];
+    for (offsets[2] = -1; offsets[2] <= 1; ++offsets[2]) {
+        for (offsets[1] = -1; offsets[1] <= 1; ++offsets[1]) {
+            for (offsets[0] = -1; offsets[0] <= 1; ++offsets[0]) {
+                if (offsets[0] == 0 && offsets[1] == 0 && offsets[2] == 0) continue;
+                bool isValid = true;
+                for (uword m = 0; m < 3; ++m) {
+                    if (offsets[m] != 0 && decomp.localHaloWidth(m) == 0) {
+                        isValid = false;
+                    }
+                }
+                if (!isValid) continue;
+                int rank = decomp.neighborRank(offsets);
+                if (rank < 0) continue;
+                Neighbor neighbor;
+                neighbor.rank = rank;
+                for (uword m = 0; m < 3; ++m) {
+                    neighbor.offsets[m] = offsets[m];
+                }
+                neighbors.push_back(neighbor);
+            }
+        }
+    }
+} // init
+
+template <class MeshType>
+void StructuredHaloExchange<MeshType>::
+addField(int loc, AlignedArray<double> &data) {
+    if (isStarted) {
+        REPORT_ERROR("Halo exchange is in progress!");
+    }
+    fields.push_back(&data);
+    for (uword l = 0; l < neighbors.size(); ++l) {
+        Neighbor &neighbor = neighbors[l];
+        Slab sendSlab, recvSlab;
+        setSlab(loc, neighbor.offsets, true, sendSlab);
+        setSlab(loc, neighbor.offsets, false, recvSlab);
+        neighbor.sendSlabs.push_back(sendSlab);
+        neighbor.recvSlabs.push_back(recvSlab);
+        neighbor.sendBuffer.resize(neighbor.sendBuffer.size()+
+            sendSlab.count[0]*sendSlab.count[1]*sendSlab.count[2]);
+        neighbor.recvBuffer.resize(neighbor.recvBuffer.size()+
+            recvSlab.count[0]*recvSlab.count[1]*recvSlab.count[2]);
+    }
+} // addField
+
+template <class MeshType>
+void StructuredHaloExchange<MeshType>::
+clearFields() {
+    fields.clear();
+    for (uword l = 0; l < neighbors.size(); ++l) {
+        neighbors[l].sendSlabs.clear();
+        neighbors[l].recvSlabs.clear();
+        neighbors[l].sendBuffer.clear();
+        neighbors[l].recvBuffer.clear();
+    }
+} // clearFields
+
+template <class MeshType>
+void StructuredHaloExchange<MeshType>::
+setSlab(int loc, const int offsets[3], bool isSend, Slab &slab) const {
+    for (uword m = 0; m < 3; ++m) {
+        if (m >= decomp->mesh().domain().numDim()) {
+            slab.start[m] = 0;
+            slab.count[m] = 1;
+            continue;
+        }
+        int gridType = decomp->mesh().gridType(m, loc);
+        int h = decomp->localHaloWidth(m);
+        int n = decomp->numGrid(m, gridType);
+        switch (offsets[m]) {
+            case -1:
+                slab.start[m] = isSend ? h : 0;
+                slab.count[m] = h;
+                break;
+            case 1:
+                slab.start[m] = isSend ? n : h+n;
+                slab.count[m] = h;
+                break;
+            default:
+                slab.start[m] = h;
+                slab.count[m] = n;
+        }
+    }
+} // setSlab
+
+template <class MeshType>
+void StructuredHaloExchange<MeshType>::
+pack(const AlignedArray<double> &data, const Slab &slab, double *&buffer) {
+    for (int k = 0; k < slab.count[2]; ++k) {
+        for (int j = 0; j < slab.count[1]; ++j) {
+            const double *row = &data(slab.start[0], slab.start[1]+j, slab.start[2]+k);
+            memcpy(buffer, row, slab.count[0]*sizeof(double));
+            buffer += slab.count[0];
+        }
+    }
+} // pack
+
+template <class MeshType>
+void StructuredHaloExchange<MeshType>::
+unpack(const double *&buffer, const Slab &slab, AlignedArray<double> &data) {
+    for (int k = 0; k < slab.count[2]; ++k) {
+        for (int j = 0; j < slab.count[1]; ++j) {
+            double *row = &data(slab.start[0], slab.start[1]+j, slab.start[2]+k);
+            memcpy(row, buffer, slab.count[0]*sizeof(double));
+            buffer += slab.count[0];
+        }
+    }
+} // unpack
+
+template <class MeshType>
+void StructuredHaloExchange<MeshType>::
+start() {
+    if (isStarted) {
+        REPORT_ERROR("Halo exchange is already started!");
+    }
+    isStarted = true;
+    #pragma omp parallel for
+    for (uword l = 0; l < neighbors.size(); ++l) {
+        Neighbor &neighbor = neighbors[l];
+        double *buffer = neighbor.sendBuffer.data();
+        for (uword f = 0; f < fields.size(); ++f) {
+            pack(*fields[f], neighbor.sendSlabs[f], buffer);
+        }
+    }
+#ifdef GEOMTK_USE_MPI
+    requests.resize(2*neighbors.size());
+    for (uword l = 0; l < neighbors.size(); ++l) {
+        Neighbor &neighbor = neighbors[l];
+        // The data for my halo on this side are sent by the neighbor toward
+        // the opposite side.
+        int oppositeOffsets[3] = {
+            -neighbor.offsets[0], -neighbor.offsets[1], -neighbor.offsets[2]
+        };
+        MPI_Irecv(neighbor.recvBuffer.data(), neighbor.recvBuffer.size(),
+                  MPI_DOUBLE, neighbor.rank, directionIndex(oppositeOffsets),
+                  decomp->comm(), &requests[l]);
+    }
+    for (uword l = 0; l < neighbors.size(); ++l) {
+        Neighbor &neighbor = neighbors[l];
+        MPI_Isend(neighbor.sendBuffer.data(), neighbor.sendBuffer.size(),
+                  MPI_DOUBLE, neighbor.rank, directionIndex(neighbor.offsets),
+                  decomp->comm(), &requests[neighbors.size()+l]);
+    }
+#endif
+} // start
+
+template <class MeshType>
+void StructuredHaloExchange<MeshType>::
+finish() {
+    if (!isStarted) {
+        REPORT_ERROR("Halo exchange is not started!");
+    }
+#ifdef GEOMTK_USE_MPI
+    MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+#else
+    // There is only one rank, so the messages are sent to itself.
+    for (uword l = 0; l < neighbors.size(); ++l) {
+        for (uword r = 0; r < neighbors.size(); ++r) {
+            if (neighbors[r].offsets[0] == -neighbors[l].offsets[0] &&
+                neighbors[r].offsets[1] == -neighbors[l].offsets[1] &&
+                neighbors[r].offsets[2] == -neighbors[l].offsets[2]) {
+                neighbors[l].recvBuffer = neighbors[r].sendBuffer;
+                break;
+            }
+        }
+    }
+#endif
+    #pragma omp parallel for
+    for (uword l = 0; l < neighbors.size(); ++l) {
+        Neighbor &neighbor = neighbors[l];
+        const double *buffer = neighbor.recvBuffer.data();
+        for (uword f = 0; f < fields.size(); ++f) {
+            unpack(buffer, neighbor.recvSlabs[f], *fields[f]);
+        }
+    }
+    isStarted = false;
+} // finish
+
+} // geomtk
@@ -0,0 +1,98 @@
+#ifndef __GEOMTK_StructuredHaloExchange__
+#define __GEOMTK_StructuredHaloExchange__
+
+#include "StructuredDecomp.h"
+
+namespace geomtk {
+
+/**
+ *  This class exchanges the halos of the local arrays among the neighbor
+ *  blocks of a StructuredDecomp. The data of all the added fields are packed
+ *  into one message per neighbor (including the corner ones), which is sent
+ *  by non-blocking MPI calls, so computation can be done between start and
+ *  finish. Every rank must add the fields in the same order.
+ *
+ *  The halos beyond the non-periodic boundaries (e.g. poles) are not touched.
+ */
+template <class MeshType>
+class StructuredHaloExchange {
+protected:
+    struct Slab {
+        int start[3];
+        int count[3];
+    };
+
+    struct Neighbor {
+        int rank;
+        int offsets[3];
+        vector<Slab> sendSlabs, recvSlabs; // one for each field
+        vector<double> sendBuffer, recvBuffer;
+    };
+
+    const StructuredDecomp<MeshType> *decomp;
+    vector<Neighbor> neighbors;
+    vector<AlignedArray<double>*> fields;
+    bool isStarted;
+#ifdef GEOMTK_USE_MPI
+    vector<MPI_Request> requests;
+#endif
+public:
+    StructuredHaloExchange();
+    virtual ~StructuredHaloExchange();
+
+    void
+    init(const StructuredDecomp<MeshType> &decomp);
+
+    /**
+     *  Add a field whose halos will be exchanged.
+     *
+     *  @param loc the stagger location of the field.
+     *  @param data the local array allocated by StructuredDecomp::allocate.
+     */
+    void
+    addField(int loc, AlignedArray<double> &data);
+
+    void
+    clearFields();
+
+    uword
+    numField() const { return fields.size(); }
+
+    /**
+     *  Pack the halos and post the messages.
+     */
+    void
+    start();
+
+    /**
+     *  Wait for the messages and unpack the halos.
+     */
+    void
+    finish();
+
+    void
+    run() {
+        start();
+        finish();
+    }
+protected:
+    static int
+    directionIndex(const int offsets[3]) {
+        return (offsets[0]+1)+3*(offsets[1]+1)+9*(offsets[2]+1);
+    }
+
+    void
+    setSlab(int loc, const int offsets[3], bool isSend, Slab &slab) const;
+
+    static void
+    pack(const AlignedArray<double> &data, const Slab &slab, double *&buffer);
+
+    static void
+    unpack(const double *&buffer, const Slab &slab, AlignedArray<double> &data);
+}; // StructuredHaloExchange
+
+} // geomtk
+
+#include "StructuredHaloExchange-impl.h"
+
+#endif // __GEOMTK_StructuredHaloExchange__
@@ -0,0 +1,67 @@
+namespace geomtk {
+
+template <int NumDim>
+StructuredIndexMap<NumDim>::
+StructuredIndexMap() {
+    _numDim = NumDim;
+    _staggerLocation = -1;
+    for (int m = 0; m < 3; ++m) {
+        starts[m] = 0;
+        counts[m] = 1;
+        haloCounts[m] = 1;
+        periodic[m] = false;
+        strides[m] = 0;
+    }
+}
+
+template <int NumDim>
+template <int N>
+StructuredIndexMap<NumDim>::
+StructuredIndexMap(const StructuredIndexMap<N> &other) {
+    if (NumDim > 0 && other.numDim() != NumDim) {
+        REPORT_ERROR("Index map dimension (" << other.numDim() << ") does " <<
+                     "not match the template parameter (" << NumDim << ")!");
+    }
+    _numDim = other.numDim();
+    _staggerLocation = other._staggerLocation;
+    for (int m = 0; m < 3; ++m) {
+        starts[m] = other.starts[m];
+        counts[m] = other.counts[m];
+        haloCounts[m] = other.haloCounts[m];
+        periodic[m] = other.periodic[m];
+        strides[m] = other.strides[m];
+    }
+}
+
+template <int NumDim>
+template <class MeshType>
+void StructuredIndexMap<NumDim>::
+init(const MeshType &mesh, int loc) {
+    int numDim = mesh.domain().numDim();
+    if (NumDim > 0 && numDim != NumDim) {
+        REPORT_ERROR("Domain dimension (" << numDim << ") does not match " <<
+                     "the template parameter (" << NumDim << ")!");
+    }
+    _numDim = numDim;
+    _staggerLocation = loc;
+    int stride = 1;
+    for (int m = 0; m < 3; ++m) {
+        if (m < numDim) {
+            int gridType = mesh.gridType(m, loc);
+            starts[m] = mesh.startIndex(m, gridType);
+            counts[m] = mesh.numGrid(m, gridType);
+            haloCounts[m] = mesh.numGrid(m, gridType, true);
+            periodic[m] = mesh.domain().axisStartBndType(m) == PERIODIC;
+            strides[m] = stride;
+            stride *= haloCounts[m];
+        } else {
+            starts[m] = 0;
+            counts[m] = 1;
+            haloCounts[m] = 1;
+            periodic[m] = false;
+            strides[m] = 0;
+        }
+    }
+} // init
+
+} // geomtk
@@ -0,0 +1,170 @@
+#ifndef __GEOMTK_StructuredIndexMap__
+#define __GEOMTK_StructuredIndexMap__
+
+#include "geomtk_commons.h"
+#include "Domain.h"
+
+namespace geomtk {
+
+/**
+ *  This class maps between the cell indices (interior grids only, with the
+ *  first axis changing the fastest), the span indices (halos included) and
+ *  the storage offsets of the grids on one stagger location of structured
+ *  mesh. The start indices, grid numbers and storage strides are cached once
+ *  when the mesh is initialized, so the mappings are inlined arithmetic
+ *  without any virtual call or grid type query.
+ *
+ *  The dimension can be given as the template parameter, then the branches
+ *  and loops on the dimension are resolved at compile time, e.g.
+ *
+ *      StructuredIndexMap<3> map(mesh.indexMap(loc));
+ *      for (int cellIdx = 0; cellIdx < map.numCell(); ++cellIdx) {
+ *          double a = d.memptr()[map.cellOffset(cellIdx)];
+ *          ...
+ *      }
+ *
+ *  The default NumDim = 0 takes the dimension at run time as the fallback,
+ *  which is the one cached by StructuredMesh.
+ */
+template <int NumDim = 0>
+class StructuredIndexMap {
+    template <int N> friend class StructuredIndexMap;
+protected:
+    int _numDim;
+    int _staggerLocation;
+    // start indices and numbers of the interior grids
+    int starts[3];
+    int counts[3];
+    // numbers of the grids including halos
+    int haloCounts[3];
+    bool periodic[3];
+    // storage strides of the grids (halos included)
+    int strides[3];
+public:
+    StructuredIndexMap();
+
+    /**
+     *  Convert from the map with another dimension template parameter. The
+     *  dimensions should be the same.
+     */
+    template <int N>
+    StructuredIndexMap(const StructuredIndexMap<N> &other);
+
+    /**
+     *  Cache the index ranges of the given stagger location.
+     *
+     *  @param mesh the structured mesh.
+     *  @param loc  the stagger location.
+     */
+    template <class MeshType>
+    void
+    init(const MeshType &mesh, int loc);
+
+    int
+    numDim() const {
+        return NumDim > 0 ? NumDim : _numDim;
+    }
+
+    int
+    staggerLocation() const {
+        return _staggerLocation;
+    }
+
+    int
+    numCell() const {
+        return counts[0]*(numDim() > 1 ? counts[1] : 1)*
+                         (numDim() > 2 ? counts[2] : 1);
+    }
+
+    int
+    startIndex(int axisIdx) const {
+        return starts[axisIdx];
+    }
+
+    int
+    numGrid(int axisIdx, bool hasHalo = false) const {
+        return hasHalo ? haloCounts[axisIdx] : counts[axisIdx];
+    }
+
+    bool
+    isPeriodic(int axisIdx) const {
+        return periodic[axisIdx];
+    }
+
+    int
+    stride(int axisIdx) const {
+        return strides[axisIdx];
+    }
+
+    /**
+     *  Get the storage offset of the span indices.
+     */
+    int
+    offset(int i, int j = 0, int k = 0) const {
+        return i+(numDim() > 1 ? strides[1]*j : 0)+
+                 (numDim() > 2 ? strides[2]*k : 0);
+    }
+
+    /**
+     *  Wrap the span indices into cell index. The indices on the periodic
+     *  halos are wrapped into the interior.
+     */
+    int
+    wrap(int i, int j = 0, int k = 0) const {
+        int res = wrapAxis(0, i);
+        if (numDim() > 1) res += counts[0]*wrapAxis(1, j);
+        if (numDim() > 2) res += counts[0]*counts[1]*wrapAxis(2, k);
+        return res;
+    }
+
+    /**
+     *  Unwrap the cell index into the span indices. The indices beyond the
+     *  dimension are set to zero.
+     */
+    void
+    unwrap(int cellIdx, int &i, int &j, int &k) const {
+        j = 0; k = 0;
+        if (numDim() == 1) {
+            i = starts[0]+cellIdx;
+            return;
+        }
+        int r = cellIdx/counts[0];
+        i = starts[0]+cellIdx-r*counts[0];
+        if (numDim() == 2) {
+            j = starts[1]+r;
+            return;
+        }
+        int s = r/counts[1];
+        j = starts[1]+r-s*counts[1];
+        k = starts[2]+s;
+    }
+
+    /**
+     *  Get the storage offset of the cell index.
+     */
+    int
+    cellOffset(int cellIdx) const {
+        int i, j, k;
+        unwrap(cellIdx, i, j, k);
+        return offset(i, j, k);
+    }
+protected:
+    int
+    wrapAxis(int axisIdx, int i) const {
+        i -= starts[axisIdx];
+        if (periodic[axisIdx]) {
+            if (i >= counts[axisIdx]) {
+                i -= counts[axisIdx];
+            } else if (i < 0) {
+                i += counts[axisIdx];
+            }
+        }
+        return i;
+    }
+}; // StructuredIndexMap
+
+} // geomtk
+
+#include "StructuredIndexMap-impl.h"
+
+#endif // __GEOMTK_StructuredIndexMap__
@@ -13,6 +13,15 @@ StructuredMesh(DomainType &domain, uword haloWidth)
     halfCoords = new vec[domain.numDim()];
     fullIntervals = new vec[domain.numDim()];
     halfIntervals = new vec[domain.numDim()];
+    for (uword m = 0; m < 3; ++m) {
+        uniformAxes[m] = false;
+        leadGridStarts[m] = 0;
+        leadGridInvIntervals[m] = 0;
+    }
+    for (int loc = 0; loc < 8; ++loc) {
+        isGridCoordsSet[loc] = false;
+    }
+    numDecomp = 0;
 }
 
 template <class DomainType, class CoordType>
@@ -87,6 +96,113 @@ init(uword nx, uword ny, uword nz) {
     this->set = true;
 }
 
+template <class DomainType, class CoordType>
+void StructuredMesh<DomainType, CoordType>::
+initWithCache(const string &cachePath, const string &filePath) {
+    uint64_t key = cacheKey({filePath});
+    MeshCache cache;
+    if (cache.open(cachePath, key)) {
+        if (this->domain().numDim() == 3) {
+            inputVerticalDomain(filePath);
+        }
+        loadCache(cache);
+    } else {
+        init(filePath);
+        saveCache(cachePath, key);
+    }
+} // initWithCache
+
+template <class DomainType, class CoordType>
+void StructuredMesh<DomainType, CoordType>::
+initWithCache(const string &cachePath, const string &filePathH,
+              const string &filePathV) {
+    uint64_t key = cacheKey({filePathH, filePathV});
+    MeshCache cache;
+    if (cache.open(cachePath, key)) {
+        inputVerticalDomain(filePathV);
+        loadCache(cache);
+    } else {
+        init(filePathH, filePathV);
+        saveCache(cachePath, key);
+    }
+} // initWithCache
+
+template <class DomainType, class CoordType>
+uint64_t StructuredMesh<DomainType, CoordType>::
+cacheKey(const vector<string> &filePaths) const {
+    uint64_t key = 14695981039346656037ULL;
+    string className = typeid(*this).name();
+    MeshCache::hash(key, className.c_str(), className.size());
+    uword numDim = this->domain().numDim();
+    MeshCache::hash(key, &numDim, sizeof(numDim));
+    MeshCache::hash(key, &_haloWidth, sizeof(_haloWidth));
+    for (uword m = 0; m < numDim; ++m) {
+        double span[2] = {
+            this->domain().axisStart(m), this->domain().axisEnd(m)
+        };
+        int bndTypes[2] = {
+            this->domain().axisStartBndType(m), this->domain().axisEndBndType(m)
+        };
+        MeshCache::hash(key, span, sizeof(span));
+        MeshCache::hash(key, bndTypes, sizeof(bndTypes));
+    }
+    for (uword i = 0; i < filePaths.size(); ++i) {
+        MeshCache::hashFile(key, filePaths[i]);
+    }
+    return key;
+} // cacheKey
+
+template <class DomainType, class CoordType>
+bool StructuredMesh<DomainType, CoordType>::
+loadCache(const string &cachePath, uint64_t key) {
+    MeshCache cache;
+    if (!cache.open(cachePath, key)) {
+        return false;
+    }
+    loadCache(cache);
+    return true;
+} // loadCache
+
+template <class DomainType, class CoordType>
+void StructuredMesh<DomainType, CoordType>::
+loadCache(MeshCache &cache) {
+    syncCache(cache);
+    setGridTypes();
+    setGridCoords();
+    this->set = true;
+} // loadCache
+
+template <class DomainType, class CoordType>
+void StructuredMesh<DomainType, CoordType>::
+saveCache(const string &cachePath, uint64_t key) {
+    MeshCache cache;
+    cache.create();
+    syncCache(cache);
+    cache.write(cachePath, key);
+} // saveCache
+
+template <class DomainType, class CoordType>
+void StructuredMesh<DomainType, CoordType>::
+syncCache(MeshCache &cache) {
+    cache.sync(fullIndexRanges);
+    cache.sync(halfIndexRanges);
+    for (uword m = 0; m < this->domain().numDim(); ++m) {
+        cache.sync(fullCoords[m]);
+        cache.sync(halfCoords[m]);
+        cache.sync(fullIntervals[m]);
+        cache.sync(halfIntervals[m]);
+        int gridStyle = gridStyles[m];
+        cache.sync(gridStyle);
+        gridStyles[m] = static_cast<StructuredGridStyle>(gridStyle);
+    }
+    for (uword m = 0; m < 3; ++m) {
+        cache.sync(uniformAxes[m]);
+        cache.sync(leadGridStarts[m]);
+        cache.sync(leadGridInvIntervals[m]);
+    }
+    cache.sync(this->volumes);
+} // syncCache
+
 template <class DomainType, class CoordType>
 void StructuredMesh<DomainType, CoordType>::
 setGridCoordComps(uword axisIdx, uword size, const vec &full, const vec &half) {
@@ -298,6 +414,7 @@ setGridCoordComps(uword axisIdx, uword size, const vec &full, const vec &half) {
         } else {
             REPORT_ERROR("Unexpected branch!");
         }
+        setAxisUniformity(m);
     }
     // Set other parameters.
     setGridTypes();
@@ -546,31 +663,32 @@ template <class DomainType, class CoordType>
 const CoordType& StructuredMesh<DomainType, CoordType>::
 gridCoord(int loc, int i) const {
     if (this->domain().numDim() != 1) {
-        return gridCoords[loc][i];
+        return gridCoordsAt(loc)[i];
     } else {
-        return gridCoords[loc][wrapIndex(loc, i)];
+        return gridCoordsAt(loc)[wrapIndex(loc, i)];
     }
 }
 
 template <class DomainType, class CoordType>
 const CoordType& StructuredMesh<DomainType, CoordType>::
 gridCoord(int loc, int i, int j, int k) const {
-    uword cellIdx;
-    switch (this->domain().numDim()) {
-        case 1:
-            cellIdx = wrapIndex(loc, i);
-            break;
-        case 2:
-            cellIdx = wrapIndex(loc, i, j);
-            break;
-        case 3:
-            cellIdx = wrapIndex(loc, i, j, k);
-        default:
-            REPORT_ERROR("Invalid dimension number!");
-    }
-    return gridCoords[loc][cellIdx];
+    return gridCoordsAt(loc)[indexMaps[loc].wrap(i, j, k)];
 }
 
+template <class DomainType, class CoordType>
+const field<CoordType>& StructuredMesh<DomainType, CoordType>::
+gridCoordsAt(int loc) const {
+    // Double-checked locking, since gridCoord may be called in parallel.
+    if (!isGridCoordsSet[loc].load(std::memory_order_acquire)) {
+        lock_guard<mutex> lock(gridCoordsMutex);
+        if (!isGridCoordsSet[loc].load(std::memory_order_relaxed)) {
+            setGridCoords(loc);
+            isGridCoordsSet[loc].store(true, std::memory_order_release);
+        }
+    }
+    return gridCoords[loc];
+} // gridCoordsAt
+
 template <class DomainType, class CoordType>
 int StructuredMesh<DomainType, CoordType>::
 dualGridLocation(int loc) const {
@@ -625,6 +743,48 @@ dualGridLocation(int loc) const {
     }
 }
 
+template <class DomainType, class CoordType>
+int StructuredMesh<DomainType, CoordType>::
+locateLeadGrid(uword axisIdx, double x) const {
+    int gridType = gridStyles[axisIdx] == FULL_LEAD ? GridType::FULL : GridType::HALF;
+    const vec &coords = gridType == GridType::FULL ? fullCoords[axisIdx] : halfCoords[axisIdx];
+    // The valid range of the returned index, where x_{i2+1} should exist.
+    int i1 = startIndex(axisIdx, gridType);
+    int i2 = endIndex(axisIdx, gridType);
+    if (this->domain().axisStartBndType(axisIdx) != PERIODIC) {
+        i2 -= 1;
+    }
+    int i;
+    if (uniformAxes[axisIdx]) {
+        i = static_cast<int>(floor((x-leadGridStarts[axisIdx])*leadGridInvIntervals[axisIdx]));
+        i = std::max(i1, std::min(i, i2));
+        // Fix up round-off errors. When x is on a grid, the left interval is
+        // chosen to be consistent with the searching.
+        while (i > i1 && x <= coords(i)) --i;
+        while (i < i2 && x > coords(i+1)) ++i;
+    } else {
+        // Find the first grid that is not less than x.
+        i = std::lower_bound(coords.begin()+i1, coords.begin()+i2+2, x)-coords.begin()-1;
+        i = std::max(i1, std::min(i, i2));
+    }
+    return i;
+} // locateLeadGrid
+
+template <class DomainType, class CoordType>
+void StructuredMesh<DomainType, CoordType>::
+setAxisUniformity(uword axisIdx) {
+    const vec &coords = gridStyles[axisIdx] == FULL_LEAD ? fullCoords[axisIdx] : halfCoords[axisIdx];
+    uniformAxes[axisIdx] = false;
+    if (coords.size() < 2) return;
+    double dx = (coords(coords.size()-1)-coords(0))/(coords.size()-1);
+    for (uword i = 0; i < coords.size()-1; ++i) {
+        if (fabs(coords(i+1)-coords(i)-dx) > 1.0e-10*fabs(dx)) return;
+    }
+    uniformAxes[axisIdx] = true;
+    leadGridStarts[axisIdx] = coords(0);
+    leadGridInvIntervals[axisIdx] = 1.0/dx;
+} // setAxisUniformity
+
 template <class DomainType, class CoordType>
 vec StructuredMesh<DomainType, CoordType>::
 cellSize(int loc, int cellIdx) const {
@@ -729,8 +889,9 @@ unwrapIndex(int loc, int cellIdx, uword &i) const {
 #ifndef NDEBUG
     assert(this->domain().numDim() == 1);
 #endif
-    auto gridType = gridTypes(0, 0, loc);
-    i = cellIdx+startIndex(0, gridType);
+    int i_, j_, k_;
+    indexMaps[loc].unwrap(cellIdx, i_, j_, k_);
+    i = i_;
 }
 
 template <class DomainType, class CoordType>
@@ -739,10 +900,9 @@ unwrapIndex(int loc, int cellIdx, uword &i, uword &j) const {
 #ifndef NDEBUG
     assert(this->domain().numDim() == 2);
 #endif
-    auto gridType = gridTypes(0, 0, loc);
-    auto nx = numGrid(0, gridType);
-    j = cellIdx/nx+startIndex(1, gridType);
-    i = cellIdx%nx+startIndex(0, gridType);
+    int i_, j_, k_;
+    indexMaps[loc].unwrap(cellIdx, i_, j_, k_);
+    i = i_; j = j_;
 }
 
 template <class DomainType, class CoordType>
@@ -751,16 +911,9 @@ unwrapIndex(int loc, int cellIdx, uword &i, uword &j, uword &k) const {
 #ifndef NDEBUG
     assert(this->domain().numDim() == 3);
 #endif
-    auto gridTypeX = gridTypes(0, 0, loc);
-    auto gridTypeY = gridTypes(0, 1, loc);
-    auto gridTypeZ = gridTypes(0, 2, loc);
-    auto nx = numGrid(0, gridTypeX);
-    auto ny = numGrid(1, gridTypeY);
-    k = cellIdx/(nx*ny);
-    cellIdx -= k*nx*ny;
-    k += startIndex(2, gridTypeZ);
-    j = cellIdx/nx+startIndex(1, gridTypeY);
-    i = cellIdx%nx+startIndex(0, gridTypeX);
+    int i_, j_, k_;
+    indexMaps[loc].unwrap(cellIdx, i_, j_, k_);
+    i = i_; j = j_; k = k_;
 } // unwrapIndex
 
 template <class DomainType, class CoordType>
@@ -784,13 +937,7 @@ wrapIndex(int loc, int i) const {
 #ifndef NDEBUG
     assert(this->domain().numDim() == 1);
 #endif
-    i -= startIndex(0, gridTypes(0, 0, loc));
-    if (this->domain().axisStartBndType(0) == PERIODIC) {
-        if (i >= endIndex(0, gridTypes(0, 0, loc))) {
-            i -= numGrid(0, gridTypes(0, 0, loc));
-        }
-    }
-    return i;
+    return indexMaps[loc].wrap(i);
 } // wrapIndex
 
 template <class DomainType, class CoordType>
@@ -799,75 +946,51 @@ wrapIndex(int loc, int i, int j) const {
 #ifndef NDEBUG
     assert(this->domain().numDim() == 2);
 #endif
-    int nx = numGrid(0, gridTypes(0, 0, loc));
-    i -= startIndex(0, gridTypes(0, 0, loc));
-    j -= startIndex(1, gridTypes(0, 1, loc));
-    if (this->domain().axisStartBndType(0) == PERIODIC) {
-        if (i >= endIndex(0, gridTypes(0, 0, loc))) {
-            i -= numGrid(0, gridTypes(0, 0, loc));
-        }
-    }
-    if (this->domain().axisStartBndType(1) == PERIODIC) {
-        if (j >= endIndex(1, gridTypes(0, 1, loc))) {
-            j -= numGrid(1, gridTypes(0, 1, loc));
-        }
-    }
-    return i+nx*j;
+    return indexMaps[loc].wrap(i, j);
 } // wrapIndex
 
 template <class DomainType, class CoordType>
 int StructuredMesh<DomainType, CoordType>::
 wrapIndex(int loc, int i, int j, int k) const {
-    if (this->domain().numDim() == 2) {
-        return wrapIndex(loc, i, j);
-    }
-    int nx = numGrid(0, gridTypes(0, 0, loc));
-    int ny = numGrid(1, gridTypes(0, 1, loc));
-    i -= startIndex(0, gridTypes(0, 0, loc));
-    j -= startIndex(1, gridTypes(0, 1, loc));
-    k -= startIndex(2, gridTypes(0, 2, loc));
-    if (this->domain().axisStartBndType(0) == PERIODIC) {
-        if (i >= endIndex(0, gridTypes(0, 0, loc))) {
-            i -= numGrid(0, gridTypes(0, 0, loc));
-        }
-    }
-    if (this->domain().axisStartBndType(1) == PERIODIC) {
-        if (j >= endIndex(1, gridTypes(0, 1, loc))) {
-            j -= numGrid(1, gridTypes(0, 1, loc));
-        }
-    }
-    if (this->domain().axisStartBndType(2) == PERIODIC) {
-        if (k >= endIndex(1, gridTypes(0, 1, loc))) {
-            k -= numGrid(2, gridTypes(0, 2, loc));
-        }
-    }
-    return i+nx*j+nx*ny*k;
+    return indexMaps[loc].wrap(i, j, k);
 } // wrapIndex
 
 template <class DomainType, class CoordType>
 void StructuredMesh<DomainType, CoordType>::
 setGridCoords() {
-    // Store the coordinates of each grid point for convenience.
+    lock_guard<mutex> lock(gridCoordsMutex);
     for (int loc = 0; loc < 8; ++loc) {
-        switch (this->domain().numDim()) {
-            case 1:
-                if (loc != Location::CENTER && loc != Location::VERTEX) continue;
-                break;
-            case 2:
-                if (loc != Location::CENTER && loc != Location::VERTEX &&
-                    loc != Location::X_FACE && loc != Location::Y_FACE &&
-                    loc != Location::XY_VERTEX) continue;
-                break;
-            default:
-                break;
-        }
-        gridCoords[loc].set_size(totalNumGrid(loc, this->domain().numDim()));
-        for (uword cellIdx = 0; cellIdx < gridCoords[loc].size(); ++cellIdx) {
-            gridCoords[loc][cellIdx].init(this->domain().numDim());
-            uvec spanIdx = unwrapIndex(loc, cellIdx);
-            for (uword m = 0; m < this->domain().numDim(); ++m) {
-                gridCoords[loc][cellIdx].setComp(m, gridCoordComp(m, gridTypes(0, m, loc), spanIdx[m]));
+        gridCoords[loc].reset();
+        isGridCoordsSet[loc] = false;
+        indexMaps[loc].init(*this, loc);
+    }
+} // setGridCoords
+
+template <class DomainType, class CoordType>
+void StructuredMesh<DomainType, CoordType>::
+setGridCoords(int loc) const {
+    switch (this->domain().numDim()) {
+        case 1:
+            if (loc != Location::CENTER && loc != Location::VERTEX) {
+                REPORT_ERROR("Invalid location " << loc << " for 1D domain!");
             }
+            break;
+        case 2:
+            if (loc != Location::CENTER && loc != Location::VERTEX &&
+                loc != Location::X_FACE && loc != Location::Y_FACE &&
+                loc != Location::XY_VERTEX) {
+                REPORT_ERROR("Invalid location " << loc << " for 2D domain!");
+            }
+            break;
+        default:
+            break;
+    }
+    gridCoords[loc].set_size(totalNumGrid(loc, this->domain().numDim()));
+    for (uword cellIdx = 0; cellIdx < gridCoords[loc].size(); ++cellIdx) {
+        gridCoords[loc][cellIdx].init(this->domain().numDim());
+        uvec spanIdx = unwrapIndex(loc, cellIdx);
+        for (uword m = 0; m < this->domain().numDim(); ++m) {
+            gridCoords[loc][cellIdx].setComp(m, gridCoordComp(m, gridTypes(0, m, loc), spanIdx[m]));
         }
     }
 } // setGridCoords
@@ -2,6 +2,8 @@
 #define __GEOMTK_StructuredMesh__
 
 #include "Mesh.h"
+#include "MeshCache.h"
+#include "StructuredIndexMap.h"
 
 namespace geomtk {
 
@@ -55,10 +57,25 @@ protected:
     vec *halfCoords;
     vec *fullIntervals;
     vec *halfIntervals;
-    field<CoordType> gridCoords[8]; // With different locations.
+    // The grid coordinates of each location are only built when they are
+    // firstly requested by gridCoord, since most of them are never used.
+    mutable field<CoordType> gridCoords[8];
+    mutable atomic<bool> isGridCoordsSet[8];
+    mutable mutex gridCoordsMutex;
 
     field<int> gridTypes;
+    // index maps of each location, which are rebuilt when grids are changed
+    StructuredIndexMap<> indexMaps[8];
     StructuredGridStyle gridStyles[3];
+    // Uniform axis acceleration data for locating points, which are about the
+    // lead grids (FULL for FULL_LEAD and HALF for HALF_LEAD) including halos.
+    bool uniformAxes[3];
+    double leadGridStarts[3];
+    double leadGridInvIntervals[3];
+    // the number of the StructuredDecomp among more than one rank
+    mutable atomic<int> numDecomp;
+
+    template <class MeshType> friend class StructuredDecomp;
 public:
     StructuredMesh(DomainType &domain, uword haloWidth = 1);
     virtual ~StructuredMesh();
@@ -84,6 +101,60 @@ public:
     virtual void
     init(uword nx, uword ny = 1, uword nz = 1);
 
+    /**
+     *  Initialize the mesh as init(filePath), but load the derived mesh tables
+     *  from the binary cache if it is built from the same grid file, otherwise
+     *  write the cache after initialization. The vertical coordinate of a 3D
+     *  domain is not cached, so it is still read from the grid file.
+     *
+     *  @param cachePath the cache file path.
+     *  @param filePath  the grid file name.
+     */
+    void
+    initWithCache(const string &cachePath, const string &filePath);
+
+    /**
+     *  Initialize the mesh as init(filePathH, filePathV) with the cache. The
+     *  vertical coordinate of the domain is not cached, so the vertical grid
+     *  file is still read.
+     */
+    void
+    initWithCache(const string &cachePath, const string &filePathH,
+                  const string &filePathV);
+
+    /**
+     *  Calculate the cache key from the contents of the grid files and the
+     *  mesh parameters.
+     *
+     *  @param filePaths the grid file names.
+     *
+     *  @return The cache key.
+     */
+    virtual uint64_t
+    cacheKey(const vector<string> &filePaths) const;
+
+    /**
+     *  Load the mesh tables from the cache file.
+     *
+     *  @return False if the cache does not exist or is stale.
+     */
+    bool
+    loadCache(const string &cachePath, uint64_t key);
+
+    void
+    saveCache(const string &cachePath, uint64_t key);
+
+    /**
+     *  Check if the mesh is decomposed among MPI ranks by StructuredDecomp.
+     *  Each rank then only owns one block of the fields, so their halos
+     *  should be updated by StructuredHaloExchange, and applyBndCond reports
+     *  error.
+     */
+    bool
+    isDecomposed() const {
+        return numDecomp > 0;
+    }
+
     uword
     haloWidth() const {
         return _haloWidth;
@@ -94,6 +165,15 @@ public:
         return isDual ? gridTypes(1, axisIdx, loc) : gridTypes(0, axisIdx, loc);
     }
 
+    /**
+     *  Get the cached index map of the given location, which can be converted
+     *  into StructuredIndexMap<NumDim> for the loops with fixed dimension.
+     */
+    const StructuredIndexMap<>&
+    indexMap(int loc) const {
+        return indexMaps[loc];
+    }
+
     StructuredGridStyle
     gridStyle(int axisIdx) const {
         return gridStyles[axisIdx];
@@ -102,6 +182,31 @@ public:
     int
     dualGridLocation(int loc) const;
 
+    /**
+     *  Return whether the lead grids along the given axis are equally spaced.
+     *
+     *  @param axisIdx the axis index.
+     *
+     *  @return The boolean flag.
+     */
+    bool
+    isAxisUniform(uword axisIdx) const {
+        return uniformAxes[axisIdx];
+    }
+
+    /**
+     *  Find the lead grid interval that contains the given coordinate
+     *  component, so that x is in [x_i, x_{i+1}]. Uniform axes are located by
+     *  arithmetic, and others by binary search.
+     *
+     *  @param axisIdx the axis index.
+     *  @param x       the coordinate component.
+     *
+     *  @return The lead grid index i.
+     */
+    int
+    locateLeadGrid(uword axisIdx, double x) const;
+
     /**
      *  Set the grid index ranges (start index and end index).
      *
@@ -174,6 +279,25 @@ public:
     virtual const CoordType&
     gridCoord(int loc, int i, int j, int k = 0) const;
 
+    /**
+     *  Calculate the space coordinate of a grid from the 1D grid coordinates
+     *  without touching the stored grid coordinates.
+     *
+     *  @param loc the grid location.
+     *  @param i   the grid index along x axis.
+     *  @param j   the grid index along y axis.
+     *  @param k   the grid index along z axis.
+     *  @param x   the output coordinate (e.g. FixedSphereCoord).
+     */
+    template <class PointType>
+    void
+    calcGridCoord(int loc, int i, int j, int k, PointType &x) const {
+        int idx[3] = {i, j, k};
+        for (uword m = 0; m < this->domain().numDim(); ++m) {
+            x.setComp(m, gridCoordComp(m, gridTypes(0, m, loc), idx[m]));
+        }
+    }
+
     /**
      *  Set the cell volumes after grids are set.
      */
@@ -390,11 +514,44 @@ public:
     virtual bool
     isHorizontalGridsSame(const Mesh<DomainType, CoordType> &other) const;
 protected:
-    virtual void
+    /**
+     *  Discard the built grid coordinates after the grids are changed.
+     */
+    void
     setGridCoords();
 
+    /**
+     *  Build the grid coordinates of the given location, which is called by
+     *  gridCoord for the first time.
+     */
+    virtual void
+    setGridCoords(int loc) const;
+
+    const field<CoordType>&
+    gridCoordsAt(int loc) const;
+
+    /**
+     *  Read or write all the derived mesh tables. The subclasses should append
+     *  their own tables.
+     */
+    virtual void
+    syncCache(MeshCache &cache);
+
+    void
+    loadCache(MeshCache &cache);
+
+    /**
+     *  Set the domain from the vertical grid file when the mesh tables are
+     *  loaded from the cache.
+     */
+    virtual void
+    inputVerticalDomain(const string &filePathV) {}
+
     void
     setGridTypes();
+
+    void
+    setAxisUniformity(uword axisIdx);
 }; // StructuredMesh
 
 } // geomtk
@@ -3,35 +3,19 @@ namespace geomtk {
 template <class MeshType, class CoordType>
 StructuredMeshIndex<MeshType, CoordType>::
 StructuredMeshIndex() : MeshIndex<MeshType, CoordType>() {
-    indices = NULL;
+    reset();
 }
 
 template <class MeshType, class CoordType>
 StructuredMeshIndex<MeshType, CoordType>::
 StructuredMeshIndex(uword numDim) : MeshIndex<MeshType, CoordType>(numDim) {
-    init(numDim);
-}
-
-template <class MeshType, class CoordType>
-StructuredMeshIndex<MeshType, CoordType>::
-~StructuredMeshIndex() {
-    if (indices) {
-        for (uword i = 0; i < 3; ++i) {
-            delete [] indices[i];
-        }
-        delete [] indices;
-    }
+    reset();
 }
 
 template <class MeshType, class CoordType>
 void StructuredMeshIndex<MeshType, CoordType>::
 init(uword numDim) {
     MeshIndex<MeshType, CoordType>::init(numDim);
-    // NOTE: Index is 3D no matter the dimension size of domain.
-    indices = new int*[3];
-    for (uword i = 0; i < 3; ++i) {
-        indices[i] = new int[2];
-    }
     reset();
 } // init
 
@@ -49,33 +33,6 @@ reset() {
     }
 } // reset
 
-template <class MeshType, class CoordType>
-int StructuredMeshIndex<MeshType, CoordType>::
-operator()(uword axisIdx, int gridType) const {
-    return indices[axisIdx][gridType];
-} // operator()
-
-template <class MeshType, class CoordType>
-int& StructuredMeshIndex<MeshType, CoordType>::
-operator()(uword axisIdx, int gridType) {
-    return indices[axisIdx][gridType];
-} // operator()
-
-template <class MeshType, class CoordType>
-StructuredMeshIndex<MeshType, CoordType>& StructuredMeshIndex<MeshType, CoordType>::
-operator=(const StructuredMeshIndex<MeshType, CoordType> &other) {
-    MeshIndex<MeshType, CoordType>::operator=(other);
-    if (this != &other) {
-        for (uword m = 0; m < 3; ++m) {
-            for (uword i = 0; i < 2; ++i) {
-                indices[m][i] = other.indices[m][i];
-            }
-        }
-    }
-    return *this;
-} // operator=
-
-// TODO: Could we use the searching results by using MLPACK?
 template <class MeshType, class CoordType>
 void StructuredMeshIndex<MeshType, CoordType>::
 locate(const MeshType &mesh, const CoordType &x) {
@@ -84,231 +41,88 @@ locate(const MeshType &mesh, const CoordType &x) {
     assert(domain.isValid(x));
 #endif
     for (uword m = 0; m < domain.numDim(); ++m) {
-        // #####################################################################
-        if (indices[m][GridType::FULL] == UNDEFINED_MESH_INDEX) {
-            if (domain.axisStartBndType(m) == PERIODIC) {
-                int gridType1, gridType2;
-                if (mesh.gridStyle(m) == FULL_LEAD) {
-                    gridType1 = GridType::FULL;
-                    gridType2 = GridType::HALF;
-                } else {
-                    gridType1 = GridType::HALF;
-                    gridType2 = GridType::FULL;
-                }
-                for (uword i = mesh.startIndex(m, gridType1);
-                     i <= mesh.endIndex(m, gridType1); ++i) {
-                    if (x(m) >= mesh.gridCoordComp(m, gridType1, i) &&
-                        x(m) <= mesh.gridCoordComp(m, gridType1, i+1)) {
-                        indices[m][gridType1] = i;
-                        break;
-                    }
-                }
+        locateAxis(mesh, m, x(m), indices[m]);
+    }
+} // locate
+
+template <class MeshType, class CoordType>
+template <int NumDim>
+void StructuredMeshIndex<MeshType, CoordType>::
+locate(const MeshType &mesh, const FixedSpaceCoord<NumDim> &x) {
 #ifndef NDEBUG
-                assert(indices[m][gridType1] != UNDEFINED_MESH_INDEX);
+    assert(mesh.domain().numDim() == static_cast<uword>(NumDim));
 #endif
-                for (int i = indices[m][gridType1]-1;
-                     i < indices[m][gridType1]+1; ++i) {
-                    if (x(m) >= mesh.gridCoordComp(m, gridType2, i) &&
-                        x(m) <= mesh.gridCoordComp(m, gridType2, i+1)) {
-                        indices[m][gridType2] = i;
-                        break;
-                    }
-                }
-            }
-            // =================================================================
-            else if (mesh.gridCoordComp(m, GridType::FULL, 0) == domain.axisStart(m)) {
-                for (uword i = mesh.startIndex(m, GridType::FULL);
-                     i < mesh.endIndex(m, GridType::FULL); ++i) {
-                    if (x(m) >= mesh.gridCoordComp(m, GridType::FULL, i) &&
-                        x(m) <= mesh.gridCoordComp(m, GridType::FULL, i+1)) {
-                        indices[m][GridType::FULL] = i;
-                        break;
-                    }
-                }
-                // TODO: Could we remove the POLE condition?
-                if (domain.axisStartBndType(m) == POLE) {
-                    if (x(m) < mesh.gridCoordComp(m, GridType::HALF,
-                                                  mesh.startIndex(m, GridType::HALF))) {
-                        indices[m][GridType::HALF] = -1;
-                        continue;
-                    } else if (x(m) > mesh.gridCoordComp(m, GridType::HALF,
-                                                         mesh.endIndex(m, GridType::HALF))) {
-                        indices[m][GridType::HALF] = mesh.numGrid(m, GridType::HALF)-1;
-                        continue;
-                    }
-                }
-                int i1 = max(indices[m][GridType::FULL]-2, static_cast<int>(mesh.startIndex(m, GridType::FULL)));
-                int i2 = min(indices[m][GridType::FULL]+2, static_cast<int>(mesh.endIndex(m, GridType::FULL)));
-                for (int i = i1; i < i2; ++i) {
-                    if (x(m) >= mesh.gridCoordComp(m, GridType::HALF, i) &&
-                        x(m) <= mesh.gridCoordComp(m, GridType::HALF, i+1)) {
-                        indices[m][GridType::HALF] = i;
-                        break;
-                    }
-                }
-            }
-            // =================================================================
-            else {
-                for (int i = static_cast<int>(mesh.startIndex(m, GridType::HALF));
-                     i < static_cast<int>(mesh.endIndex(m, GridType::HALF)); ++i) {
-                    if (x(m) >= mesh.gridCoordComp(m, GridType::HALF, i) &&
-                        x(m) <= mesh.gridCoordComp(m, GridType::HALF, i+1)) {
-                        indices[m][GridType::HALF] = i;
-                        break;
-                    }
-                }
-                if (x(m) < mesh.gridCoordComp(m, GridType::FULL,
-                                              mesh.startIndex(m, GridType::FULL))) {
-                    indices[m][GridType::FULL] = -1;
-                    continue;
-                } else if (x(m) > mesh.gridCoordComp(m, GridType::FULL,
-                                                     mesh.endIndex(m, GridType::FULL))) {
-                    indices[m][GridType::FULL] = mesh.numGrid(m, GridType::FULL)-1;
-                    continue;
-                }
-                int i1 = max(indices[m][GridType::HALF]-2, static_cast<int>(mesh.startIndex(m, GridType::HALF)));
-                int i2 = min(indices[m][GridType::HALF]+2, static_cast<int>(mesh.endIndex(m, GridType::HALF)));
-                for (int i = i1; i < i2; ++i) {
-                    if (x(m) >= mesh.gridCoordComp(m, GridType::FULL, i) &&
-                        x(m) <= mesh.gridCoordComp(m, GridType::FULL, i+1)) {
-                        indices[m][GridType::FULL] = i;
-                        break;
-                    }
-                }
-            }
+    for (int m = 0; m < NumDim; ++m) {
+        locateAxis(mesh, m, x(m), indices[m]);
+    }
+} // locate
+
+template <class MeshType, class CoordType>
+void StructuredMeshIndex<MeshType, CoordType>::
+locateAxis(const MeshType &mesh, uword m, double x, int *idx) {
+    const auto &domain = mesh.domain();
+    int leadType, dualType;
+    if (mesh.gridStyle(m) == FULL_LEAD) {
+        leadType = GridType::FULL;
+        dualType = GridType::HALF;
+    } else {
+        leadType = GridType::HALF;
+        dualType = GridType::FULL;
+    }
+    // #########################################################################
+    // Locate the lead grids. Uniform axes are located in O(1) time, so the
+    // previous indices are only used to walk along non-uniform axes.
+    if (idx[leadType] == UNDEFINED_MESH_INDEX || mesh.isAxisUniform(m)) {
+        idx[leadType] = mesh.locateLeadGrid(m, x);
+    } else {
+        int i1 = mesh.startIndex(m, leadType);
+        int i2 = mesh.endIndex(m, leadType);
+        if (domain.axisStartBndType(m) != PERIODIC) {
+            i2 -= 1;
         }
-        // #####################################################################
-        else {
-            if (domain.axisStartBndType(m) == PERIODIC) {
-                int gridType1, gridType2;
-                if (mesh.gridStyle(m) == FULL_LEAD) {
-                    gridType1 = GridType::FULL;
-                    gridType2 = GridType::HALF;
-                } else {
-                    gridType1 = GridType::HALF;
-                    gridType2 = GridType::FULL;
-                }
-                if (x(m) < mesh.gridCoordComp(m, gridType1, indices[m][gridType1])) {
-                    for (int i = indices[m][gridType1]-1;
-                         i >= static_cast<int>(mesh.startIndex(m, gridType1)); --i) {
-                        if (x(m) >= mesh.gridCoordComp(m, gridType1, i) &&
-                            x(m) <= mesh.gridCoordComp(m, gridType1, i+1)) {
-                            indices[m][gridType1] = i;
-                            break;
-                        }
-                    }
-                } else if (x(m) > mesh.gridCoordComp(m, gridType1, indices[m][gridType1]+1)) {
-                    for (int i = indices[m][gridType1]+1;
-                         i <= static_cast<int>(mesh.endIndex(m, gridType1)); ++i) {
-                        if (x(m) >= mesh.gridCoordComp(m, gridType1, i) &&
-                            x(m) <= mesh.gridCoordComp(m, gridType1, i+1)) {
-                            indices[m][gridType1] = i;
-                            break;
-                        }
-                    }
-                }
-                for (int i = indices[m][gridType1]-1; i < indices[m][gridType1]+1; ++i) {
-                    if (x(m) >= mesh.gridCoordComp(m, gridType2, i) &&
-                        x(m) <= mesh.gridCoordComp(m, gridType2, i+1)) {
-                        indices[m][gridType2] = i;
-                        break;
-                    }
-                }
+        int &i = idx[leadType];
+        while (i > i1 && x < mesh.gridCoordComp(m, leadType, i)) --i;
+        while (i < i2 && x > mesh.gridCoordComp(m, leadType, i+1)) ++i;
+    }
+#ifndef NDEBUG
+    assert(idx[leadType] != UNDEFINED_MESH_INDEX);
+#endif
+    // #########################################################################
+    // Locate the dual grids around the lead grid.
+    if (domain.axisStartBndType(m) == PERIODIC) {
+        for (int i = idx[leadType]-1; i < idx[leadType]+1; ++i) {
+            if (x >= mesh.gridCoordComp(m, dualType, i) &&
+                x <= mesh.gridCoordComp(m, dualType, i+1)) {
+                idx[dualType] = i;
+                break;
             }
-            // =================================================================
-            else if (mesh.gridCoordComp(m, GridType::FULL, 0) == domain.axisStart(m)) {
-                if (x(m) < mesh.gridCoordComp(m, GridType::FULL,
-                                              indices[m][GridType::FULL])) {
-                    for (int i = indices[m][GridType::FULL]-1;
-                         i >= static_cast<int>(mesh.startIndex(m, GridType::FULL)); --i) {
-                        if (x(m) >= mesh.gridCoordComp(m, GridType::FULL, i) &&
-                            x(m) <= mesh.gridCoordComp(m, GridType::FULL, i+1)) {
-                            indices[m][GridType::FULL] = i;
-                            break;
-                        }
-                    }
-                } else if (x(m) > mesh.gridCoordComp(m, GridType::FULL,
-                                                     indices[m][GridType::FULL]+1)) {
-                    for (int i = indices[m][GridType::FULL]+1;
-                         i <= static_cast<int>(mesh.endIndex(m, GridType::FULL)); ++i) {
-                        if (x(m) >= mesh.gridCoordComp(m, GridType::FULL, i) &&
-                            x(m) <= mesh.gridCoordComp(m, GridType::FULL, i+1)) {
-                            indices[m][GridType::FULL] = i;
-                            break;
-                        }
-                    }
-                }
-                // TODO: Could we remove the POLE condition?
-                if (domain.axisStartBndType(m) == POLE) {
-                    if (x(m) < mesh.gridCoordComp(m, GridType::HALF,
-                                                  mesh.startIndex(m, GridType::HALF))) {
-                        indices[m][GridType::HALF] = -1;
-                        continue;
-                    } else if (x(m) > mesh.gridCoordComp(m, GridType::HALF,
-                                                         mesh.endIndex(m, GridType::HALF))) {
-                        indices[m][GridType::HALF] = mesh.numGrid(m, GridType::HALF)-1;
-                        continue;
-                    }
-                }
-                int i1 = max(indices[m][GridType::FULL]-2, static_cast<int>(mesh.startIndex(m, GridType::FULL)));
-                int i2 = min(indices[m][GridType::FULL]+2, static_cast<int>(mesh.endIndex(m, GridType::FULL)));
-                for (int i = i1; i < i2; ++i) {
-                    if (x(m) >= mesh.gridCoordComp(m, GridType::HALF, i) &&
-                        x(m) <= mesh.gridCoordComp(m, GridType::HALF, i+1)) {
-                        indices[m][GridType::HALF] = i;
-                        break;
-                    }
-                }
+        }
+    } else {
+        // TODO: Could we remove the POLE condition?
+        if (leadType == GridType::HALF || domain.axisStartBndType(m) == POLE) {
+            if (x < mesh.gridCoordComp(m, dualType, mesh.startIndex(m, dualType))) {
+                idx[dualType] = -1;
+                return;
+            } else if (x > mesh.gridCoordComp(m, dualType, mesh.endIndex(m, dualType))) {
+                idx[dualType] = mesh.numGrid(m, dualType)-1;
+                return;
             }
-            // =================================================================
-            else {
-                if (x(m) < mesh.gridCoordComp(m, GridType::HALF,
-                                              indices[m][GridType::HALF])) {
-                    for (int i = indices[m][GridType::HALF]-1;
-                         i >= static_cast<int>(mesh.startIndex(m, GridType::HALF)); --i) {
-                        if (x(m) >= mesh.gridCoordComp(m, GridType::HALF, i) &&
-                            x(m) <= mesh.gridCoordComp(m, GridType::HALF, i+1)) {
-                            indices[m][GridType::HALF] = i;
-                            break;
-                        }
-                    }
-                } else if (x(m) > mesh.gridCoordComp(m, GridType::HALF,
-                                                     indices[m][GridType::HALF]+1)) {
-                    for (int i = indices[m][GridType::HALF]+1;
-                         i <= static_cast<int>(mesh.endIndex(m, GridType::HALF)); ++i) {
-                        if (x(m) >= mesh.gridCoordComp(m, GridType::HALF, i) &&
-                            x(m) <= mesh.gridCoordComp(m, GridType::HALF, i+1)) {
-                            indices[m][GridType::HALF] = i;
-                            break;
-                        }
-                    }
-                }
-                    if (x(m) < mesh.gridCoordComp(m, GridType::FULL,
-                                                  mesh.startIndex(m, GridType::FULL))) {
-                        indices[m][GridType::FULL] = -1;
-                        continue;
-                    } else if (x(m) > mesh.gridCoordComp(m, GridType::FULL,
-                                                         mesh.endIndex(m, GridType::FULL))) {
-                        indices[m][GridType::FULL] = mesh.numGrid(m, GridType::FULL)-1;
-                        continue;
-                    }
-                int i1 = max(indices[m][GridType::HALF]-2, static_cast<int>(mesh.startIndex(m, GridType::HALF)));
-                int i2 = min(indices[m][GridType::HALF]+2, static_cast<int>(mesh.endIndex(m, GridType::HALF)));
-                for (int i = i1; i < i2; ++i) {
-                    if (x(m) >= mesh.gridCoordComp(m, GridType::FULL, i) &&
-                        x(m) <= mesh.gridCoordComp(m, GridType::FULL, i+1)) {
-                        indices[m][GridType::FULL] = i;
-                        break;
-                    }
-                }
+        }
+        int i1 = max(idx[leadType]-2, static_cast<int>(mesh.startIndex(m, leadType)));
+        int i2 = min(idx[leadType]+2, static_cast<int>(mesh.endIndex(m, leadType)));
+        for (int i = i1; i < i2; ++i) {
+            if (x >= mesh.gridCoordComp(m, dualType, i) &&
+                x <= mesh.gridCoordComp(m, dualType, i+1)) {
+                idx[dualType] = i;
+                break;
             }
         }
+    }
 #ifndef NDEBUG
-        assert(indices[m][GridType::FULL] != UNDEFINED_MESH_INDEX);
-        assert(indices[m][GridType::HALF] != UNDEFINED_MESH_INDEX);
+    assert(idx[GridType::FULL] != UNDEFINED_MESH_INDEX);
+    assert(idx[GridType::HALF] != UNDEFINED_MESH_INDEX);
 #endif
-    }
-} // locate
+} // locateAxis
 
 template <class MeshType, class CoordType>
 uword StructuredMeshIndex<MeshType, CoordType>::
@@ -3,52 +3,79 @@
 
 #include "MeshIndex.h"
 #include "StructuredMesh.h"
+#include "FixedSpaceCoord.h"
 
 namespace geomtk {
 
+/**
+ *  This class describes the index of grid cell on structured mesh. The FULL
+ *  and HALF grid indices along each axis are stored inline, so the index can
+ *  be put on stack or into arrays and copied freely.
+ */
 template <class MeshType, class CoordType>
 class StructuredMeshIndex : public MeshIndex<MeshType, CoordType> {
 public:
     typedef StructuredStagger::GridType GridType;
     typedef StructuredStagger::Location Location;
 protected:
-    int **indices;
+    // NOTE: Index is 3D no matter the dimension size of domain.
+    int indices[3][2];
 public:
     StructuredMeshIndex();
     StructuredMeshIndex(uword numDim);
-    virtual ~StructuredMeshIndex();
 
-    virtual void
+    void
     init(uword numDim);
 
     /**
      *  Reset the indices to undefined status.
      */
-    virtual void
+    void
     reset();
 
-    virtual int
-    operator()(uword axisIdx, int gridType) const;
+    int
+    operator()(uword axisIdx, int gridType) const {
+        return indices[axisIdx][gridType];
+    }
 
-    virtual int&
-    operator()(uword axisIdx, int gridType);
+    int&
+    operator()(uword axisIdx, int gridType) {
+        return indices[axisIdx][gridType];
+    }
 
-    virtual StructuredMeshIndex&
-    operator=(const StructuredMeshIndex &other);
-
-    virtual void
+    void
     locate(const MeshType &mesh, const CoordType &x);
 
-    virtual uword
+    /**
+     *  Locate the lightweight coordinate.
+     */
+    template <int NumDim>
+    void
+    locate(const MeshType &mesh, const FixedSpaceCoord<NumDim> &x);
+
+    /**
+     *  Locate one coordinate component along the given axis. This is shared by
+     *  the single point and batched locating.
+     *
+     *  @param mesh    the structured mesh.
+     *  @param axisIdx the axis index.
+     *  @param x       the coordinate component.
+     *  @param idx     the FULL and HALF indices, which are used as the hint
+     *                 if they are not UNDEFINED_MESH_INDEX.
+     */
+    static void
+    locateAxis(const MeshType &mesh, uword axisIdx, double x, int *idx);
+
+    uword
     cellIndex(const MeshType &mesh, int loc) const;
 
-    virtual bool
+    bool
     isValid() const;
 
-    virtual bool
+    bool
     atBoundary(const MeshType &mesh) const;
 
-    virtual void
+    void
     print() const;
 }; // StructuredMeshIndex
 
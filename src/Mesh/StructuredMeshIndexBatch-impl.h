@@ -0,0 +1,95 @@
+namespace geomtk {
+
+template <class MeshType, class CoordType>
+StructuredMeshIndexBatch<MeshType, CoordType>::
+StructuredMeshIndexBatch() {
+    numDim = 0;
+    _numPoint = 0;
+}
+
+template <class MeshType, class CoordType>
+StructuredMeshIndexBatch<MeshType, CoordType>::
+StructuredMeshIndexBatch(uword numDim, uword numPoint) {
+    init(numDim, numPoint);
+}
+
+template <class MeshType, class CoordType>
+StructuredMeshIndexBatch<MeshType, CoordType>::
+~StructuredMeshIndexBatch() {
+}
+
+template <class MeshType, class CoordType>
+void StructuredMeshIndexBatch<MeshType, CoordType>::
+init(uword numDim, uword numPoint) {
+    this->numDim = numDim;
+    _numPoint = numPoint;
+    // NOTE: Index is 3D no matter the dimension size of domain.
+    indices.resize(3*2*numPoint);
+    reset();
+} // init
+
+template <class MeshType, class CoordType>
+void StructuredMeshIndexBatch<MeshType, CoordType>::
+reset() {
+    for (uword m = 0; m < 3; ++m) {
+        int val = m < numDim ? UNDEFINED_MESH_INDEX : 0;
+        std::fill(memptr(m, GridType::FULL), memptr(m, GridType::FULL)+_numPoint, val);
+        std::fill(memptr(m, GridType::HALF), memptr(m, GridType::HALF)+_numPoint, val);
+    }
+} // reset
+
+template <class MeshType, class CoordType>
+void StructuredMeshIndexBatch<MeshType, CoordType>::
+locate(const MeshType &mesh, const mat &x, bool useHint) {
+    if (x.n_rows != _numPoint || numDim != mesh.domain().numDim()) {
+        init(mesh.domain().numDim(), x.n_rows);
+        useHint = false;
+    }
+#ifndef NDEBUG
+    assert(x.n_cols >= numDim);
+#endif
+    #pragma omp parallel for
+    for (uword p = 0; p < _numPoint; ++p) {
+        locatePoint(mesh, x, p, useHint);
+    }
+} // locate
+
+template <class MeshType, class CoordType>
+void StructuredMeshIndexBatch<MeshType, CoordType>::
+locatePoint(const MeshType &mesh, const mat &x, uword pointIdx, bool useHint) {
+    int idx[2];
+    for (uword m = 0; m < numDim; ++m) {
+        int &fullIdx = (*this)(pointIdx, m, GridType::FULL);
+        int &halfIdx = (*this)(pointIdx, m, GridType::HALF);
+        if (useHint) {
+            idx[GridType::FULL] = fullIdx;
+            idx[GridType::HALF] = halfIdx;
+        } else {
+            idx[GridType::FULL] = UNDEFINED_MESH_INDEX;
+            idx[GridType::HALF] = UNDEFINED_MESH_INDEX;
+        }
+        StructuredMeshIndex<MeshType, CoordType>::locateAxis(mesh, m, x(pointIdx, m), idx);
+        fullIdx = idx[GridType::FULL];
+        halfIdx = idx[GridType::HALF];
+    }
+} // locatePoint
+
+template <class MeshType, class CoordType>
+void StructuredMeshIndexBatch<MeshType, CoordType>::
+get(uword pointIdx, StructuredMeshIndex<MeshType, CoordType> &idx) const {
+    for (uword m = 0; m < numDim; ++m) {
+        idx(m, GridType::FULL) = (*this)(pointIdx, m, GridType::FULL);
+        idx(m, GridType::HALF) = (*this)(pointIdx, m, GridType::HALF);
+    }
+} // get
+
+template <class MeshType, class CoordType>
+void StructuredMeshIndexBatch<MeshType, CoordType>::
+set(uword pointIdx, const StructuredMeshIndex<MeshType, CoordType> &idx) {
+    for (uword m = 0; m < numDim; ++m) {
+        (*this)(pointIdx, m, GridType::FULL) = idx(m, GridType::FULL);
+        (*this)(pointIdx, m, GridType::HALF) = idx(m, GridType::HALF);
+    }
+} // set
+
+} // geomtk
@@ -0,0 +1,115 @@
+#ifndef __GEOMTK_StructuredMeshIndexBatch__
+#define __GEOMTK_StructuredMeshIndexBatch__
+
+#include "StructuredMeshIndex.h"
+
+namespace geomtk {
+
+/**
+ *  This class locates a batch of points on structured mesh in one pass. The
+ *  coordinates are given in structure-of-arrays form (i.e. one column per
+ *  axis), and the FULL and HALF indices of each axis are also stored in
+ *  separated contiguous arrays. The points are processed in parallel when
+ *  OpenMP is enabled.
+ */
+template <class MeshType, class CoordType>
+class StructuredMeshIndexBatch {
+public:
+    typedef StructuredStagger::GridType GridType;
+    typedef StructuredStagger::Location Location;
+protected:
+    uword numDim;
+    uword _numPoint;
+    vector<int> indices;
+public:
+    StructuredMeshIndexBatch();
+    StructuredMeshIndexBatch(uword numDim, uword numPoint);
+    virtual ~StructuredMeshIndexBatch();
+
+    /**
+     *  Allocate the index arrays and reset them.
+     *
+     *  @param numDim   the dimension number.
+     *  @param numPoint the point number.
+     */
+    virtual void
+    init(uword numDim, uword numPoint);
+
+    /**
+     *  Reset the indices to undefined status.
+     */
+    virtual void
+    reset();
+
+    uword
+    numPoint() const {
+        return _numPoint;
+    }
+
+    int
+    operator()(uword pointIdx, uword axisIdx, int gridType) const {
+        return indices[(axisIdx*2+gridType)*_numPoint+pointIdx];
+    }
+
+    int&
+    operator()(uword pointIdx, uword axisIdx, int gridType) {
+        return indices[(axisIdx*2+gridType)*_numPoint+pointIdx];
+    }
+
+    /**
+     *  Get the contiguous index array of the given axis and grid type.
+     *
+     *  @param axisIdx  the axis index.
+     *  @param gridType the grid type (FULL or HALF).
+     *
+     *  @return The pointer to the index array.
+     */
+    const int*
+    memptr(uword axisIdx, int gridType) const {
+        return &indices[(axisIdx*2+gridType)*_numPoint];
+    }
+
+    int*
+    memptr(uword axisIdx, int gridType) {
+        return &indices[(axisIdx*2+gridType)*_numPoint];
+    }
+
+    /**
+     *  Locate the points in the mesh.
+     *
+     *  @param mesh    the structured mesh.
+     *  @param x       the coordinates with one point per row and one axis per
+     *                 column.
+     *  @param useHint the boolean flag of using the current indices (e.g. from
+     *                 the previous time step) as the starting point.
+     */
+    virtual void
+    locate(const MeshType &mesh, const mat &x, bool useHint = false);
+
+    /**
+     *  Copy the indices of one point into a single mesh index.
+     *
+     *  @param pointIdx the point index.
+     *  @param idx      the mesh index.
+     */
+    void
+    get(uword pointIdx, StructuredMeshIndex<MeshType, CoordType> &idx) const;
+
+    /**
+     *  Copy the indices of a single mesh index into one point.
+     *
+     *  @param pointIdx the point index.
+     *  @param idx      the mesh index.
+     */
+    void
+    set(uword pointIdx, const StructuredMeshIndex<MeshType, CoordType> &idx);
+protected:
+    void
+    locatePoint(const MeshType &mesh, const mat &x, uword pointIdx, bool useHint);
+}; // StructuredMeshIndexBatch
+
+} // geomtk
+
+#include "StructuredMeshIndexBatch-impl.h"
+
+#endif // __GEOMTK_StructuredMeshIndexBatch__
@@ -0,0 +1,323 @@
+#ifndef __GEOMTK_StructuredRange__
+#define __GEOMTK_StructuredRange__
+
+#include "StructuredIndexMap.h"
+
+namespace geomtk {
+
+/**
+ *  This struct describes one cell visited by StructuredRange with its span
+ *  indices (halos included) and its storage offset in one time level.
+ */
+struct StructuredCell {
+    int i, j, k;
+    int offset;
+};
+
+/**
+ *  This class describes a box of grids on one stagger location of structured
+ *  mesh, e.g. the interior grids, the grids with halos, one latitude row or
+ *  one vertical column, and iterates over them with the first axis changing
+ *  the fastest. The ranges are usually got from the fields, e.g.
+ *
+ *      double *p = f(timeIdx).memptr();
+ *      for (const StructuredCell &cell : f.cells()) {
+ *          p[cell.offset] = ...;
+ *      }
+ *
+ *  The ranges are split among threads by the loops over the cell indices
+ *  with "operator[]" of the range, e.g.
+ *
+ *      #pragma omp parallel for
+ *      for (int n = 0; n < range.size(); ++n) {
+ *          p[range[n].offset] = ...;
+ *      }
+ *
+ *  The kernels that work on contiguous memory can take the rows along the
+ *  first axis by "rowOffset" and "rowLength" with the strides from "stride".
+ */
+class StructuredRangeIterator;
+
+class StructuredRange {
+protected:
+    int begins[3];
+    int counts[3];
+    int strides[3];
+public:
+    typedef StructuredRangeIterator iterator;
+    typedef StructuredRangeIterator const_iterator;
+
+    StructuredRange() {
+        for (int m = 0; m < 3; ++m) {
+            begins[m] = 0;
+            counts[m] = 0;
+            strides[m] = 0;
+        }
+    }
+
+    /**
+     *  Construct the range of the interior grids or the grids with halos.
+     *
+     *  @param map     the index map of the stagger location.
+     *  @param hasHalo the flag for including halos.
+     *  @param numDim  the dimension of the field, which can be less than the
+     *                 one of the mesh (e.g. 2D field on 3D mesh).
+     */
+    template <int NumDim>
+    StructuredRange(const StructuredIndexMap<NumDim> &map, bool hasHalo = false,
+                    int numDim = 3) {
+        for (int m = 0; m < 3; ++m) {
+            if (m < map.numDim() && m < numDim) {
+                begins[m] = hasHalo ? 0 : map.startIndex(m);
+                counts[m] = map.numGrid(m, hasHalo);
+                strides[m] = map.stride(m);
+            } else {
+                begins[m] = 0;
+                counts[m] = 1;
+                strides[m] = 0;
+            }
+        }
+    }
+
+    /**
+     *  Get the sub-range of one row along the first axis (e.g. latitude row).
+     */
+    StructuredRange
+    row(int j, int k = 0) const {
+        StructuredRange res = *this;
+        res.begins[1] = j; res.counts[1] = 1;
+        res.begins[2] = k; res.counts[2] = 1;
+        return res;
+    }
+
+    /**
+     *  Get the sub-range of one column along the third axis (e.g. vertical
+     *  column).
+     */
+    StructuredRange
+    column(int i, int j) const {
+        StructuredRange res = *this;
+        res.begins[0] = i; res.counts[0] = 1;
+        res.begins[1] = j; res.counts[1] = 1;
+        return res;
+    }
+
+    /**
+     *  Get the sub-range of one level along the third axis.
+     */
+    StructuredRange
+    level(int k) const {
+        StructuredRange res = *this;
+        res.begins[2] = k; res.counts[2] = 1;
+        return res;
+    }
+
+    int
+    size() const {
+        return counts[0]*counts[1]*counts[2];
+    }
+
+    bool
+    empty() const {
+        return size() == 0;
+    }
+
+    int
+    begin(int axisIdx) const {
+        return begins[axisIdx];
+    }
+
+    /**
+     *  Get the end index (exclusive) along the given axis.
+     */
+    int
+    end(int axisIdx) const {
+        return begins[axisIdx]+counts[axisIdx];
+    }
+
+    int
+    count(int axisIdx) const {
+        return counts[axisIdx];
+    }
+
+    int
+    stride(int axisIdx) const {
+        return strides[axisIdx];
+    }
+
+    int
+    offset(int i, int j = 0, int k = 0) const {
+        return i*strides[0]+j*strides[1]+k*strides[2];
+    }
+
+    /**
+     *  Get the n-th cell in the range.
+     */
+    StructuredCell
+    operator[](int n) const {
+        StructuredCell cell;
+        int r = n/counts[0];
+        cell.i = begins[0]+n-r*counts[0];
+        cell.j = begins[1]+r%counts[1];
+        cell.k = begins[2]+r/counts[1];
+        cell.offset = offset(cell.i, cell.j, cell.k);
+        return cell;
+    }
+
+    iterator
+    begin() const;
+
+    iterator
+    end() const;
+
+    /**
+     *  Get the row number along the first axis, which is the unit of the
+     *  contiguous memory accesses.
+     */
+    int
+    numRow() const {
+        return counts[1]*counts[2];
+    }
+
+    int
+    rowLength() const {
+        return counts[0];
+    }
+
+    /**
+     *  Get the storage offset of the first cell of the r-th row.
+     */
+    int
+    rowOffset(int r) const {
+        return offset(begins[0], begins[1]+r%counts[1], begins[2]+r/counts[1]);
+    }
+}; // StructuredRange
+
+/**
+ *  This class iterates over StructuredRange. The cells are computed on the
+ *  fly, so they are returned by value (i.e. "reference" is StructuredCell)
+ *  and there is no "operator->". Since the standard forward (and stronger)
+ *  iterators must return real references, it is only tagged as an input
+ *  iterator, although the jumps and distances are supported. The range is
+ *  copied into the iterator, so the iterator stays valid after the range is
+ *  destroyed.
+ */
+class StructuredRangeIterator {
+public:
+    typedef std::input_iterator_tag iterator_category;
+    typedef StructuredCell value_type;
+    typedef int difference_type;
+    typedef void pointer;
+    typedef StructuredCell reference;
+protected:
+    StructuredRange range;
+    int n;
+    // the current cell, which is advanced incrementally by "++"
+    StructuredCell cell;
+public:
+    StructuredRangeIterator() : n(0) {}
+
+    StructuredRangeIterator(const StructuredRange &range, int n)
+        : range(range), n(n) {
+        if (n < range.size()) cell = range[n];
+    }
+
+    reference
+    operator*() const {
+        return cell;
+    }
+
+    reference
+    operator[](difference_type m) const {
+        return range[n+m];
+    }
+
+    StructuredRangeIterator&
+    operator++() {
+        ++n;
+        cell.offset += range.stride(0);
+        if (++cell.i == range.end(0)) {
+            cell.i = range.begin(0);
+            if (++cell.j == range.end(1)) {
+                cell.j = range.begin(1);
+                ++cell.k;
+            }
+            cell.offset = range.offset(cell.i, cell.j, cell.k);
+        }
+        return *this;
+    }
+
+    StructuredRangeIterator
+    operator++(int) {
+        StructuredRangeIterator res = *this;
+        ++(*this);
+        return res;
+    }
+
+    StructuredRangeIterator&
+    operator--() {
+        return *this -= 1;
+    }
+
+    StructuredRangeIterator
+    operator--(int) {
+        StructuredRangeIterator res = *this;
+        *this -= 1;
+        return res;
+    }
+
+    StructuredRangeIterator&
+    operator+=(difference_type m) {
+        n += m;
+        if (n < range.size()) cell = range[n];
+        return *this;
+    }
+
+    StructuredRangeIterator&
+    operator-=(difference_type m) {
+        return *this += -m;
+    }
+
+    StructuredRangeIterator
+    operator+(difference_type m) const {
+        StructuredRangeIterator res = *this;
+        return res += m;
+    }
+
+    friend StructuredRangeIterator
+    operator+(difference_type m, const StructuredRangeIterator &it) {
+        return it+m;
+    }
+
+    StructuredRangeIterator
+    operator-(difference_type m) const {
+        StructuredRangeIterator res = *this;
+        return res -= m;
+    }
+
+    difference_type
+    operator-(const StructuredRangeIterator &other) const {
+        return n-other.n;
+    }
+
+    bool operator==(const StructuredRangeIterator &other) const { return n == other.n; }
+    bool operator!=(const StructuredRangeIterator &other) const { return n != other.n; }
+    bool operator<(const StructuredRangeIterator &other) const { return n < other.n; }
+    bool operator>(const StructuredRangeIterator &other) const { return n > other.n; }
+    bool operator<=(const StructuredRangeIterator &other) const { return n <= other.n; }
+    bool operator>=(const StructuredRangeIterator &other) const { return n >= other.n; }
+}; // StructuredRangeIterator
+
+inline StructuredRange::iterator
+StructuredRange::begin() const {
+    return iterator(*this, 0);
+}
+
+inline StructuredRange::iterator
+StructuredRange::end() const {
+    return iterator(*this, size());
+}
+
+} // geomtk
+
+#endif // __GEOMTK_StructuredRange__
@@ -69,4 +69,28 @@ TEST_F(OpenCartesianMeshIndexTest, Locate) {
     ASSERT_EQ(9, idx(2, HALF));
 }
 
+TEST_F(OpenCartesianMeshIndexTest, LocateBatch) {
+    const double xs[] = { 0.0, 1.0, 0.05, 0.95, 0.3, 0.5, 0.71 };
+    const int n = sizeof(xs)/sizeof(double);
+    mat x(n, 3);
+    for (int l = 0; l < n; ++l) {
+        x(l, 0) = xs[l];
+        x(l, 1) = xs[(l+1)%n];
+        x(l, 2) = xs[(l+2)%n];
+    }
+    CartesianMeshIndexBatch b;
+    CartesianMeshIndex a(3);
+    b.locate(*mesh, x);
+    for (int l = 0; l < n; ++l) {
+        SpaceCoord y(3);
+        y.set(x(l, 0), x(l, 1), x(l, 2));
+        a.reset();
+        a.locate(*mesh, y);
+        for (int m = 0; m < 3; ++m) {
+            ASSERT_EQ(a(m, FULL), b(l, m, FULL));
+            ASSERT_EQ(a(m, HALF), b(l, m, HALF));
+        }
+    }
+}
+
 #endif // __GEOMTK_OpenCartesianMeshIndex_test__
\ No newline at end of file
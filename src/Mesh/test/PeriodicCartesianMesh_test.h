@@ -169,4 +169,40 @@ TEST_F(PeriodicCartesianMeshTest, Move) {
     ASSERT_GT(1.0e-15, fabs(x1(2)-0.0));
 }
 
+TEST_F(PeriodicCartesianMeshTest, LocateBatch) {
+    // The points include the periodic boundaries, the grids and the gap
+    // between the last grid and the axis end.
+    const double xs[] = { 0.0, 1.0, 0.95, 0.999999, 0.3, 0.05, 0.5, 0.71 };
+    const int n = sizeof(xs)/sizeof(double);
+    mat x(n*n, 3);
+    for (int l0 = 0; l0 < n; ++l0) {
+        for (int l1 = 0; l1 < n; ++l1) {
+            x(l0*n+l1, 0) = xs[l0];
+            x(l0*n+l1, 1) = xs[l1];
+            x(l0*n+l1, 2) = xs[(l0+l1)%n];
+        }
+    }
+    CartesianMeshIndexBatch b;
+    CartesianMeshIndex a(3), c(3);
+    b.locate(*mesh, x);
+    ASSERT_EQ(n*n, b.numPoint());
+    for (int p = 0; p < 2; ++p) {
+        for (uword l = 0; l < x.n_rows; ++l) {
+            SpaceCoord y(3);
+            y.set(x(l, 0), x(l, 1), x(l, 2));
+            a.reset();
+            a.locate(*mesh, y);
+            b.get(l, c);
+            for (int m = 0; m < 3; ++m) {
+                ASSERT_EQ(a(m, FULL), b(l, m, FULL));
+                ASSERT_EQ(a(m, HALF), b(l, m, HALF));
+                ASSERT_EQ(a(m, FULL), c(m, FULL));
+                ASSERT_EQ(a(m, HALF), c(m, HALF));
+            }
+        }
+        // Locate again by using the previous indices as hints.
+        b.locate(*mesh, x, true);
+    }
+}
+
 #endif // __GEOMTK_PeriodicCartesainMesh_test__
\ No newline at end of file
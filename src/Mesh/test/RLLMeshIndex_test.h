@@ -2,6 +2,7 @@
 #define __GEOMTK_RLLMeshIndex_test__
 
 #include "RLLMeshIndex.h"
+#include "RLLMeshIndexBatch.h"
 
 using namespace geomtk;
 
@@ -36,6 +37,7 @@ TEST_F(RLLMeshIndexTest, Basic) {
 
     a.setMoveOnPole(true);
     ASSERT_EQ(true, a.isMoveOnPole());
+    ASSERT_TRUE(std::is_trivially_copyable<RLLMeshIndex>::value);
 }
 
 TEST_F(RLLMeshIndexTest, AssignmentOperator) {
@@ -116,6 +118,60 @@ TEST_F(RLLMeshIndexTest, Locate) {
     ASSERT_TRUE(a.isOnPole());
 }
 
+TEST_F(RLLMeshIndexTest, LocateUniformAxes) {
+    SphereCoord x(domain->numDim());
+    RLLMeshIndex a(domain->numDim());
+
+    ASSERT_TRUE(mesh->isAxisUniform(0));
+    ASSERT_TRUE(mesh->isAxisUniform(1));
+    for (int l = 0; l < 100; ++l) {
+        x(0) = 2*M_PI*l/100;
+        x(1) = (l/100.0-0.5)*M_PI;
+        a.reset();
+        a.locate(*mesh, x);
+        int i = a(0, FULL), j = a(1, FULL);
+        ASSERT_LE(mesh->gridCoordComp(0, FULL, i), x(0));
+        ASSERT_GE(mesh->gridCoordComp(0, FULL, i+1), x(0));
+        ASSERT_LE(mesh->gridCoordComp(1, FULL, j), x(1));
+        ASSERT_GE(mesh->gridCoordComp(1, FULL, j+1), x(1));
+    }
+}
+
+TEST_F(RLLMeshIndexTest, LocateBatch) {
+    const int n = 50;
+    mat x(n, 2);
+    RLLMeshIndexBatch b;
+    RLLMeshIndex a(domain->numDim()), c(domain->numDim());
+
+    for (int l = 0; l < n; ++l) {
+        x(l, 0) = 2*M_PI*(l+0.5)/n;
+        x(l, 1) = ((l+0.5)/n-0.5)*M_PI;
+    }
+    b.locate(*mesh, x);
+    ASSERT_EQ(n, b.numPoint());
+    for (int p = 0; p < 2; ++p) {
+        for (int l = 0; l < n; ++l) {
+            SphereCoord y(domain->numDim());
+            y(0) = x(l, 0);
+            y(1) = x(l, 1);
+            a.reset();
+            a.locate(*mesh, y);
+            b.get(l, c);
+            for (int m = 0; m < 2; ++m) {
+                ASSERT_EQ(a(m, FULL), b(l, m, FULL));
+                ASSERT_EQ(a(m, HALF), b(l, m, HALF));
+                ASSERT_EQ(a(m, FULL), c(m, FULL));
+            }
+            ASSERT_EQ(a.pole(), b.pole(l));
+            ASSERT_EQ(a.isInPolarCap(), b.isInPolarCap(l));
+            ASSERT_EQ(a.isOnPole(), b.isOnPole(l));
+            ASSERT_EQ(a.isOnPole(), c.isOnPole());
+        }
+        // Locate again by using the previous indices as hints.
+        b.locate(*mesh, x, true);
+    }
+}
+
 TEST_F(RLLMeshIndexTest, GetCellIndex) {
     RLLMeshIndex a(domain->numDim());
     int l = 0;
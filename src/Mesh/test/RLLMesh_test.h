@@ -2,6 +2,7 @@
 #define __GEOMTK_RLLMesh_test__
 
 #include "geomtk.h"
+#include "gen_test_data.h"
 
 using namespace geomtk;
 
@@ -148,9 +149,40 @@ TEST_F(RLLMeshTest, IndexWrapping) {
     }
 }
 
+TEST_F(RLLMeshTest, IndexMap) {
+    uword I, J, K;
+    int i, j, k;
+    for (int loc = 0; loc < 5; ++loc) {
+        StructuredIndexMap<3> map(mesh->indexMap(loc));
+        ASSERT_EQ(3, map.numDim());
+        ASSERT_EQ(loc, map.staggerLocation());
+        ASSERT_EQ(static_cast<int>(mesh->totalNumGrid(loc, 3)), map.numCell());
+        int gtx = mesh->gridType(0, loc);
+        int gty = mesh->gridType(1, loc);
+        int nx = mesh->numGrid(0, gtx, true);
+        int ny = mesh->numGrid(1, gty, true);
+        for (int l = 0; l < map.numCell(); ++l) {
+            map.unwrap(l, i, j, k);
+            mesh->unwrapIndex(loc, l, I, J, K);
+            ASSERT_EQ(static_cast<int>(I), i);
+            ASSERT_EQ(static_cast<int>(J), j);
+            ASSERT_EQ(static_cast<int>(K), k);
+            ASSERT_EQ(l, map.wrap(i, j, k));
+            ASSERT_EQ(i+nx*(j+ny*k), map.cellOffset(l));
+            ASSERT_EQ(&mesh->gridCoord(loc, l), &mesh->gridCoord(loc, i, j, k));
+        }
+        // The periodic halos are wrapped into the interior.
+        ASSERT_EQ(map.wrap(mesh->ie(gtx), 0, 0), map.wrap(mesh->is(gtx)-1, 0, 0));
+        ASSERT_EQ(map.wrap(mesh->is(gtx), 0, 0), map.wrap(mesh->ie(gtx)+1, 0, 0));
+    }
+}
+
 TEST_F(RLLMeshTest, GridCoords) {
     uword I, J, K;
     for (int loc = 0; loc < 5; ++loc) {
+        // Grid coordinates are built when they are firstly requested.
+        ASSERT_EQ(0, mesh->gridCoords[loc].size());
+        mesh->gridCoord(loc, 0);
         ASSERT_EQ(mesh->totalNumGrid(loc, domain->numDim()),
                   mesh->gridCoords[loc].size());
         for (uword i = 0; i < mesh->totalNumGrid(loc, 3); ++i) {
@@ -175,6 +207,12 @@ TEST_F(RLLMeshTest, GridCoords) {
             ASSERT_EQ(cos(x(0)), x.cosLon());
             ASSERT_EQ(sin(x(1)), x.sinLat());
             ASSERT_EQ(cos(x(1)), x.cosLat());
+            FixedSphereCoord<3> y;
+            mesh->calcGridCoord(loc, I, J, K, y);
+            ASSERT_EQ(x(0), y(0));
+            ASSERT_EQ(x(1), y(1));
+            ASSERT_EQ(x(2), y(2));
+            ASSERT_EQ(x.sinLat(), y.sinLat());
         }
     }
 }
@@ -253,4 +291,77 @@ TEST_F(RLLMeshTest, CellVolume) {
     ASSERT_GT(1.0e-13, fabs(4*M_PI*domain->radius()*domain->radius()-totalVolume));
 }
 
+TEST_F(RLLMeshTest, Cache) {
+    const string cachePath = "RLLMesh_test.cache";
+    mesh->saveCache(cachePath, 1);
+    RLLMesh other(*domain);
+    ASSERT_FALSE(other.loadCache(cachePath, 2));
+    ASSERT_FALSE(other.isSet());
+    ASSERT_TRUE(other.loadCache(cachePath, 1));
+    ASSERT_TRUE(other.isSet());
+    for (int m = 0; m < 3; ++m) {
+        ASSERT_EQ(mesh->numGrid(m, FULL, true), other.numGrid(m, FULL, true));
+        ASSERT_EQ(mesh->numGrid(m, HALF, true), other.numGrid(m, HALF, true));
+        ASSERT_EQ(mesh->isAxisUniform(m), other.isAxisUniform(m));
+        ASSERT_EQ(mesh->gridStyle(m), other.gridStyle(m));
+        for (uword i = 0; i < mesh->numGrid(m, HALF, true); ++i) {
+            ASSERT_EQ(mesh->gridCoordComp(m, HALF, i), other.gridCoordComp(m, HALF, i));
+        }
+        for (uword i = 0; i < mesh->numGrid(m, HALF, true)-1; ++i) {
+            ASSERT_EQ(mesh->gridInterval(m, HALF, i), other.gridInterval(m, HALF, i));
+        }
+    }
+    for (auto j = mesh->js(HALF); j <= mesh->je(HALF); ++j) {
+        ASSERT_EQ(mesh->cosLat(HALF, j), other.cosLat(HALF, j));
+        ASSERT_EQ(mesh->tanLat(HALF, j), other.tanLat(HALF, j));
+    }
+    for (uword i = 0; i < mesh->totalNumGrid(CENTER, 3); ++i) {
+        ASSERT_EQ(mesh->cellVolume(i), other.cellVolume(i));
+    }
+    ASSERT_EQ(mesh->gridCoord(XY_VERTEX, 7).cosLon(), other.gridCoord(XY_VERTEX, 7).cosLon());
+    remove(cachePath.c_str());
+}
+
+TEST_F(RLLMeshTest, InitWithCache) {
+    const string cachePath = "RLLMesh_test.cache";
+    const string filePath = "RLLMesh_test.nc";
+    gen_3d_grid_data(filePath);
+    SphereDomain domain1(CLASSIC_PRESSURE_SIGMA), domain2(CLASSIC_PRESSURE_SIGMA);
+    RLLMesh mesh1(domain1), mesh2(domain2);
+    uint64_t key = mesh1.cacheKey({filePath});
+    ASSERT_EQ(key, mesh2.cacheKey({filePath}));
+    // the first call reads the grid file and writes the cache
+    mesh1.initWithCache(cachePath, filePath);
+    MeshCache cache;
+    ASSERT_TRUE(cache.open(cachePath, key));
+    // the second call loads the cache and reads the vertical coordinate only
+    mesh2.initWithCache(cachePath, filePath);
+    ASSERT_TRUE(mesh2.isSet());
+    for (int m = 0; m < 3; ++m) {
+        ASSERT_EQ(mesh1.numGrid(m, FULL, true), mesh2.numGrid(m, FULL, true));
+        ASSERT_EQ(mesh1.numGrid(m, HALF, true), mesh2.numGrid(m, HALF, true));
+        for (uword i = 0; i < mesh1.numGrid(m, HALF, true); ++i) {
+            ASSERT_EQ(mesh1.gridCoordComp(m, HALF, i), mesh2.gridCoordComp(m, HALF, i));
+        }
+        for (uword i = 0; i < mesh1.numGrid(m, FULL, true); ++i) {
+            ASSERT_EQ(mesh1.gridCoordComp(m, FULL, i), mesh2.gridCoordComp(m, FULL, i));
+        }
+    }
+    ASSERT_EQ(5u, mesh2.numGrid(2, FULL));
+    const auto &vertCoord1 = dynamic_cast<const ClassicPressureSigma&>(domain1.vertCoord());
+    const auto &vertCoord2 = dynamic_cast<const ClassicPressureSigma&>(domain2.vertCoord());
+    ASSERT_EQ(vertCoord1.pt, vertCoord2.pt);
+    for (int l = 0; l < 2; ++l) {
+        ASSERT_EQ(vertCoord1.sigma[l].size(), vertCoord2.sigma[l].size());
+        for (uword k = 0; k < vertCoord1.sigma[l].size(); ++k) {
+            ASSERT_EQ(vertCoord1.sigma[l][k], vertCoord2.sigma[l][k]);
+        }
+    }
+    // the key follows the content of the grid file
+    gen_3d_grid_data(filePath, 6);
+    ASSERT_NE(key, mesh1.cacheKey({filePath}));
+    remove(filePath.c_str());
+    remove(cachePath.c_str());
+}
+
 #endif // __GEOMTK_RLLMesh_test__
@@ -0,0 +1,197 @@
+#ifndef __GEOMTK_StructuredDecomp_test__
+#define __GEOMTK_StructuredDecomp_test__
+
+#include "geomtk.h"
+
+using namespace geomtk;
+
+class StructuredDecompTest : public ::testing::Test {
+protected:
+    const int FULL = RLLStagger::GridType::FULL;
+    const int HALF = RLLStagger::GridType::HALF;
+    const int CENTER = RLLStagger::Location::CENTER;
+    const int X_FACE = RLLStagger::Location::X_FACE;
+    const int Y_FACE = RLLStagger::Location::Y_FACE;
+
+    SphereDomain *domain;
+    RLLMesh *mesh;
+
+    virtual void SetUp() {
+        domain = new SphereDomain(2);
+        mesh = new RLLMesh(*domain);
+        mesh->init(20, 11);
+    }
+
+    virtual void TearDown() {
+        delete mesh;
+        delete domain;
+    }
+};
+
+TEST_F(StructuredDecompTest, Blocks) {
+    const int numProcX = 4, numProcY = 3;
+    int locs[3] = {CENTER, X_FACE, Y_FACE};
+    for (int l = 0; l < 3; ++l) {
+        int gridTypeX = mesh->gridType(0, locs[l]);
+        int gridTypeY = mesh->gridType(1, locs[l]);
+        int nx = mesh->numGrid(0, gridTypeX);
+        vector<int> numOwner(mesh->totalNumGrid(locs[l], 2), 0);
+        for (int rank = 0; rank < numProcX*numProcY; ++rank) {
+            StructuredDecomp<RLLMesh> decomp;
+            decomp.init(*mesh, numProcX, numProcY, 1, rank);
+            ASSERT_EQ(rank%numProcX, decomp.procIdx(0));
+            ASSERT_EQ(rank/numProcX, decomp.procIdx(1));
+            for (int j = decomp.startIndex(1, gridTypeY); j <= decomp.endIndex(1, gridTypeY); ++j) {
+                for (int i = decomp.startIndex(0, gridTypeX); i <= decomp.endIndex(0, gridTypeX); ++i) {
+                    numOwner[(j-mesh->js(gridTypeY))*nx+i-mesh->is(gridTypeX)]++;
+                }
+            }
+        }
+        // Every grid is owned by exactly one block.
+        for (uword i = 0; i < numOwner.size(); ++i) {
+            ASSERT_EQ(1, numOwner[i]);
+        }
+    }
+    StructuredDecomp<RLLMesh> decomp;
+    decomp.init(*mesh, numProcX, numProcY, 1, 0);
+    int west[3] = {-1, 0, 0}, south[3] = {0, -1, 0}, north[3] = {0, 1, 0};
+    ASSERT_EQ(numProcX-1, decomp.neighborRank(west));
+    ASSERT_EQ(-1, decomp.neighborRank(south));
+    ASSERT_EQ(numProcX, decomp.neighborRank(north));
+    ASSERT_TRUE(decomp.isAtAxisStart(1));
+    ASSERT_FALSE(decomp.isAtAxisEnd(1));
+    ASSERT_EQ(mesh->haloWidth(), decomp.localHaloWidth(0));
+    ASSERT_EQ(mesh->haloWidth(), decomp.localHaloWidth(1));
+    ASSERT_EQ(decomp.numGrid(0, FULL)+2*mesh->haloWidth(), decomp.numGrid(0, FULL, true));
+}
+
+TEST_F(StructuredDecompTest, HaloExchange) {
+    // This test can be run with several ranks, which are placed along x axis.
+    int numRank = 1;
+#ifdef GEOMTK_USE_MPI
+    MPI_Comm_size(MPI_COMM_WORLD, &numRank);
+#endif
+    RLLField<double> f1, f2;
+    f1.create("f1", "", "", *mesh, CENTER, 2);
+    f2.create("f2", "", "", *mesh, X_FACE, 2);
+    for (int j = mesh->js(FULL); j <= mesh->je(FULL); ++j) {
+        for (int i = mesh->is(FULL); i <= mesh->ie(FULL); ++i) {
+            f1(i, j) = i+100*j;
+        }
+        for (int i = mesh->is(HALF); i <= mesh->ie(HALF); ++i) {
+            f2(i, j) = -i-100*j;
+        }
+    }
+    // The global fields are the references, so they are wrapped before the
+    // mesh is decomposed.
+    f1.applyBndCond();
+    f2.applyBndCond();
+    StructuredDecomp<RLLMesh> decomp;
+    decomp.init(*mesh, numRank, 1);
+    ASSERT_EQ(numRank > 1, mesh->isDecomposed());
+    AlignedArray<double> a1, a2;
+    decomp.allocate(CENTER, a1);
+    decomp.allocate(X_FACE, a2);
+    ASSERT_EQ(decomp.numGrid(0, FULL, true), a1.n_rows);
+    ASSERT_EQ(mesh->numGrid(1, FULL), a1.n_cols);
+    for (int j = decomp.startIndex(1, FULL); j <= decomp.endIndex(1, FULL); ++j) {
+        for (int i = decomp.startIndex(0, FULL); i <= decomp.endIndex(0, FULL); ++i) {
+            a1(decomp.localIndex(0, FULL, i), decomp.localIndex(1, FULL, j)) = f1(i, j);
+        }
+        for (int i = decomp.startIndex(0, HALF); i <= decomp.endIndex(0, HALF); ++i) {
+            a2(decomp.localIndex(0, HALF, i), decomp.localIndex(1, FULL, j)) = f2(i, j);
+        }
+    }
+    StructuredHaloExchange<RLLMesh> exchange;
+    exchange.init(decomp);
+    exchange.addField(CENTER, a1);
+    exchange.addField(X_FACE, a2);
+    ASSERT_EQ(2, exchange.numField());
+    exchange.start();
+    exchange.finish();
+    // The halos should be the same as the ones of the global fields.
+    int hw = mesh->haloWidth();
+    for (uword j = 0; j < a1.n_cols; ++j) {
+        for (uword i = 0; i < a1.n_rows; ++i) {
+            ASSERT_EQ(f1(decomp.startIndex(0, FULL)-hw+i, j), a1(i, j));
+        }
+        for (uword i = 0; i < a2.n_rows; ++i) {
+            ASSERT_EQ(f2(decomp.startIndex(0, HALF)-hw+i, j), a2(i, j));
+        }
+    }
+    vector<double> ring;
+    decomp.gatherRow(CENTER, a1, mesh->je(FULL), 0, ring);
+    ASSERT_EQ(mesh->numGrid(0, FULL), ring.size());
+    for (int i = mesh->is(FULL); i <= mesh->ie(FULL); ++i) {
+        ASSERT_EQ(f1(i, mesh->je(FULL)), ring[i-mesh->is(FULL)]);
+    }
+}
+
+TEST_F(StructuredDecompTest, HaloExchangeY) {
+    // This test can be run with several ranks, which are placed along y axis,
+    // so the first and last blocks contain the pole rows.
+    int numRank = 1;
+#ifdef GEOMTK_USE_MPI
+    MPI_Comm_size(MPI_COMM_WORLD, &numRank);
+#endif
+    RLLField<double> f1, f2;
+    f1.create("f1", "", "", *mesh, CENTER, 2);
+    f2.create("f2", "", "", *mesh, Y_FACE, 2);
+    for (int j = mesh->js(FULL); j <= mesh->je(FULL); ++j) {
+        for (int i = mesh->is(FULL); i <= mesh->ie(FULL); ++i) {
+            f1(i, j) = i+100*j;
+        }
+    }
+    for (int j = mesh->js(HALF); j <= mesh->je(HALF); ++j) {
+        for (int i = mesh->is(FULL); i <= mesh->ie(FULL); ++i) {
+            f2(i, j) = -i-100*j;
+        }
+    }
+    f1.applyBndCond();
+    f2.applyBndCond();
+    StructuredDecomp<RLLMesh> decomp;
+    decomp.init(*mesh, 1, numRank);
+    ASSERT_EQ(numRank > 1, mesh->isDecomposed());
+    ASSERT_EQ(numRank > 1 ? mesh->haloWidth() : 0, decomp.localHaloWidth(1));
+    RLLField<double> *fs[2] = {&f1, &f2};
+    int locs[2] = {CENTER, Y_FACE};
+    AlignedArray<double> as[2];
+    StructuredHaloExchange<RLLMesh> exchange;
+    exchange.init(decomp);
+    for (int l = 0; l < 2; ++l) {
+        int gtx = mesh->gridType(0, locs[l]), gty = mesh->gridType(1, locs[l]);
+        decomp.allocate(locs[l], as[l]);
+        as[l].fill(-999);
+        for (int j = decomp.startIndex(1, gty); j <= decomp.endIndex(1, gty); ++j) {
+            for (int i = decomp.startIndex(0, gtx); i <= decomp.endIndex(0, gtx); ++i) {
+                as[l](decomp.localIndex(0, gtx, i), decomp.localIndex(1, gty, j)) = (*fs[l])(i, j);
+            }
+        }
+        exchange.addField(locs[l], as[l]);
+    }
+    exchange.run();
+    for (int l = 0; l < 2; ++l) {
+        int gtx = mesh->gridType(0, locs[l]), gty = mesh->gridType(1, locs[l]);
+        for (uword j = 0; j < as[l].n_cols; ++j) {
+            int J = decomp.startIndex(1, gty)-decomp.localHaloWidth(1)+j;
+            for (uword i = 0; i < as[l].n_rows; ++i) {
+                int I = decomp.startIndex(0, gtx)-decomp.localHaloWidth(0)+i;
+                if (J < static_cast<int>(mesh->js(gty)) || J > static_cast<int>(mesh->je(gty))) {
+                    // The halos beyond the poles are not touched.
+                    ASSERT_EQ(-999, as[l](i, j));
+                } else {
+                    ASSERT_EQ((*fs[l])(I, J), as[l](i, j));
+                }
+            }
+        }
+    }
+    if (decomp.isAtAxisEnd(1)) {
+        vector<double> ring;
+        decomp.gatherRow(CENTER, as[0], mesh->je(FULL), 0, ring);
+        for (int i = mesh->is(FULL); i <= mesh->ie(FULL); ++i) {
+            ASSERT_EQ(f1(i, mesh->je(FULL)), ring[i-mesh->is(FULL)]);
+        }
+    }
+}
+
+#endif // __GEOMTK_StructuredDecomp_test__
@@ -23,4 +23,16 @@ run(RegridMethod method, const TimeLevelIndex<2> &timeIdx,
     }
 }
 
+void CartesianRegrid::
+initPlan(RegridMethod method, int loc, const vector<SpaceCoord> &x,
+         RegridPlan &plan) const {
+    plan.init(loc, storageSize(loc), x.size());
+    CartesianMeshIndex idx(mesh().domain().numDim());
+    for (uword p = 0; p < x.size(); ++p) {
+        idx.reset();
+        idx.locate(mesh(), x[p]);
+        addLagrangeStencil(method, loc, x[p], idx, plan);
+    }
+} // initPlan
+
 } // geomtk
\ No newline at end of file
@@ -25,6 +25,18 @@ public:
     void run(RegridMethod method, const TimeLevelIndex<2> &timeIdx,
              const CartesianVelocityField &f, const SpaceCoord &x,
              Velocity &v, CartesianMeshIndex *idx = NULL);
+
+    /**
+     *  Precompute the regridding weights from the fields on the given stagger
+     *  location to the fixed target points.
+     *
+     *  @param method the regrid method.
+     *  @param loc    the stagger location of the source fields.
+     *  @param x      the target coordinates.
+     *  @param plan   the output regrid plan.
+     */
+    void initPlan(RegridMethod method, int loc, const vector<SpaceCoord> &x,
+                  RegridPlan &plan) const;
 };
 
 template <typename T, int N>
@@ -32,12 +44,11 @@ void CartesianRegrid::
 run(RegridMethod method, const TimeLevelIndex<N> &timeIdx,
     const CartesianField<T, N> &f, const SpaceCoord &x,
     T &y, CartesianMeshIndex *_idx) {
-    CartesianMeshIndex *idx;
-    if (_idx == NULL) {
-        idx = new CartesianMeshIndex(mesh().domain().numDim());
-        idx->locate(mesh(), x);
-    } else {
-        idx = _idx;
+    CartesianMeshIndex localIdx(mesh().domain().numDim());
+    CartesianMeshIndex *idx = _idx;
+    if (idx == NULL) {
+        localIdx.locate(mesh(), x);
+        idx = &localIdx;
     }
     if (method == LINEAR || method == QUADRATIC || method == CUBIC) {
         int n = 0;
@@ -112,9 +123,6 @@ run(RegridMethod method, const TimeLevelIndex<N> &timeIdx,
     } else {
         REPORT_ERROR("Under construction!");
     }
-    if (_idx == NULL) {
-        delete idx;
-    }
 } // run
 
 } // geomtk
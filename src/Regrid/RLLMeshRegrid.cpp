@@ -0,0 +1,198 @@
+#include "RLLMeshRegrid.h"
+
+namespace geomtk {
+
+RLLMeshRegrid::
+RLLMeshRegrid() {
+    srcMesh = NULL;
+    dstMesh = NULL;
+    method = LINEAR;
+    loc = Location::CENTER;
+}
+
+RLLMeshRegrid::
+~RLLMeshRegrid() {
+}
+
+void RLLMeshRegrid::
+init(RegridMethod method, int loc, const RLLMesh &srcMesh,
+     const RLLMesh &dstMesh) {
+    if (srcMesh.domain().numDim() != dstMesh.domain().numDim()) {
+        REPORT_ERROR("Source and target meshes have different dimensions!");
+    }
+    this->method = method;
+    this->loc = loc;
+    this->srcMesh = &srcMesh;
+    this->dstMesh = &dstMesh;
+    const SphereDomain &domain = srcMesh.domain();
+    for (int m = 0; m < 3; ++m) {
+        if (m < static_cast<int>(domain.numDim())) {
+            int srcGridType = srcMesh.gridType(m, loc);
+            int dstGridType = dstMesh.gridType(m, loc);
+            numSrcGrid[m] = srcMesh.numGrid(m, srcGridType);
+            numDstGrid[m] = dstMesh.numGrid(m, dstGridType);
+            srcStartIndex[m] = srcMesh.startIndex(m, srcGridType);
+            dstStartIndex[m] = dstMesh.startIndex(m, dstGridType);
+            if (method == CONSERVATIVE) continue;
+            setAxisTable(method, srcMesh.gridCoordComps(m, srcGridType),
+                         dstMesh.gridCoordComps(m, dstGridType),
+                         domain.axisStartBndType(m) == PERIODIC,
+                         domain.axisSpan(m), tables[m]);
+        } else {
+            numSrcGrid[m] = 1;
+            numDstGrid[m] = 1;
+            srcStartIndex[m] = 0;
+            dstStartIndex[m] = 0;
+            tables[m].n = 1;
+            tables[m].indices.assign(1, 0);
+            tables[m].weights.assign(1, 1.0);
+        }
+    }
+    const double eps = 1.0e-12;
+    vec lat = srcMesh.gridCoordComps(1, srcMesh.gridType(1, loc));
+    isSrcPoleRow.resize(lat.size());
+    for (uword j = 0; j < lat.size(); ++j) {
+        isSrcPoleRow[j] = fabs(fabs(lat[j])-M_PI_2) < eps;
+    }
+    lat = dstMesh.gridCoordComps(1, dstMesh.gridType(1, loc));
+    isDstPoleRow.resize(lat.size());
+    for (uword j = 0; j < lat.size(); ++j) {
+        isDstPoleRow[j] = fabs(fabs(lat[j])-M_PI_2) < eps;
+    }
+    if (method == CONSERVATIVE) {
+        if (loc != Location::CENTER) {
+            REPORT_ERROR("Conservative remapping only supports CENTER location!");
+        }
+        if (numSrcGrid[2] != numDstGrid[2]) {
+            REPORT_ERROR("Conservative remapping requires the same levels!");
+        }
+        setConservativePlan();
+    }
+} // init
+
+void RLLMeshRegrid::
+setAxisTable(RegridMethod method, const vec &src, const vec &dst,
+             bool isPeriodic, double period, AxisTable &table) {
+    int n = 0;
+    if (method == LINEAR) {
+        n = 2;
+    } else if (method == QUADRATIC) {
+        n = 3;
+    } else if (method == CUBIC) {
+        n = 4;
+    } else {
+        REPORT_ERROR("Under construction!");
+    }
+    int numSrc = src.size();
+    if (!isPeriodic && n > numSrc) n = numSrc;
+    table.n = n;
+    table.indices.resize(n*dst.size());
+    table.weights.resize(n*dst.size());
+    double xs[4];
+    for (uword i = 0; i < dst.size(); ++i) {
+        int *idx = &table.indices[i*n];
+        double *w = &table.weights[i*n];
+        double x = dst[i];
+        if (isPeriodic) {
+            // Wrap the target into [src[0],src[0]+period).
+            x = src[0]+fmod(fmod(x-src[0], period)+period, period);
+        } else {
+            x = fmin(fmax(x, src[0]), src[numSrc-1]);
+        }
+        // Find the source grid on the left side of the target.
+        int i0 = std::upper_bound(src.begin(), src.end(), x)-src.begin()-1;
+        int start = i0-n/2+1;
+        if (!isPeriodic) {
+            start = std::min(std::max(start, 0), numSrc-n);
+        }
+        for (int l = 0; l < n; ++l) {
+            int j = start+l;
+            int shift = j < 0 ? -1 : j >= numSrc ? 1 : 0;
+            idx[l] = j-shift*numSrc;
+            xs[l] = src[idx[l]]+shift*period;
+        }
+        for (int l0 = 0; l0 < n; ++l0) {
+            w[l0] = 1;
+            for (int l1 = 0; l1 < n; ++l1) {
+                if (l0 == l1) continue;
+                w[l0] *= (x-xs[l1])/(xs[l0]-xs[l1]);
+            }
+        }
+    }
+} // setAxisTable
+
+void RLLMeshRegrid::
+setConservativePlan() {
+    const double period = srcMesh->domain().axisSpan(0);
+    vec srcEdges[2], dstEdges[2];
+    for (int m = 0; m < 2; ++m) {
+        calcCellEdges(*srcMesh, m, srcEdges[m]);
+        calcCellEdges(*dstMesh, m, dstEdges[m]);
+    }
+    // Calculate the 1D overlaps along each axis, and the 2D overlap areas are
+    // their products in the (lon,sin(lat)) space.
+    vector<vector<std::pair<int, double> > > overlaps[2];
+    for (int m = 0; m < 2; ++m) {
+        overlaps[m].resize(numDstGrid[m]);
+        #pragma omp parallel for
+        for (int i1 = 0; i1 < numDstGrid[m]; ++i1) {
+            for (int i0 = 0; i0 < numSrcGrid[m]; ++i0) {
+                double res = 0;
+                for (int l = m == 0 ? -1 : 0; l <= (m == 0 ? 1 : 0); ++l) {
+                    double a = fmax(dstEdges[m][i1], srcEdges[m][i0]+l*period);
+                    double b = fmin(dstEdges[m][i1+1], srcEdges[m][i0+1]+l*period);
+                    if (b > a) res += b-a;
+                }
+                if (res > 0) {
+                    overlaps[m][i1].push_back(std::make_pair(i0, res));
+                }
+            }
+        }
+    }
+    const uword numSrcRow = srcMesh->numGrid(0, GridType::FULL, true);
+    plan.init(loc, numSrcRow*srcMesh->numGrid(1, GridType::FULL, true),
+              numDstGrid[0]*numDstGrid[1]);
+    for (int j1 = 0; j1 < numDstGrid[1]; ++j1) {
+        double dy = dstEdges[1][j1+1]-dstEdges[1][j1];
+        for (int i1 = 0; i1 < numDstGrid[0]; ++i1) {
+            double area = (dstEdges[0][i1+1]-dstEdges[0][i1])*dy;
+            for (uword l1 = 0; l1 < overlaps[1][j1].size(); ++l1) {
+                uword j0 = srcStartIndex[1]+overlaps[1][j1][l1].first;
+                for (uword l0 = 0; l0 < overlaps[0][i1].size(); ++l0) {
+                    uword i0 = srcStartIndex[0]+overlaps[0][i1][l0].first;
+                    plan.addWeight(i0+numSrcRow*j0,
+                                   overlaps[0][i1][l0].second*
+                                   overlaps[1][j1][l1].second/area);
+                }
+            }
+            plan.endRow();
+        }
+    }
+} // setConservativePlan
+
+void RLLMeshRegrid::
+calcCellEdges(const RLLMesh &mesh, int axisIdx, vec &edges) {
+    int n = mesh.numGrid(axisIdx, GridType::FULL);
+    int s = mesh.startIndex(axisIdx, GridType::HALF);
+    // The cell i is bounded by the half grids i-1 and i for FULL_LEAD style,
+    // and i and i+1 for HALF_LEAD style.
+    if (mesh.gridStyle(axisIdx) == FULL_LEAD) s--;
+    edges.set_size(n+1);
+    if (axisIdx == 0) {
+        for (int i = 0; i <= n; ++i) {
+            edges[i] = mesh.gridCoordComp(0, GridType::HALF, s+i);
+        }
+    } else {
+        for (int j = 0; j <= n; ++j) {
+            if (s+j < 0) {
+                edges[j] = -1.0;
+            } else if (s+j >= static_cast<int>(mesh.numGrid(1, GridType::HALF))) {
+                edges[j] = 1.0;
+            } else {
+                edges[j] = mesh.sinLat(GridType::HALF, s+j);
+            }
+        }
+    }
+} // calcCellEdges
+
+} // geomtk
@@ -0,0 +1,296 @@
+#ifndef __GEOMTK_RLLMeshRegrid__
+#define __GEOMTK_RLLMeshRegrid__
+
+#include "Regrid.h"
+#include "RegridPlan.h"
+#include "RLLField.h"
+
+namespace geomtk {
+
+/**
+ *  This class regrids the whole fields from one RLL mesh to another. Since
+ *  both meshes are tensor products of 1D grids, the Lagrange interpolation is
+ *  separable, so the 1D stencil indices and weights of each axis are computed
+ *  once in "init", and "run" applies them in three passes along longitude,
+ *  latitude and level. The cost is then proportional to the stencil width
+ *  rather than its cube.
+ *
+ *  The source grids on the Poles (if any) are regarded as one point, so they
+ *  are not interpolated along longitude, and the target grids on the Poles are
+ *  set to the zonal mean. Outside the source range of the nonperiodic axes,
+ *  the nearest source grids are used.
+ *
+ *  For CONSERVATIVE method, the exact overlap areas between the source and
+ *  target cells are computed from the longitude intervals and the sin(lat)
+ *  band widths as in RLLMesh::setCellVolumes, and the target value is the
+ *  area-weighted mean of the overlapped source values, so the global integral
+ *  is kept. The weights of one horizontal level are stored as a RegridPlan
+ *  and applied on each level, so the two meshes must have the same levels.
+ */
+class RLLMeshRegrid {
+public:
+    typedef RLLStagger::GridType GridType;
+    typedef RLLStagger::Location Location;
+protected:
+    /**
+     *  The 1D stencils of one axis. The source grid indices (without halos)
+     *  and weights of the target grid i are stored in [i*n,(i+1)*n).
+     */
+    struct AxisTable {
+        int n;
+        vector<int> indices;
+        vector<double> weights;
+    };
+
+    const RLLMesh *srcMesh;
+    const RLLMesh *dstMesh;
+    RegridMethod method;
+    int loc;
+    int numSrcGrid[3];
+    int numDstGrid[3];
+    int srcStartIndex[3];
+    int dstStartIndex[3];
+    AxisTable tables[3];
+    vector<char> isSrcPoleRow;
+    vector<char> isDstPoleRow;
+    // horizontal remap matrix for CONSERVATIVE method
+    RegridPlan plan;
+    // intermediate results after longitude and latitude passes (not used by
+    // CONSERVATIVE method)
+    vector<double> buffer1;
+    vector<double> buffer2;
+public:
+    RLLMeshRegrid();
+    virtual ~RLLMeshRegrid();
+
+    /**
+     *  Compute the 1D stencil tables (or the remap matrix for CONSERVATIVE
+     *  method) between the two meshes.
+     *
+     *  @param method  the regrid method.
+     *  @param loc     the stagger location of the fields.
+     *  @param srcMesh the source mesh.
+     *  @param dstMesh the target mesh.
+     */
+    void
+    init(RegridMethod method, int loc, const RLLMesh &srcMesh,
+         const RLLMesh &dstMesh);
+
+    /**
+     *  Regrid the source field onto the target field. The halos of the target
+     *  field are updated.
+     *
+     *  @param srcIdx the time level index of the source field.
+     *  @param src    the source field on the source mesh.
+     *  @param dstIdx the time level index of the target field.
+     *  @param dst    the target field on the target mesh.
+     */
+    template <typename T, int N1, int N2>
+    void
+    run(const TimeLevelIndex<N1> &srcIdx, const RLLField<T, N1> &src,
+        const TimeLevelIndex<N2> &dstIdx, RLLField<T, N2> &dst);
+
+    /**
+     *  Regrid several source fields onto the target fields at once. For
+     *  CONSERVATIVE method, the fields and levels are remapped in parallel,
+     *  otherwise the fields are regridded one by one.
+     *
+     *  @param srcIdx the time level index of the source fields.
+     *  @param srcs   the source fields on the source mesh.
+     *  @param dstIdx the time level index of the target fields.
+     *  @param dsts   the target fields on the target mesh.
+     */
+    template <typename T, int N1, int N2>
+    void
+    run(const TimeLevelIndex<N1> &srcIdx,
+        const vector<const RLLField<T, N1>*> &srcs,
+        const TimeLevelIndex<N2> &dstIdx,
+        const vector<RLLField<T, N2>*> &dsts);
+
+    /**
+     *  Same as above with the fields given as brace-enclosed lists.
+     */
+    template <typename T, int N1, int N2>
+    void
+    run(const TimeLevelIndex<N1> &srcIdx,
+        initializer_list<const RLLField<T, N1>*> srcs,
+        const TimeLevelIndex<N2> &dstIdx,
+        initializer_list<RLLField<T, N2>*> dsts) {
+        run<T, N1, N2>(srcIdx, vector<const RLLField<T, N1>*>(srcs),
+                       dstIdx, vector<RLLField<T, N2>*>(dsts));
+    }
+protected:
+    static void
+    setAxisTable(RegridMethod method, const vec &src, const vec &dst,
+                 bool isPeriodic, double period, AxisTable &table);
+
+    void
+    setConservativePlan();
+
+    /**
+     *  Get the cell edges along the given axis, which are longitudes for x
+     *  axis and sines of latitudes for y axis.
+     */
+    static void
+    calcCellEdges(const RLLMesh &mesh, int axisIdx, vec &edges);
+}; // RLLMeshRegrid
+
+template <typename T, int N1, int N2>
+void RLLMeshRegrid::
+run(const TimeLevelIndex<N1> &srcIdx, const RLLField<T, N1> &src,
+    const TimeLevelIndex<N2> &dstIdx, RLLField<T, N2> &dst) {
+    static_assert(is_arithmetic<T>::value, "RLLMeshRegrid only supports arithmetic types!");
+    if (&src.mesh() != srcMesh || &dst.mesh() != dstMesh ||
+        src.staggerLocation() != loc || dst.staggerLocation() != loc) {
+        REPORT_ERROR("Fields do not match the regrid tables!");
+    }
+    const auto &s = src(srcIdx);
+    auto &d = dst(dstIdx);
+    const int nx0 = numSrcGrid[0], ny0 = numSrcGrid[1], nz0 = numSrcGrid[2];
+    const int nx1 = numDstGrid[0], ny1 = numDstGrid[1], nz1 = numDstGrid[2];
+    if (method == CONSERVATIVE) {
+        run<T, N1, N2>(srcIdx, {&src}, dstIdx, {&dst});
+        return;
+    }
+    buffer1.resize(nx1*ny0*nz0);
+    buffer2.resize(nx1*ny1*nz0);
+    // Longitude pass.
+    const AxisTable &tx = tables[0];
+    #pragma omp parallel for collapse(2)
+    for (int k = 0; k < nz0; ++k) {
+        for (int j = 0; j < ny0; ++j) {
+            int J = srcStartIndex[1]+j, K = srcStartIndex[2]+k;
+            double *row = &buffer1[nx1*(j+ny0*k)];
+            if (isSrcPoleRow[j]) {
+                double mean = 0;
+                for (int i = 0; i < nx0; ++i) {
+                    mean += s(srcStartIndex[0]+i, J, K);
+                }
+                mean /= nx0;
+                for (int i = 0; i < nx1; ++i) {
+                    row[i] = mean;
+                }
+                continue;
+            }
+            for (int i = 0; i < nx1; ++i) {
+                const int *idx = &tx.indices[i*tx.n];
+                const double *w = &tx.weights[i*tx.n];
+                double res = 0;
+                for (int l = 0; l < tx.n; ++l) {
+                    res += w[l]*s(srcStartIndex[0]+idx[l], J, K);
+                }
+                row[i] = res;
+            }
+        }
+    }
+    // Latitude pass.
+    const AxisTable &ty = tables[1];
+    #pragma omp parallel for collapse(2)
+    for (int k = 0; k < nz0; ++k) {
+        for (int j = 0; j < ny1; ++j) {
+            const int *idx = &ty.indices[j*ty.n];
+            const double *w = &ty.weights[j*ty.n];
+            double *row = &buffer2[nx1*(j+ny1*k)];
+            for (int i = 0; i < nx1; ++i) {
+                row[i] = 0;
+            }
+            for (int l = 0; l < ty.n; ++l) {
+                const double *srcRow = &buffer1[nx1*(idx[l]+ny0*k)];
+                for (int i = 0; i < nx1; ++i) {
+                    row[i] += w[l]*srcRow[i];
+                }
+            }
+            if (isDstPoleRow[j]) {
+                double mean = 0;
+                for (int i = 0; i < nx1; ++i) {
+                    mean += row[i];
+                }
+                mean /= nx1;
+                for (int i = 0; i < nx1; ++i) {
+                    row[i] = mean;
+                }
+            }
+        }
+    }
+    // Level pass.
+    const AxisTable &tz = tables[2];
+    #pragma omp parallel for collapse(2)
+    for (int k = 0; k < nz1; ++k) {
+        for (int j = 0; j < ny1; ++j) {
+            const int *idx = &tz.indices[k*tz.n];
+            const double *w = &tz.weights[k*tz.n];
+            int J = dstStartIndex[1]+j, K = dstStartIndex[2]+k;
+            for (int i = 0; i < nx1; ++i) {
+                double res = 0;
+                for (int l = 0; l < tz.n; ++l) {
+                    res += w[l]*buffer2[i+nx1*(j+ny1*idx[l])];
+                }
+                d(dstStartIndex[0]+i, J, K) = static_cast<T>(res);
+            }
+        }
+    }
+    dst.applyBndCond(dstIdx);
+} // run
+
+template <typename T, int N1, int N2>
+void RLLMeshRegrid::
+run(const TimeLevelIndex<N1> &srcIdx,
+    const vector<const RLLField<T, N1>*> &srcs,
+    const TimeLevelIndex<N2> &dstIdx,
+    const vector<RLLField<T, N2>*> &dsts) {
+    if (srcs.size() != dsts.size()) {
+        REPORT_ERROR("Source and target field numbers do not match!");
+    }
+    const int numField = srcs.size();
+    const RLLField<T, N1> *const *src = srcs.data();
+    RLLField<T, N2> *const *dst = dsts.data();
+    if (method != CONSERVATIVE) {
+        for (int f = 0; f < numField; ++f) {
+            run(srcIdx, *src[f], dstIdx, *dst[f]);
+        }
+        return;
+    }
+    for (int f = 0; f < numField; ++f) {
+        if (&src[f]->mesh() != srcMesh || &dst[f]->mesh() != dstMesh ||
+            src[f]->staggerLocation() != loc || dst[f]->staggerLocation() != loc) {
+            REPORT_ERROR("Fields do not match the regrid tables!");
+        }
+    }
+    const int nx1 = numDstGrid[0], ny1 = numDstGrid[1], nz1 = numDstGrid[2];
+    #pragma omp parallel
+    {
+        // converted source level for non-double fields
+        vector<double> buffer;
+        #pragma omp for collapse(2)
+        for (int f = 0; f < numField; ++f) {
+            for (int k = 0; k < nz1; ++k) {
+                const auto &s = (*src[f])(srcIdx);
+                auto &d = (*dst[f])(dstIdx);
+                const T *x = s.memptr()+(srcStartIndex[2]+k)*s.stride(2);
+                const double *xd;
+                if (is_same<T, double>::value) {
+                    xd = reinterpret_cast<const double*>(x);
+                } else {
+                    buffer.resize(s.stride(2));
+                    for (uword l = 0; l < buffer.size(); ++l) {
+                        buffer[l] = x[l];
+                    }
+                    xd = &buffer[0];
+                }
+                for (int j = 0; j < ny1; ++j) {
+                    for (int i = 0; i < nx1; ++i) {
+                        d(dstStartIndex[0]+i, dstStartIndex[1]+j, dstStartIndex[2]+k) =
+                            static_cast<T>(plan.applyRow(xd, i+nx1*j));
+                    }
+                }
+            }
+        }
+    }
+    for (int f = 0; f < numField; ++f) {
+        dst[f]->applyBndCond(dstIdx);
+    }
+} // run
+
+} // geomtk
+
+#endif // __GEOMTK_RLLMeshRegrid__
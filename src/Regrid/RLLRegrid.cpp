@@ -14,16 +14,25 @@ RLLRegrid::
 ~RLLRegrid() {
 }
 
+double* RLLRegrid::
+ringDistances(int n) {
+    static thread_local vector<double> buffer;
+    if (buffer.size() < static_cast<size_t>(n)) {
+        buffer.resize(n);
+    }
+    return buffer.data();
+} // ringDistances
+
+template <class PointType, class VelocityType>
 void RLLRegrid::
-run(RegridMethod method, const TimeLevelIndex<2> &timeIdx,
-    const RLLVelocityField &f, const SphereCoord &x,
-    SphereVelocity &y, RLLMeshIndex *_idx) {
-    RLLMeshIndex *idx;
-    if (_idx == NULL) {
-        idx = new RLLMeshIndex(mesh().domain().numDim());
-        idx->locate(mesh(), x);
-    } else {
-        idx = _idx;
+runVelocity(RegridMethod method, const TimeLevelIndex<2> &timeIdx,
+            const RLLVelocityField &f, const PointType &x,
+            VelocityType &y, RLLMeshIndex *_idx) {
+    RLLMeshIndex localIdx(mesh().domain().numDim());
+    RLLMeshIndex *idx = _idx;
+    if (idx == NULL) {
+        localIdx.locate(mesh(), x);
+        idx = &localIdx;
     }
     if (idx->isInPolarCap()) {
         const SphereDomain &domain = mesh().domain();
@@ -36,12 +45,16 @@ run(RegridMethod method, const TimeLevelIndex<2> &timeIdx,
         // horizontal velocity
         y.psVelocity()[0] = 0.0;
         y.psVelocity()[1] = 0.0;
+        int is = mesh().is(RLLStagger::GridType::FULL);
+        int nx = mesh().numGrid(0, RLLStagger::GridType::FULL);
+        double *ds = ringDistances(nx);
+        domain.calcDistances(x, nx, &mesh().cosLons(RLLStagger::GridType::FULL)[is],
+                             &mesh().sinLons(RLLStagger::GridType::FULL)[is],
+                             cosLat, sinLat, ds);
         bool match = false;
         double W = 0.0;
-        for (uword i = mesh().is(RLLStagger::GridType::FULL);
-             i <= mesh().ie(RLLStagger::GridType::FULL); ++i) {
-            double d = domain.calcDistance(x, mesh().gridCoordComp(0, RLLStagger::GridType::FULL, i),
-                                           sinLat, cosLat);
+        for (int i = is; i < is+nx; ++i) {
+            double d = ds[i-is];
             if (d < eps) {
                 y.psVelocity()[0] = ring.transformedData(0, timeIdx, i, k);
                 y.psVelocity()[1] = ring.transformedData(1, timeIdx, i, k);
@@ -79,9 +92,80 @@ run(RegridMethod method, const TimeLevelIndex<2> &timeIdx,
             y.transformToPS(x);
         }
     }
-    if (_idx == NULL) {
-        delete idx;
+} // runVelocity
+
+void RLLRegrid::
+run(RegridMethod method, const TimeLevelIndex<2> &timeIdx,
+    const RLLVelocityField &f, const SphereCoord &x,
+    SphereVelocity &y, RLLMeshIndex *idx) {
+    runVelocity(method, timeIdx, f, x, y, idx);
+} // run
+
+template <int NumDim>
+void RLLRegrid::
+run(RegridMethod method, const TimeLevelIndex<2> &timeIdx,
+    const RLLVelocityField &f, const FixedSphereCoord<NumDim> &x,
+    FixedSphereVelocity<NumDim> &y, RLLMeshIndex *idx) {
+    runVelocity(method, timeIdx, f, x, y, idx);
+} // run
+
+template void RLLRegrid::
+run<2>(RegridMethod method, const TimeLevelIndex<2> &timeIdx,
+       const RLLVelocityField &f, const FixedSphereCoord<2> &x,
+       FixedSphereVelocity<2> &y, RLLMeshIndex *idx);
+
+template void RLLRegrid::
+run<3>(RegridMethod method, const TimeLevelIndex<2> &timeIdx,
+       const RLLVelocityField &f, const FixedSphereCoord<3> &x,
+       FixedSphereVelocity<3> &y, RLLMeshIndex *idx);
+
+void RLLRegrid::
+initPlan(RegridMethod method, int loc, const vector<SphereCoord> &x,
+         RegridPlan &plan) const {
+    const SphereDomain &domain = mesh().domain();
+    const double eps = 1.0e-10;
+    plan.init(loc, storageSize(loc), x.size());
+    RLLMeshIndex idx(domain.numDim());
+    vector<double> ws(mesh().numGrid(0, GridType::FULL, true));
+    for (uword p = 0; p < x.size(); ++p) {
+        idx.reset();
+        idx.locate(mesh(), x[p]);
+        if (idx.isInPolarCap() && loc != Location::CENTER) {
+            REPORT_ERROR("Only CENTER fields are supported for the targets " <<
+                         "in the polar caps!");
+        }
+        if (idx.isInPolarCap()) {
+            int j = idx.pole() == SOUTH_POLE ? 1 : mesh().numGrid(1, GridType::FULL)-2;
+            int k = idx(2, GridType::FULL);
+            double sinLat = mesh().sinLat(GridType::FULL, j);
+            double cosLat = mesh().cosLat(GridType::FULL, j);
+            int is = mesh().is(GridType::FULL);
+            domain.calcDistances(x[p], mesh().numGrid(0, GridType::FULL),
+                                 &mesh().cosLons(GridType::FULL)[is],
+                                 &mesh().sinLons(GridType::FULL)[is],
+                                 cosLat, sinLat, &ws[is]);
+            double W = 0.0;
+            int match = -1;
+            for (uword i = mesh().is(GridType::FULL); i <= mesh().ie(GridType::FULL); ++i) {
+                if (ws[i] < eps) {
+                    match = i;
+                    break;
+                }
+                ws[i] = 1.0/ws[i];
+                W += ws[i];
+            }
+            if (match != -1) {
+                plan.addWeight(storageOffset(loc, match, j, k), 1.0);
+            } else {
+                for (uword i = mesh().is(GridType::FULL); i <= mesh().ie(GridType::FULL); ++i) {
+                    plan.addWeight(storageOffset(loc, i, j, k), ws[i]/W);
+                }
+            }
+            plan.endRow();
+        } else {
+            addLagrangeStencil(method, loc, x[p], idx, plan);
+        }
     }
-}
+} // initPlan
 
-}
+} // geomtk
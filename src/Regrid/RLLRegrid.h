@@ -17,27 +17,77 @@ public:
     RLLRegrid(const RLLMesh &mesh);
     virtual ~RLLRegrid();
 
-    template <typename T, int N>
+    /**
+     *  Interpolate the field onto the point, which can be either SphereCoord
+     *  or FixedSphereCoord.
+     */
+    template <typename T, int N, class PointType>
     void run(RegridMethod method, const TimeLevelIndex<N> &timeIdx,
-             const RLLField<T, N> &f, const SphereCoord &x, T &y,
+             const RLLField<T, N> &f, const PointType &x, T &y,
              RLLMeshIndex *idx = NULL);
 
     void run(RegridMethod method, const TimeLevelIndex<2> &timeIdx,
              const RLLVelocityField &f, const SphereCoord &x, SphereVelocity &y,
              RLLMeshIndex *idx = NULL);
+
+    /**
+     *  Interpolate the velocity onto the lightweight point. It is instantiated
+     *  for 2D and 3D.
+     */
+    template <int NumDim>
+    void run(RegridMethod method, const TimeLevelIndex<2> &timeIdx,
+             const RLLVelocityField &f, const FixedSphereCoord<NumDim> &x,
+             FixedSphereVelocity<NumDim> &y, RLLMeshIndex *idx = NULL);
+
+    /**
+     *  Precompute the regridding weights from the fields on the given stagger
+     *  location to the fixed target points. In the polar caps, the inverse
+     *  distance weights of the CENTER grids on the nearest latitude circle
+     *  are used as in "run", so the source fields should be on CENTER when
+     *  there are targets in the polar caps.
+     *
+     *  @param method the regrid method.
+     *  @param loc    the stagger location of the source fields.
+     *  @param x      the target coordinates.
+     *  @param plan   the output regrid plan.
+     */
+    void initPlan(RegridMethod method, int loc, const vector<SphereCoord> &x,
+                  RegridPlan &plan) const;
+protected:
+    /**
+     *  Run the Lagrange interpolation with n points along each axis outside
+     *  the polar caps. The dimension is the template parameter, so the index
+     *  and weight arrays are fixed-size and the loops are unrolled.
+     */
+    template <int NumDim, typename T, int N, class PointType>
+    void runLagrange(int n, const TimeLevelIndex<N> &timeIdx,
+                     const RLLField<T, N> &f, const PointType &x, T &y,
+                     const RLLMeshIndex &idx) const;
+
+    template <class PointType, class VelocityType>
+    void runVelocity(RegridMethod method, const TimeLevelIndex<2> &timeIdx,
+                     const RLLVelocityField &f, const PointType &x,
+                     VelocityType &y, RLLMeshIndex *idx);
+
+    /**
+     *  Get the buffer of the distances to the grids on the polar ring. The
+     *  buffer is owned by the calling thread and reused across the calls, so
+     *  the points can be interpolated in parallel without allocations.
+     */
+    static double*
+    ringDistances(int n);
 }; // RLLRegrid
 
-template <typename T, int N>
+template <typename T, int N, class PointType>
 void RLLRegrid::
 run(RegridMethod method, const TimeLevelIndex<N> &timeIdx,
-    const RLLField<T, N> &f, const SphereCoord &x,
+    const RLLField<T, N> &f, const PointType &x,
     T &y, RLLMeshIndex *_idx) {
-    RLLMeshIndex *idx;
-    if (_idx == NULL) {
-        idx = new RLLMeshIndex(mesh().domain().numDim());
-        idx->locate(mesh(), x);
-    } else {
-        idx = _idx;
+    RLLMeshIndex localIdx(mesh().domain().numDim());
+    RLLMeshIndex *idx = _idx;
+    if (idx == NULL) {
+        localIdx.locate(mesh(), x);
+        idx = &localIdx;
     }
     if (method == LINEAR || method == QUADRATIC || method == CUBIC) {
         if (idx->isInPolarCap()) {
@@ -48,22 +98,24 @@ run(RegridMethod method, const TimeLevelIndex<N> &timeIdx,
             int k = (*idx)(2, RLLStagger::GridType::FULL);
             double sinLat = mesh().sinLat(RLLStagger::GridType::FULL, j);
             double cosLat = mesh().cosLat(RLLStagger::GridType::FULL, j);
+            int is = mesh().is(RLLStagger::GridType::FULL);
+            int nx = mesh().numGrid(0, RLLStagger::GridType::FULL);
+            double *ds = ringDistances(nx);
+            domain.calcDistances(x, nx, &mesh().cosLons(RLLStagger::GridType::FULL)[is],
+                                 &mesh().sinLons(RLLStagger::GridType::FULL)[is],
+                                 cosLat, sinLat, ds);
             y = 0.0;
             bool match = false;
             double ws = 0.0;
-            for (uword i = mesh().is(RLLStagger::GridType::FULL);
-                 i <= mesh().ie(RLLStagger::GridType::FULL); ++i) {
-                // TODO: Use mesh().gridCoord(...) instead.
-                double d = domain.calcDistance(x, mesh().gridCoordComp(0, RLLStagger::GridType::FULL, i),
-                                               sinLat, cosLat);
-                if (d < eps) {
-                    y = f(timeIdx, i, j, k);
+            for (int i = 0; i < nx; ++i) {
+                if (ds[i] < eps) {
+                    y = f(timeIdx, is+i, j, k);
                     match = true;
                     break;
                 } else {
-                    double w = 1.0/d;
+                    double w = 1.0/ds[i];
                     ws += w;
-                    y += w*f(timeIdx, i, j, k);
+                    y += w*f(timeIdx, is+i, j, k);
                 }
             }
             if (!match) {
@@ -78,76 +130,85 @@ run(RegridMethod method, const TimeLevelIndex<N> &timeIdx,
             } else if (method == CUBIC) {
                 n = 4;
             }
-            int n1 = n/2-2;
-            int n2 = -(n-1)/2;
-            int i[mesh().domain().numDim()][n];
-            for (uword m = 0; m < mesh().domain().numDim(); ++m) {
-                i[m][0] = (*idx)(m, f.gridType(m))-n/2+1;
-                if (mesh().domain().axisStartBndType(m) != PERIODIC) {
-                    if ((*idx)(m, f.gridType(m)) == static_cast<int>(mesh().startIndex(m, f.gridType(m)))+n1) {
-                        i[m][0]++;
-                    } else if ((*idx)(m, f.gridType(m)) == static_cast<int>(mesh().endIndex(m, f.gridType(m)))+n2) {
-                        i[m][0]--;
-                    }
-                } else {
-                    if (i[m][0] < 0) {
-                        REPORT_ERROR("The halo width is not sufficient for the interpolation!");
-                    } else if (i[m][0]+n > static_cast<int>(mesh().numGrid(m, f.gridType(m), true))) {
-                        REPORT_ERROR("The halo width is not sufficient for the interpolation!");
-                    }
-                }
-                for (int l = 1; l < n; ++l) {
-                    i[m][l] = i[m][l-1]+1;
-                }
-            }
-            double w[mesh().domain().numDim()][n];
-            for (uword m = 0; m < mesh().domain().numDim(); ++m) {
-                for (int l0 = 0; l0 < n; ++l0) {
-                    double x0 = mesh().gridCoordComp(m, f.gridType(m), i[m][l0]);
-                    w[m][l0] = 1;
-                    for (int l1 = 0; l1 < n; ++l1) {
-                        if (l0 == l1) continue;
-                        double x1 = mesh().gridCoordComp(m, f.gridType(m), i[m][l1]);
-                        w[m][l0] *= (x(m)-x1)/(x0-x1);
-                    }
-                }
-
-            }
-            y = 0;
             switch (mesh().domain().numDim()) {
                 case 1:
-                    for (int l = 0; l < n; ++l) {
-                        y += w[0][l]*f(timeIdx, i[0][l]);
-                    }
+                    runLagrange<1>(n, timeIdx, f, x, y, *idx);
                     break;
                 case 2:
-                    for (int l0 = 0; l0 < n; ++l0) {
-                        for (int l1 = 0; l1 < n; ++l1) {
-                            y += w[0][l0]*w[1][l1]*f(timeIdx, i[0][l0], i[1][l1]);
-                        }
-                    }
+                    runLagrange<2>(n, timeIdx, f, x, y, *idx);
                     break;
                 case 3:
-                    for (int l0 = 0; l0 < n; ++l0) {
-                        for (int l1 = 0; l1 < n; ++l1) {
-                            for (int l2 = 0; l2 < n; ++l2) {
-                                y += w[0][l0]*w[1][l1]*w[2][l2]*f(timeIdx, i[0][l0], i[1][l1], i[2][l2]);
-                            }
-                        }
-                    }
+                    runLagrange<3>(n, timeIdx, f, x, y, *idx);
                     break;
                 default:
-                    break;
+                    REPORT_ERROR("Invalid dimension number!");
             }
         }
     } else {
         REPORT_ERROR("Under construction!");
     }
-    if (_idx == NULL) {
-        delete idx;
-    }
 } // run
 
+template <int NumDim, typename T, int N, class PointType>
+void RLLRegrid::
+runLagrange(int n, const TimeLevelIndex<N> &timeIdx, const RLLField<T, N> &f,
+            const PointType &x, T &y, const RLLMeshIndex &idx) const {
+    const int n1 = n/2-2;
+    const int n2 = -(n-1)/2;
+    // NOTE: The arrays are 3D to keep the unused branches below valid.
+    int i[3][4];
+    double w[3][4];
+    for (int m = 0; m < NumDim; ++m) {
+        int gridType = f.gridType(m);
+        i[m][0] = idx(m, gridType)-n/2+1;
+        if (mesh().domain().axisStartBndType(m) != PERIODIC) {
+            if (idx(m, gridType) == static_cast<int>(mesh().startIndex(m, gridType))+n1) {
+                i[m][0]++;
+            } else if (idx(m, gridType) == static_cast<int>(mesh().endIndex(m, gridType))+n2) {
+                i[m][0]--;
+            }
+        } else {
+            if (i[m][0] < 0) {
+                REPORT_ERROR("The halo width is not sufficient for the interpolation!");
+            } else if (i[m][0]+n > static_cast<int>(mesh().numGrid(m, gridType, true))) {
+                REPORT_ERROR("The halo width is not sufficient for the interpolation!");
+            }
+        }
+        for (int l = 1; l < n; ++l) {
+            i[m][l] = i[m][l-1]+1;
+        }
+        for (int l0 = 0; l0 < n; ++l0) {
+            double x0 = mesh().gridCoordComp(m, gridType, i[m][l0]);
+            w[m][l0] = 1;
+            for (int l1 = 0; l1 < n; ++l1) {
+                if (l0 == l1) continue;
+                double x1 = mesh().gridCoordComp(m, gridType, i[m][l1]);
+                w[m][l0] *= (x(m)-x1)/(x0-x1);
+            }
+        }
+    }
+    y = 0;
+    if (NumDim == 1) {
+        for (int l = 0; l < n; ++l) {
+            y += w[0][l]*f(timeIdx, i[0][l]);
+        }
+    } else if (NumDim == 2) {
+        for (int l0 = 0; l0 < n; ++l0) {
+            for (int l1 = 0; l1 < n; ++l1) {
+                y += w[0][l0]*w[1][l1]*f(timeIdx, i[0][l0], i[1][l1]);
+            }
+        }
+    } else {
+        for (int l0 = 0; l0 < n; ++l0) {
+            for (int l1 = 0; l1 < n; ++l1) {
+                for (int l2 = 0; l2 < n; ++l2) {
+                    y += w[0][l0]*w[1][l1]*w[2][l2]*f(timeIdx, i[0][l0], i[1][l1], i[2][l2]);
+                }
+            }
+        }
+    }
+} // runLagrange
+
 } // geomtk
 
 #endif // __GEOMTK_RLLRegrid__
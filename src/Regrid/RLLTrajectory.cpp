@@ -0,0 +1,97 @@
+#include "RLLTrajectory.h"
+
+namespace geomtk {
+
+RLLTrajectory::
+RLLTrajectory(const RLLMesh &mesh, TrajectoryScheme scheme,
+              RegridMethod method) : regrid(mesh) {
+    if (method == CONSERVATIVE) {
+        REPORT_ERROR("CONSERVATIVE method can not be used for trajectories!");
+    }
+    this->mesh = &mesh;
+    this->scheme = scheme;
+    this->method = method;
+}
+
+RLLTrajectory::
+~RLLTrajectory() {
+}
+
+template <int NumDim>
+void RLLTrajectory::
+calcVelocity(const TimeLevelIndex<2> &timeIdx, const RLLVelocityField &v,
+             const FixedSphereCoord<NumDim> &x, const RLLMeshIndex &idx0,
+             RLLMeshIndex &idx, FixedSphereVelocity<NumDim> &y) {
+    // The velocity is combined and applied at the start point, so it should
+    // be on the stereographic plane when the start point is on the Pole.
+    idx.setMoveOnPole(idx0.isOnPole());
+    regrid.run(method, timeIdx, v, x, y, &idx);
+} // calcVelocity
+
+template <int NumDim>
+void RLLTrajectory::
+integrate(const TimeLevelIndex<2> &oldIdx, double dt,
+          const RLLVelocityField &v, mat &x, RLLMeshIndexBatch &idx) {
+    if (mesh->domain().numDim() != static_cast<uword>(NumDim) ||
+        x.n_cols != static_cast<uword>(NumDim)) {
+        REPORT_ERROR("Particle dimension does not match the domain!");
+    }
+    const uword numPoint = x.n_rows;
+    bool useHint = idx.numPoint() == numPoint;
+    if (!useHint) {
+        idx.init(NumDim, numPoint);
+    }
+    const TimeLevelIndex<2> halfIdx = oldIdx+0.5;
+    const TimeLevelIndex<2> newIdx = oldIdx+1;
+    #pragma omp parallel for
+    for (uword p = 0; p < numPoint; ++p) {
+        FixedSphereCoord<NumDim> x0, x1;
+        if (NumDim == 3) {
+            x0.set(x(p, 0), x(p, 1), x(p, 2));
+        } else {
+            x0.set(x(p, 0), x(p, 1));
+        }
+        // The indices of the start point are kept for moving, and the ones of
+        // the stage points are walked from them.
+        RLLMeshIndex idx0(NumDim);
+        if (useHint) idx.get(p, idx0);
+        idx0.locate(*mesh, x0);
+        RLLMeshIndex idx1 = idx0;
+        FixedSphereVelocity<NumDim> k1, k2;
+        if (scheme == RK2) {
+            calcVelocity(oldIdx, v, x0, idx0, idx1, k1);
+            mesh->move(x0, 0.5*dt, k1, idx0, x1);
+            idx1.locate(*mesh, x1);
+            calcVelocity(halfIdx, v, x1, idx0, idx1, k2);
+            mesh->move(x0, dt, k2, idx0, x1);
+        } else {
+            FixedSphereVelocity<NumDim> k3, k4;
+            calcVelocity(oldIdx, v, x0, idx0, idx1, k1);
+            mesh->move(x0, 0.5*dt, k1, idx0, x1);
+            idx1.locate(*mesh, x1);
+            calcVelocity(halfIdx, v, x1, idx0, idx1, k2);
+            mesh->move(x0, 0.5*dt, k2, idx0, x1);
+            idx1.locate(*mesh, x1);
+            calcVelocity(halfIdx, v, x1, idx0, idx1, k3);
+            mesh->move(x0, dt, k3, idx0, x1);
+            idx1.locate(*mesh, x1);
+            calcVelocity(newIdx, v, x1, idx0, idx1, k4);
+            mesh->move(x0, dt, (k1+(k2+k3)*2.0+k4)/6.0, idx0, x1);
+        }
+        idx1.locate(*mesh, x1);
+        idx.set(p, idx1);
+        for (int m = 0; m < NumDim; ++m) {
+            x(p, m) = x1(m);
+        }
+    }
+} // integrate
+
+template void RLLTrajectory::
+integrate<2>(const TimeLevelIndex<2> &oldIdx, double dt,
+             const RLLVelocityField &v, mat &x, RLLMeshIndexBatch &idx);
+
+template void RLLTrajectory::
+integrate<3>(const TimeLevelIndex<2> &oldIdx, double dt,
+             const RLLVelocityField &v, mat &x, RLLMeshIndexBatch &idx);
+
+} // geomtk
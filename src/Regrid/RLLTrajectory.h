@@ -0,0 +1,91 @@
+#ifndef __GEOMTK_RLLTrajectory__
+#define __GEOMTK_RLLTrajectory__
+
+#include "RLLRegrid.h"
+#include "RLLMeshIndexBatch.h"
+
+namespace geomtk {
+
+/**
+ *  The Runge-Kutta schemes for integrating the trajectories. RK2 is the
+ *  midpoint method.
+ */
+enum TrajectoryScheme {
+    RK2, RK4
+};
+
+/**
+ *  This class integrates the trajectories of a batch of particles in the
+ *  velocity field on RLL mesh over one time step. The particle coordinates are
+ *  given in structure-of-arrays form as RLLMeshIndexBatch (i.e. one particle
+ *  per row and one axis per column).
+ *
+ *  Each particle is processed through all the stages in one pass, that is
+ *  locating the stage point, interpolating the velocity (by the polar ring on
+ *  stereographic plane in the polar caps) and moving from the start point by
+ *  RLLMesh::move, so the particles are only read and written once, and the
+ *  mesh indices of one stage are used as the hint for the next one. When the
+ *  start point is on the Pole, all the stage velocities are kept on the
+ *  stereographic plane, so they can be combined. The particles are processed
+ *  in parallel when OpenMP is enabled.
+ *
+ *  The velocity field should have the half time level (i.e. created with
+ *  'hasHalfLevel' and updated by 'applyBndCond(timeIdx, true)'), which is used
+ *  by the middle stages.
+ *
+ *  NOTE: The vertical velocity is not interpolated in the polar caps yet
+ *  (RLLRegrid reports "Under construction!"), so the 3D particles should be
+ *  kept outside the polar caps.
+ */
+class RLLTrajectory {
+public:
+    typedef RLLStagger::GridType GridType;
+    typedef RLLStagger::Location Location;
+protected:
+    const RLLMesh *mesh;
+    RLLRegrid regrid;
+    TrajectoryScheme scheme;
+    RegridMethod method;
+public:
+    RLLTrajectory(const RLLMesh &mesh, TrajectoryScheme scheme = RK4,
+                  RegridMethod method = LINEAR);
+    virtual ~RLLTrajectory();
+
+    TrajectoryScheme
+    timeScheme() const {
+        return scheme;
+    }
+
+    RegridMethod
+    regridMethod() const {
+        return method;
+    }
+
+    /**
+     *  Move the particles from the old time level to the next one. It is
+     *  instantiated for 2D and 3D, but the 3D one can not be used in the polar
+     *  caps yet.
+     *
+     *  @param oldIdx the old time level index of the velocity.
+     *  @param dt     the time step size.
+     *  @param v      the velocity field.
+     *  @param x      the particle coordinates, which are updated in place.
+     *  @param idx    the mesh indices of the particles. When it matches the
+     *                particles, it is used as the hint, and it is updated to
+     *                the new positions on return.
+     */
+    template <int NumDim>
+    void
+    integrate(const TimeLevelIndex<2> &oldIdx, double dt,
+              const RLLVelocityField &v, mat &x, RLLMeshIndexBatch &idx);
+protected:
+    template <int NumDim>
+    void
+    calcVelocity(const TimeLevelIndex<2> &timeIdx, const RLLVelocityField &v,
+                 const FixedSphereCoord<NumDim> &x, const RLLMeshIndex &idx0,
+                 RLLMeshIndex &idx, FixedSphereVelocity<NumDim> &y);
+}; // RLLTrajectory
+
+} // geomtk
+
+#endif // __GEOMTK_RLLTrajectory__
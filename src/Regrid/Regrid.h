@@ -5,11 +5,17 @@
 #include "Mesh.h"
 #include "Field.h"
 #include "MeshIndex.h"
+#include "RegridPlan.h"
 
 namespace geomtk {
 
+/**
+ *  The regrid methods. LINEAR, QUADRATIC and CUBIC are Lagrange point
+ *  interpolations, and CONSERVATIVE is the first-order conservative remapping
+ *  between meshes (see RLLMeshRegrid).
+ */
 enum RegridMethod {
-    LINEAR, QUADRATIC, CUBIC
+    LINEAR, QUADRATIC, CUBIC, CONSERVATIVE
 };
 
 /**
@@ -46,15 +52,115 @@ public:
             return QUADRATIC;
         } else if (method == "cubic") {
             return CUBIC;
+        } else if (method == "conservative") {
+            return CONSERVATIVE;
         } else {
             REPORT_ERROR("Unknown regrid method \"" << method << "\"!");
         }
     }
+protected:
+    /**
+     *  Get the element offset of the given grid in one time level of the
+     *  fields on the given stagger location (halos included).
+     */
+    uword
+    storageOffset(int loc, int i, int j, int k) const {
+        return mesh().indexMap(loc).offset(i, j, k);
+    }
+
+    /**
+     *  Get the element number of one time level of the fields on the given
+     *  stagger location (halos included).
+     */
+    uword
+    storageSize(int loc) const {
+        uword res = 1;
+        for (uword m = 0; m < mesh().domain().numDim(); ++m) {
+            res *= mesh().numGrid(m, mesh().gridType(m, loc), true);
+        }
+        return res;
+    }
+
+    /**
+     *  Add the Lagrange interpolation stencil of one point into the regrid
+     *  plan as one row.
+     *
+     *  @param method the regrid method.
+     *  @param loc    the stagger location.
+     *  @param x      the target coordinate.
+     *  @param idx    the located mesh index of the target coordinate.
+     *  @param plan   the regrid plan.
+     */
+    template <class MeshIndexType>
+    void
+    addLagrangeStencil(RegridMethod method, int loc, const CoordType &x,
+                       const MeshIndexType &idx, RegridPlan &plan) const;
 }; // Regrid
 
 template <class MeshType, class CoordType>
 const MeshType* Regrid<MeshType, CoordType>::_mesh = NULL;
 
+template <class MeshType, class CoordType>
+template <class MeshIndexType>
+void Regrid<MeshType, CoordType>::
+addLagrangeStencil(RegridMethod method, int loc, const CoordType &x,
+                   const MeshIndexType &idx, RegridPlan &plan) const {
+    int n = 0;
+    if (method == LINEAR) {
+        n = 2;
+    } else if (method == QUADRATIC) {
+        n = 3;
+    } else if (method == CUBIC) {
+        n = 4;
+    } else {
+        REPORT_ERROR("Under construction!");
+    }
+    int n1 = n/2-2;
+    int n2 = -(n-1)/2;
+    // NOTE: The extra dimensions have one stencil point with unit weight.
+    int ns[3] = {1, 1, 1};
+    int i[3][4] = {{0}};
+    double w[3][4] = {{1}, {1}, {1}};
+    for (uword m = 0; m < mesh().domain().numDim(); ++m) {
+        int gridType = mesh().gridType(m, loc);
+        ns[m] = n;
+        i[m][0] = idx(m, gridType)-n/2+1;
+        if (mesh().domain().axisStartBndType(m) != PERIODIC) {
+            if (idx(m, gridType) == static_cast<int>(mesh().startIndex(m, gridType))+n1) {
+                i[m][0]++;
+            } else if (idx(m, gridType) == static_cast<int>(mesh().endIndex(m, gridType))+n2) {
+                i[m][0]--;
+            }
+        } else {
+            if (i[m][0] < 0 ||
+                i[m][0]+n > static_cast<int>(mesh().numGrid(m, gridType, true))) {
+                REPORT_ERROR("The halo width is not sufficient for the interpolation!");
+            }
+        }
+        for (int l = 1; l < n; ++l) {
+            i[m][l] = i[m][l-1]+1;
+        }
+        for (int l0 = 0; l0 < n; ++l0) {
+            double x0 = mesh().gridCoordComp(m, gridType, i[m][l0]);
+            w[m][l0] = 1;
+            for (int l1 = 0; l1 < n; ++l1) {
+                if (l0 == l1) continue;
+                double x1 = mesh().gridCoordComp(m, gridType, i[m][l1]);
+                w[m][l0] *= (x(m)-x1)/(x0-x1);
+            }
+        }
+    }
+    for (int l2 = 0; l2 < ns[2]; ++l2) {
+        for (int l1 = 0; l1 < ns[1]; ++l1) {
+            for (int l0 = 0; l0 < ns[0]; ++l0) {
+                plan.addWeight(storageOffset(loc, i[0][l0], i[1][l1], i[2][l2]),
+                               w[0][l0]*w[1][l1]*w[2][l2]);
+            }
+        }
+    }
+    plan.endRow();
+} // addLagrangeStencil
+
 } // geomtk
 
 #endif // __GEOMTK_Regrid__
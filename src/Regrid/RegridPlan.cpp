@@ -0,0 +1,67 @@
+#include "RegridPlan.h"
+
+namespace geomtk {
+
+RegridPlan::
+RegridPlan() {
+    _staggerLocation = -1;
+    numSourceElem = 0;
+    rowOffsets.push_back(0);
+}
+
+RegridPlan::
+~RegridPlan() {
+}
+
+void RegridPlan::
+init(int loc, uword numSourceElem, uword numTarget) {
+    _staggerLocation = loc;
+    this->numSourceElem = numSourceElem;
+    rowOffsets.clear();
+    colIndices.clear();
+    weights.clear();
+    rowOffsets.reserve(numTarget+1);
+    rowOffsets.push_back(0);
+} // init
+
+void RegridPlan::
+apply(const double *x, double *y) const {
+    const uword *offsets = &rowOffsets[0];
+    const uword *cols = colIndices.empty() ? NULL : &colIndices[0];
+    const double *w = weights.empty() ? NULL : &weights[0];
+    const int n = numTarget();
+    #pragma omp parallel for schedule(static)
+    for (int r = 0; r < n; ++r) {
+        double res = 0;
+        for (uword l = offsets[r]; l < offsets[r+1]; ++l) {
+            res += w[l]*x[cols[l]];
+        }
+        y[r] = res;
+    }
+} // apply
+
+void RegridPlan::
+apply(const double *x, double *y, uword numTracer) const {
+    const uword *offsets = &rowOffsets[0];
+    const uword *cols = colIndices.empty() ? NULL : &colIndices[0];
+    const double *w = weights.empty() ? NULL : &weights[0];
+    const int n = numTarget();
+    const uword T = numTracer;
+    #pragma omp parallel for schedule(static)
+    for (int r = 0; r < n; ++r) {
+        double *res = y+r*T;
+        for (uword t = 0; t < T; ++t) {
+            res[t] = 0;
+        }
+        for (uword l = offsets[r]; l < offsets[r+1]; ++l) {
+            const double wl = w[l];
+            const double *src = x+cols[l]*T;
+            #pragma omp simd
+            for (uword t = 0; t < T; ++t) {
+                res[t] += wl*src[t];
+            }
+        }
+    }
+} // apply
+
+} // geomtk
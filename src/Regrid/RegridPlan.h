@@ -0,0 +1,225 @@
+#ifndef __GEOMTK_RegridPlan__
+#define __GEOMTK_RegridPlan__
+
+#include "geomtk_commons.h"
+#include "TimeLevels.h"
+#include "AlignedArray.h"
+
+namespace geomtk {
+
+/**
+ *  This class stores the precomputed regridding weights from a field stagger
+ *  location to a fixed set of target points as a sparse matrix in compressed
+ *  row form. Each row is one target point, and the column indices are the
+ *  element offsets into the contiguous storage of one time level of the
+ *  field (halos included). Applying the plan is then a streaming sparse
+ *  matrix-vector product, which can be done on any field with the same
+ *  stagger location and on any time level.
+ */
+class RegridPlan {
+protected:
+    int _staggerLocation;
+    uword numSourceElem;
+    vector<uword> rowOffsets;
+    vector<uword> colIndices;
+    vector<double> weights;
+public:
+    /**
+     *  The plans are applied on the fields with double data type, whose
+     *  storage is contiguous.
+     */
+    template <class FieldType>
+    using DoubleFieldOnly = typename enable_if<
+        is_same<typename FieldType::StorageType, AlignedArray<double> >::value>::type;
+
+    RegridPlan();
+    virtual ~RegridPlan();
+
+    /**
+     *  Clear the plan for new weights.
+     *
+     *  @param loc           the stagger location of the source fields.
+     *  @param numSourceElem the element number of one time level of the
+     *                       source fields (halos included).
+     *  @param numTarget     the expected target point number.
+     */
+    void
+    init(int loc, uword numSourceElem, uword numTarget = 0);
+
+    /**
+     *  Add one weight into the current row.
+     *
+     *  @param offset the element offset in the source field.
+     *  @param weight the weight.
+     */
+    void
+    addWeight(uword offset, double weight) {
+        colIndices.push_back(offset);
+        weights.push_back(weight);
+    }
+
+    /**
+     *  Finish the current row (i.e. target point).
+     */
+    void
+    endRow() {
+        rowOffsets.push_back(colIndices.size());
+    }
+
+    int
+    staggerLocation() const {
+        return _staggerLocation;
+    }
+
+    uword
+    numTarget() const {
+        return rowOffsets.size()-1;
+    }
+
+    uword
+    numWeight() const {
+        return weights.size();
+    }
+
+    /**
+     *  Apply the plan on the given field.
+     *
+     *  @param timeIdx the time level index.
+     *  @param f       the source field with double data type.
+     *  @param y       the target values.
+     */
+    template <class FieldType, int N>
+    DoubleFieldOnly<FieldType>
+    apply(const TimeLevelIndex<N> &timeIdx, const FieldType &f, vec &y) const;
+
+    /**
+     *  Apply the plan on several fields in one pass.
+     *
+     *  @param timeIdx the time level index.
+     *  @param fields  the source fields.
+     *  @param y       the target values with one column per field.
+     */
+    template <class FieldType, int N>
+    DoubleFieldOnly<FieldType>
+    apply(const TimeLevelIndex<N> &timeIdx,
+          initializer_list<const FieldType*> fields, mat &y) const;
+
+    template <class FieldType>
+    DoubleFieldOnly<FieldType>
+    apply(const FieldType &f, vec &y) const;
+
+    /**
+     *  Apply the plan on the raw data with the layout of one time level of
+     *  the source fields (e.g. one level of them if the plan is built for one
+     *  level).
+     *
+     *  @param x the source data.
+     *  @param y the target values.
+     */
+    void
+    apply(const double *x, double *y) const;
+
+    /**
+     *  Apply one row of the plan on the raw data without any threading, so
+     *  it can be called in the parallel loops of the callers (e.g. over the
+     *  fields and levels).
+     *
+     *  @param x the source data.
+     *  @param r the target index.
+     *
+     *  @return The target value.
+     */
+    double
+    applyRow(const double *x, uword r) const {
+        double res = 0;
+        for (uword l = rowOffsets[r]; l < rowOffsets[r+1]; ++l) {
+            res += weights[l]*x[colIndices[l]];
+        }
+        return res;
+    }
+
+    /**
+     *  Apply the plan on all tracers of a bundle in one pass. Each weight is
+     *  loaded once and applied on the contiguous tracer values.
+     *
+     *  @param timeIdx the time level index.
+     *  @param b       the source tracer bundle (e.g. StructuredTracerBundle).
+     *  @param y       the target values (tracer number x target number).
+     */
+    template <class BundleType, int N>
+    void
+    applyTracers(const TimeLevelIndex<N> &timeIdx, const BundleType &b,
+                 mat &y) const;
+
+    /**
+     *  Apply the plan on the raw data with the tracer index changing the
+     *  fastest.
+     *
+     *  @param x         the source data.
+     *  @param y         the target values.
+     *  @param numTracer the tracer number.
+     */
+    void
+    apply(const double *x, double *y, uword numTracer) const;
+protected:
+
+    template <class FieldType>
+    void
+    checkField(const FieldType &f, uword numElem) const;
+}; // RegridPlan
+
+template <class FieldType, int N>
+RegridPlan::DoubleFieldOnly<FieldType> RegridPlan::
+apply(const TimeLevelIndex<N> &timeIdx, const FieldType &f, vec &y) const {
+    checkField(f, f(timeIdx).n_elem);
+    y.set_size(numTarget());
+    apply(f(timeIdx).memptr(), y.memptr());
+} // apply
+
+template <class FieldType, int N>
+RegridPlan::DoubleFieldOnly<FieldType> RegridPlan::
+apply(const TimeLevelIndex<N> &timeIdx,
+      initializer_list<const FieldType*> fields, mat &y) const {
+    y.set_size(numTarget(), fields.size());
+    uword l = 0;
+    for (auto f : fields) {
+        checkField(*f, (*f)(timeIdx).n_elem);
+        apply((*f)(timeIdx).memptr(), y.colptr(l++));
+    }
+} // apply
+
+template <class FieldType>
+RegridPlan::DoubleFieldOnly<FieldType> RegridPlan::
+apply(const FieldType &f, vec &y) const {
+    checkField(f, f().n_elem);
+    y.set_size(numTarget());
+    apply(f().memptr(), y.memptr());
+} // apply
+
+template <class BundleType, int N>
+void RegridPlan::
+applyTracers(const TimeLevelIndex<N> &timeIdx, const BundleType &b,
+             mat &y) const {
+    checkField(b, b(timeIdx).n_elem/b.numTracer());
+    y.set_size(b.numTracer(), numTarget());
+    apply(b(timeIdx).memptr(), y.memptr(), b.numTracer());
+} // applyTracers
+
+template <class FieldType>
+void RegridPlan::
+checkField(const FieldType &f, uword numElem) const {
+    if (f.staggerLocation() != _staggerLocation) {
+        REPORT_ERROR("Field \"" << f.name() << "\" stagger location (" <<
+                     f.staggerLocation() << ") does not match the regrid " <<
+                     "plan (" << _staggerLocation << ")!");
+    }
+    if (numElem != numSourceElem) {
+        REPORT_ERROR("Field \"" << f.name() << "\" size (" << numElem <<
+                     ") does not match the regrid plan (" << numSourceElem <<
+                     ")!");
+    }
+} // checkField
+
+} // geomtk
+
+#endif // __GEOMTK_RegridPlan__
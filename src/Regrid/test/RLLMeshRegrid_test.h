@@ -0,0 +1,153 @@
+#ifndef __GEOMTK_RLLMeshRegrid_test__
+#define __GEOMTK_RLLMeshRegrid_test__
+
+#include "RLLMeshRegrid.h"
+
+using namespace geomtk;
+
+class RLLMeshRegridTest : public ::testing::Test {
+protected:
+    const int FULL = RLLStagger::GridType::FULL;
+    const int CENTER = RLLStagger::Location::CENTER;
+
+    SphereDomain *domain;
+    RLLMesh *srcMesh;
+    RLLMesh *dstMesh;
+    RLLField<double> f, g;
+    TimeLevelIndex<1> timeIdx;
+
+    virtual void SetUp() {
+        domain = new SphereDomain(2);
+        srcMesh = new RLLMesh(*domain);
+        dstMesh = new RLLMesh(*domain);
+
+        domain->radius() = 1.0;
+
+        srcMesh->init(72, 37);
+        dstMesh->init(50, 31);
+        f.create("f", "1", "f", *srcMesh, CENTER, 2);
+        g.create("g", "1", "g", *dstMesh, CENTER, 2);
+        for (uword j = srcMesh->js(FULL); j <= srcMesh->je(FULL); ++j) {
+            for (uword i = srcMesh->is(FULL); i <= srcMesh->ie(FULL); ++i) {
+                f(timeIdx, i, j) = cos(srcMesh->gridCoordComp(0, FULL, i))*
+                                   cos(srcMesh->gridCoordComp(1, FULL, j));
+            }
+        }
+        f.applyBndCond(timeIdx);
+    }
+
+    virtual void TearDown() {
+        delete dstMesh;
+        delete srcMesh;
+        delete domain;
+    }
+
+    double
+    maxError() const {
+        double res = 0;
+        for (uword j = dstMesh->js(FULL); j <= dstMesh->je(FULL); ++j) {
+            for (uword i = dstMesh->is(FULL); i <= dstMesh->ie(FULL); ++i) {
+                double a = cos(dstMesh->gridCoordComp(0, FULL, i))*
+                           cos(dstMesh->gridCoordComp(1, FULL, j));
+                res = fmax(res, fabs(g(timeIdx, i, j)-a));
+            }
+        }
+        return res;
+    }
+
+    template <class FieldType>
+    double
+    integral(const RLLMesh &mesh, const FieldType &f) const {
+        double res = 0;
+        for (uword c = 0; c < mesh.totalNumGrid(CENTER); ++c) {
+            res += f.at(timeIdx, c)*mesh.cellVolume(c);
+        }
+        return res;
+    }
+};
+
+TEST_F(RLLMeshRegridTest, Run) {
+    RLLMeshRegrid regrid;
+    regrid.init(LINEAR, CENTER, *srcMesh, *dstMesh);
+    regrid.run(timeIdx, f, timeIdx, g);
+    double linearError = maxError();
+    ASSERT_GT(1.0e-2, linearError);
+    regrid.init(CUBIC, CENTER, *srcMesh, *dstMesh);
+    regrid.run(timeIdx, f, timeIdx, g);
+    ASSERT_GT(linearError, maxError());
+    // The Poles are zonal means.
+    int j = dstMesh->je(FULL);
+    for (uword i = dstMesh->is(FULL); i <= dstMesh->ie(FULL); ++i) {
+        ASSERT_EQ(g(timeIdx, dstMesh->is(FULL), j), g(timeIdx, i, j));
+    }
+    // Constant field is kept by all methods.
+    for (uword j = srcMesh->js(FULL); j <= srcMesh->je(FULL); ++j) {
+        for (uword i = srcMesh->is(FULL); i <= srcMesh->ie(FULL); ++i) {
+            f(timeIdx, i, j) = 5.0;
+        }
+    }
+    f.applyBndCond(timeIdx);
+    regrid.init(QUADRATIC, CENTER, *srcMesh, *dstMesh);
+    regrid.run(timeIdx, f, timeIdx, g);
+    for (uword j = dstMesh->js(FULL); j <= dstMesh->je(FULL); ++j) {
+        for (uword i = dstMesh->is(FULL); i <= dstMesh->ie(FULL); ++i) {
+            ASSERT_NEAR(5.0, g(timeIdx, i, j), 1.0e-12);
+        }
+    }
+}
+
+TEST_F(RLLMeshRegridTest, Conservative) {
+    RLLMeshRegrid regrid;
+    regrid.init(CONSERVATIVE, CENTER, *srcMesh, *dstMesh);
+    regrid.run(timeIdx, f, timeIdx, g);
+    ASSERT_NEAR(integral(*srcMesh, f), integral(*dstMesh, g), 1.0e-12);
+    ASSERT_GT(5.0e-2, maxError());
+    // Remap back onto the source mesh.
+    regrid.init(CONSERVATIVE, CENTER, *dstMesh, *srcMesh);
+    regrid.run(timeIdx, g, timeIdx, f);
+    ASSERT_NEAR(integral(*srcMesh, f), integral(*dstMesh, g), 1.0e-12);
+}
+
+TEST_F(RLLMeshRegridTest, ConservativeFields) {
+    RLLMeshRegrid regrid;
+    regrid.init(CONSERVATIVE, CENTER, *srcMesh, *dstMesh);
+    RLLField<double> h, g1, g2;
+    h.create("h", "1", "h", *srcMesh, CENTER, 2);
+    g1.create("g1", "1", "g1", *dstMesh, CENTER, 2);
+    g2.create("g2", "1", "g2", *dstMesh, CENTER, 2);
+    for (uword j = srcMesh->js(FULL); j <= srcMesh->je(FULL); ++j) {
+        for (uword i = srcMesh->is(FULL); i <= srcMesh->ie(FULL); ++i) {
+            h(timeIdx, i, j) = 2.0*f(timeIdx, i, j)+1.0;
+        }
+    }
+    h.applyBndCond(timeIdx);
+    regrid.run(timeIdx, {&f, &h}, timeIdx, {&g1, &g2});
+    // The fields are remapped the same as one by one.
+    regrid.run(timeIdx, f, timeIdx, g);
+    for (uword c = 0; c < dstMesh->totalNumGrid(CENTER); ++c) {
+        ASSERT_EQ(g.at(timeIdx, c), g1.at(timeIdx, c));
+    }
+    regrid.run(timeIdx, h, timeIdx, g);
+    for (uword c = 0; c < dstMesh->totalNumGrid(CENTER); ++c) {
+        ASSERT_EQ(g.at(timeIdx, c), g2.at(timeIdx, c));
+    }
+    ASSERT_NEAR(integral(*srcMesh, h), integral(*dstMesh, g2), 1.0e-12);
+    // The fields can also be collected at run time.
+    vector<const RLLField<double>*> srcs = {&f, &h};
+    vector<RLLField<double>*> dsts(2);
+    dsts[0] = new RLLField<double>;
+    dsts[1] = new RLLField<double>;
+    for (uword l = 0; l < dsts.size(); ++l) {
+        dsts[l]->create("g", "1", "g", *dstMesh, CENTER, 2);
+    }
+    regrid.run(timeIdx, srcs, timeIdx, dsts);
+    for (uword c = 0; c < dstMesh->totalNumGrid(CENTER); ++c) {
+        ASSERT_EQ(g1.at(timeIdx, c), dsts[0]->at(timeIdx, c));
+        ASSERT_EQ(g2.at(timeIdx, c), dsts[1]->at(timeIdx, c));
+    }
+    for (uword l = 0; l < dsts.size(); ++l) {
+        delete dsts[l];
+    }
+}
+
+#endif // __GEOMTK_RLLMeshRegrid_test__
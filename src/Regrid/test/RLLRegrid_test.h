@@ -32,6 +32,65 @@ protected:
         delete mesh;
         delete domain;
     }
+
+    static double
+    polynomial(double x, int degree) {
+        double res = 1, a = 1;
+        for (int d = 1; d <= degree; ++d) {
+            a *= 0.5*x;
+            res += a;
+        }
+        return res;
+    }
+
+    /**
+     *  The Lagrange interpolation with n points along each axis reproduces
+     *  the polynomials of degree n-1 along each axis, which pins the stencils
+     *  and weights of "runLagrange".
+     */
+    void
+    checkLagrange(const RLLMesh &rllMesh, int numDim) {
+        RLLRegrid lagrange(rllMesh);
+        RLLField<double, 2> f;
+        f.create("f", "1", "f", rllMesh, CENTER, numDim);
+        int gt[3] = { f.gridType(0), f.gridType(1), numDim == 3 ? f.gridType(2) : FULL };
+        RegridMethod methods[3] = { LINEAR, QUADRATIC, CUBIC };
+        for (int s = 0; s < 3; ++s) {
+            int degree = s+1;
+            uword ks = numDim == 3 ? rllMesh.ks(gt[2]) : 0;
+            uword ke = numDim == 3 ? rllMesh.ke(gt[2]) : 0;
+            for (uword k = ks; k <= ke; ++k) {
+                double c = numDim == 3 ? polynomial(rllMesh.gridCoordComp(2, gt[2], k), degree) : 1;
+                for (uword j = rllMesh.js(gt[1]); j <= rllMesh.je(gt[1]); ++j) {
+                    double b = polynomial(rllMesh.gridCoordComp(1, gt[1], j), degree);
+                    for (uword i = rllMesh.is(gt[0]); i <= rllMesh.ie(gt[0]); ++i) {
+                        double a = polynomial(rllMesh.gridCoordComp(0, gt[0], i), degree);
+                        if (numDim == 3) {
+                            f(timeIdx, i, j, k) = a*b*c;
+                        } else {
+                            f(timeIdx, i, j) = a*b;
+                        }
+                    }
+                }
+            }
+            f.applyBndCond(timeIdx);
+            // The points are kept off the periodic halos and the polar caps.
+            SphereCoord x(numDim);
+            for (int p = 0; p < 10; ++p) {
+                double lon = (0.4+0.12*p)*M_PI, lat = (-0.3+0.06*p)*M_PI;
+                double y, z = polynomial(lon, degree)*polynomial(lat, degree);
+                if (numDim == 3) {
+                    double lev = 0.15+0.07*p;
+                    x.set(lon, lat, lev);
+                    z *= polynomial(lev, degree);
+                } else {
+                    x.set(lon, lat);
+                }
+                lagrange.run(methods[s], timeIdx, f, x, y);
+                ASSERT_NEAR(z, y, 1.0e-10);
+            }
+        }
+    }
 };
 
 //     \      -      |      +      |      +      |      +      |      +      |      +      \      -
@@ -88,4 +147,45 @@ TEST_F(RLLRegridTest, Run) {
     ASSERT_NE(0.0, z(1));
 }
 
+TEST_F(RLLRegridTest, Plan) {
+    RLLField<double, 2> f;
+    f.create("f", "1", "f", *mesh, CENTER, 2);
+    for (uword j = mesh->js(FULL); j <= mesh->je(FULL); ++j) {
+        for (uword i = mesh->is(FULL); i <= mesh->ie(FULL); ++i) {
+            f(timeIdx, i, j) = cos(mesh->gridCoordComp(0, FULL, i))*
+                               sin(mesh->gridCoordComp(1, FULL, j));
+        }
+    }
+    f.applyBndCond(timeIdx);
+
+    vector<SphereCoord> xs(4, SphereCoord(2));
+    xs[0].set(1.9*M_PI, 0.2*M_PI);
+    xs[1].set(0.3*M_PI, -0.1*M_PI);
+    xs[2].set(0.1*M_PI, 0.45*M_PI);
+    xs[3].set(0.0, 0.0);
+    RegridPlan plan;
+    regrid->initPlan(LINEAR, CENTER, xs, plan);
+    ASSERT_EQ(4, plan.numTarget());
+    vec y;
+    plan.apply(timeIdx, f, y);
+    for (int p = 0; p < 4; ++p) {
+        double z;
+        regrid->run(LINEAR, timeIdx, f, xs[p], z);
+        ASSERT_NEAR(z, y[p], 1.0e-14);
+    }
+}
+
+TEST_F(RLLRegridTest, Lagrange2D) {
+    RLLMesh mesh2(*domain);
+    mesh2.init(20, 15);
+    checkLagrange(mesh2, 2);
+}
+
+TEST_F(RLLRegridTest, Lagrange3D) {
+    SphereDomain domain3(CLASSIC_PRESSURE_SIGMA);
+    RLLMesh mesh3(domain3);
+    mesh3.init(20, 15, 8);
+    checkLagrange(mesh3, 3);
+}
+
 #endif // __GEOMTK_RLLRegrid_test__
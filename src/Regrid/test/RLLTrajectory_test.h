@@ -0,0 +1,155 @@
+#ifndef __GEOMTK_RLLTrajectory_test__
+#define __GEOMTK_RLLTrajectory_test__
+
+#include "RLLTrajectory.h"
+
+using namespace geomtk;
+
+class RLLTrajectoryTest : public ::testing::Test {
+protected:
+    const int FULL = RLLStagger::GridType::FULL;
+    const int HALF = RLLStagger::GridType::HALF;
+
+    SphereDomain *domain;
+    RLLMesh *mesh;
+    RLLVelocityField v;
+    TimeLevelIndex<2> oldIdx;
+
+    virtual void SetUp() {
+        domain = new SphereDomain(2);
+        mesh = new RLLMesh(*domain);
+
+        domain->radius() = 1.0;
+
+        mesh->init(36, 19);
+        v.create(*mesh, true, true);
+        // uniform zonal wind on both time levels
+        TimeLevelIndex<2> newIdx = oldIdx+1;
+        for (int l = 0; l < 2; ++l) {
+            const TimeLevelIndex<2> &timeIdx = l == 0 ? oldIdx : newIdx;
+            for (uword j = mesh->js(FULL); j <= mesh->je(FULL); ++j) {
+                for (uword i = mesh->is(HALF); i <= mesh->ie(HALF); ++i) {
+                    v(0)(timeIdx, i, j) = 0.1;
+                }
+            }
+            for (uword j = mesh->js(HALF); j <= mesh->je(HALF); ++j) {
+                for (uword i = mesh->is(FULL); i <= mesh->ie(FULL); ++i) {
+                    v(1)(timeIdx, i, j) = 0.0;
+                }
+            }
+        }
+        v.applyBndCond(oldIdx);
+        v.applyBndCond(newIdx, true);
+    }
+
+    virtual void TearDown() {
+        delete mesh;
+        delete domain;
+    }
+};
+
+TEST_F(RLLTrajectoryTest, ZonalWind) {
+    const double dt = 0.5;
+    const uword numPoint = 20;
+    TrajectoryScheme schemes[2] = { RK2, RK4 };
+    for (int s = 0; s < 2; ++s) {
+        RLLTrajectory trajectory(*mesh, schemes[s]);
+        RLLMeshIndexBatch idx;
+        mat x(numPoint, 2), x0;
+        for (uword p = 0; p < numPoint; ++p) {
+            x(p, 0) = p*0.3;
+            x(p, 1) = -1.0+p*0.1;
+        }
+        x0 = x;
+        for (int step = 0; step < 3; ++step) {
+            trajectory.integrate<2>(oldIdx, dt, v, x, idx);
+        }
+        RLLMeshIndexBatch idx1;
+        idx1.locate(*mesh, x);
+        for (uword p = 0; p < numPoint; ++p) {
+            double lon = fmod(x0(p, 0)+3*dt*0.1/cos(x0(p, 1)), PI2);
+            ASSERT_NEAR(lon, x(p, 0), 1.0e-12);
+            ASSERT_NEAR(x0(p, 1), x(p, 1), 1.0e-12);
+            // The indices are kept in step with the positions.
+            for (int m = 0; m < 2; ++m) {
+                ASSERT_EQ(idx1(p, m, FULL), idx(p, m, FULL));
+                ASSERT_EQ(idx1(p, m, HALF), idx(p, m, HALF));
+            }
+            ASSERT_EQ(idx1.isInPolarCap(p), idx.isInPolarCap(p));
+        }
+    }
+}
+
+/**
+ *  The solid-body rotation about the axis through (0, 0) and (180, 0) moves
+ *  the particles across the North Pole, so the stages are interpolated by the
+ *  polar ring and the particles are moved on the stereographic plane.
+ */
+TEST_F(RLLTrajectoryTest, CrossPole) {
+    RLLMesh mesh(*domain);
+    mesh.init(360, 181);
+    RLLVelocityField u;
+    u.create(mesh, true, true);
+    const double u0 = 0.1;
+    TimeLevelIndex<2> newIdx = oldIdx+1;
+    for (int l = 0; l < 2; ++l) {
+        const TimeLevelIndex<2> &timeIdx = l == 0 ? oldIdx : newIdx;
+        for (uword j = mesh.js(FULL); j <= mesh.je(FULL); ++j) {
+            double lat = mesh.gridCoordComp(1, FULL, j);
+            for (uword i = mesh.is(HALF); i <= mesh.ie(HALF); ++i) {
+                double lon = mesh.gridCoordComp(0, HALF, i);
+                u(0)(timeIdx, i, j) = u0*sin(lat)*cos(lon);
+            }
+        }
+        for (uword j = mesh.js(HALF); j <= mesh.je(HALF); ++j) {
+            for (uword i = mesh.is(FULL); i <= mesh.ie(FULL); ++i) {
+                double lon = mesh.gridCoordComp(0, FULL, i);
+                u(1)(timeIdx, i, j) = -u0*sin(lon);
+            }
+        }
+    }
+    u.applyBndCond(oldIdx);
+    u.applyBndCond(newIdx, true);
+
+    const double dt = 0.25;
+    const int numStep = 4;
+    const uword numPoint = 5;
+    TrajectoryScheme schemes[2] = { RK2, RK4 };
+    for (int s = 0; s < 2; ++s) {
+        RLLTrajectory trajectory(mesh, schemes[s]);
+        RLLMeshIndexBatch idx;
+        mat x(numPoint, 2), x0;
+        // start on the meridian of 270 degree and move northward
+        for (uword p = 0; p < numPoint; ++p) {
+            x(p, 0) = 1.5*PI;
+            x(p, 1) = (88.5+p*0.25)*RAD;
+        }
+        x0 = x;
+        vector<bool> hasInPolarCap(numPoint, false);
+        for (int step = 0; step < numStep; ++step) {
+            trajectory.integrate<2>(oldIdx, dt, u, x, idx);
+            for (uword p = 0; p < numPoint; ++p) {
+                if (idx.isInPolarCap(p)) hasInPolarCap[p] = true;
+            }
+        }
+        double cosA = cos(u0*numStep*dt), sinA = sin(u0*numStep*dt);
+        for (uword p = 0; p < numPoint; ++p) {
+            // rotate the start point about x axis
+            double x1 = cos(x0(p, 1))*cos(x0(p, 0));
+            double y1 = cos(x0(p, 1))*sin(x0(p, 0));
+            double z1 = sin(x0(p, 1));
+            double y2 = y1*cosA+z1*sinA;
+            double z2 = z1*cosA-y1*sinA;
+            double x3 = cos(x(p, 1))*cos(x(p, 0));
+            double y3 = cos(x(p, 1))*sin(x(p, 0));
+            double z3 = sin(x(p, 1));
+            double d = acos(min(1.0, x1*x3+y2*y3+z2*z3));
+            ASSERT_LT(d, 1.0e-3);
+            // The particles end on the other side of the North Pole.
+            ASSERT_GT(y3, 0.0);
+            ASSERT_TRUE(hasInPolarCap[p]);
+        }
+    }
+}
+
+#endif // __GEOMTK_RLLTrajectory_test__
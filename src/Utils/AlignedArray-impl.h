@@ -0,0 +1,105 @@
+namespace geomtk {
+
+template <typename T>
+AlignedArray<T>::
+AlignedArray() {
+    n_rows = n_cols = n_slices = n_elem = 0;
+    mem = NULL;
+}
+
+template <typename T>
+AlignedArray<T>::
+AlignedArray(uword numRow, uword numCol, uword numSlice) {
+    n_rows = n_cols = n_slices = n_elem = 0;
+    mem = NULL;
+    set_size(numRow, numCol, numSlice);
+}
+
+template <typename T>
+AlignedArray<T>::
+AlignedArray(const AlignedArray<T> &other) {
+    n_rows = n_cols = n_slices = n_elem = 0;
+    mem = NULL;
+    *this = other;
+}
+
+template <typename T>
+AlignedArray<T>::
+~AlignedArray() {
+    release();
+}
+
+template <typename T>
+void AlignedArray<T>::
+set_size(uword numRow, uword numCol, uword numSlice) {
+    uword numElem = numRow*numCol*numSlice;
+    if (numElem != n_elem) {
+        release();
+        allocate(numElem);
+    }
+    n_rows = numRow;
+    n_cols = numCol;
+    n_slices = numSlice;
+    n_elem = numElem;
+    fill(0);
+} // set_size
+
+template <typename T>
+void AlignedArray<T>::
+fill(const T &val) {
+    for (uword i = 0; i < n_elem; ++i) {
+        mem[i] = val;
+    }
+} // fill
+
+template <typename T>
+AlignedArray<T>& AlignedArray<T>::
+operator=(const AlignedArray<T> &other) {
+    if (this != &other) {
+        if (other.n_elem != n_elem) {
+            release();
+            allocate(other.n_elem);
+        }
+        n_rows = other.n_rows;
+        n_cols = other.n_cols;
+        n_slices = other.n_slices;
+        n_elem = other.n_elem;
+        if (n_elem > 0) {
+            memcpy(mem, other.mem, n_elem*sizeof(T));
+        }
+    }
+    return *this;
+} // operator=
+
+template <typename T>
+void AlignedArray<T>::
+swap(AlignedArray<T> &other) {
+    std::swap(n_rows, other.n_rows);
+    std::swap(n_cols, other.n_cols);
+    std::swap(n_slices, other.n_slices);
+    std::swap(n_elem, other.n_elem);
+    std::swap(mem, other.mem);
+} // swap
+
+template <typename T>
+void AlignedArray<T>::
+allocate(uword numElem) {
+    mem = NULL;
+    if (numElem == 0) return;
+    void *ptr;
+    if (posix_memalign(&ptr, GEOMTK_ALIGNMENT, numElem*sizeof(T)) != 0) {
+        REPORT_ERROR("Failed to allocate " << numElem*sizeof(T) << " bytes!");
+    }
+    mem = static_cast<T*>(ptr);
+} // allocate
+
+template <typename T>
+void AlignedArray<T>::
+release() {
+    if (mem != NULL) {
+        free(mem);
+        mem = NULL;
+    }
+} // release
+
+} // geomtk
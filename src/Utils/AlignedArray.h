@@ -0,0 +1,181 @@
+#ifndef __GEOMTK_AlignedArray__
+#define __GEOMTK_AlignedArray__
+
+#include "geomtk_commons.h"
+
+namespace geomtk {
+
+#define GEOMTK_ALIGNMENT 64
+
+/**
+ *  This class stores a 3D array of arithmetic type in one contiguous and
+ *  aligned buffer with column-major order (i.e. the first index changes the
+ *  fastest), which is the same as Armadillo. The interface mimics the subset
+ *  of arma::field that is used by StructuredField.
+ *
+ *  @tparam T the element type.
+ */
+template <typename T>
+class AlignedArray {
+public:
+    typedef T elem_type;
+
+    uword n_rows;
+    uword n_cols;
+    uword n_slices;
+    uword n_elem;
+protected:
+    T *mem;
+public:
+    AlignedArray();
+    AlignedArray(uword numRow, uword numCol = 1, uword numSlice = 1);
+    AlignedArray(const AlignedArray<T> &other);
+    ~AlignedArray();
+
+    /**
+     *  Allocate the buffer. The old contents are discarded and the new
+     *  elements are set to zero.
+     *
+     *  @param numRow the number of rows (the fastest changing index).
+     *  @param numCol the number of columns.
+     *  @param numSlice the number of slices (the slowest changing index).
+     */
+    void
+    set_size(uword numRow, uword numCol = 1, uword numSlice = 1);
+
+    /**
+     *  Set all elements to the given value.
+     *
+     *  @param val the value.
+     */
+    void
+    fill(const T &val);
+
+    void
+    zeros() { fill(0); }
+
+    /**
+     *  Return the element offset when the given axis index increases by one.
+     *
+     *  @param axisIdx the axis index (0, 1 or 2).
+     *
+     *  @return The stride in number of elements.
+     */
+    uword
+    stride(int axisIdx) const {
+        return axisIdx == 0 ? 1 : axisIdx == 1 ? n_rows : n_rows*n_cols;
+    }
+
+    /**
+     *  Return the linear offset of the given element.
+     */
+    uword
+    offset(uword i, uword j, uword k) const {
+        return i+n_rows*(j+n_cols*k);
+    }
+
+    T*
+    memptr() { return mem; }
+
+    const T*
+    memptr() const { return mem; }
+
+    T*
+    slice_memptr(uword k) { return mem+n_rows*n_cols*k; }
+
+    const T*
+    slice_memptr(uword k) const { return mem+n_rows*n_cols*k; }
+
+    T*
+    begin() { return mem; }
+
+    const T*
+    begin() const { return mem; }
+
+    T*
+    end() { return mem+n_elem; }
+
+    const T*
+    end() const { return mem+n_elem; }
+
+    const T&
+    operator()(uword i) const {
+#ifndef NDEBUG
+        assert(i < n_elem);
+#endif
+        return mem[i];
+    }
+
+    T&
+    operator()(uword i) {
+#ifndef NDEBUG
+        assert(i < n_elem);
+#endif
+        return mem[i];
+    }
+
+    const T&
+    operator()(uword i, uword j) const {
+#ifndef NDEBUG
+        assert(i < n_rows && j < n_cols);
+#endif
+        return mem[i+n_rows*j];
+    }
+
+    T&
+    operator()(uword i, uword j) {
+#ifndef NDEBUG
+        assert(i < n_rows && j < n_cols);
+#endif
+        return mem[i+n_rows*j];
+    }
+
+    const T&
+    operator()(uword i, uword j, uword k) const {
+#ifndef NDEBUG
+        assert(i < n_rows && j < n_cols && k < n_slices);
+#endif
+        return mem[i+n_rows*(j+n_cols*k)];
+    }
+
+    T&
+    operator()(uword i, uword j, uword k) {
+#ifndef NDEBUG
+        assert(i < n_rows && j < n_cols && k < n_slices);
+#endif
+        return mem[i+n_rows*(j+n_cols*k)];
+    }
+
+    const T&
+    at(uword i, uword j = 0, uword k = 0) const {
+        return mem[i+n_rows*(j+n_cols*k)];
+    }
+
+    T&
+    at(uword i, uword j = 0, uword k = 0) {
+        return mem[i+n_rows*(j+n_cols*k)];
+    }
+
+    AlignedArray<T>&
+    operator=(const AlignedArray<T> &other);
+
+    /**
+     *  Exchange the buffers with another array without copying.
+     *
+     *  @param other the other array.
+     */
+    void
+    swap(AlignedArray<T> &other);
+protected:
+    void
+    allocate(uword numElem);
+
+    void
+    release();
+}; // AlignedArray
+
+} // geomtk
+
+#include "AlignedArray-impl.h"
+
+#endif // __GEOMTK_AlignedArray__
@@ -16,6 +16,16 @@ struct FieldInfo {
     int spaceDims;
 };
 
+/**
+ *  This struct holds a copy of the output data of one field, so that the field
+ *  can be changed while the data is being written (see asynchronous output in
+ *  IOManager). The data are stored in the order of the NetCDF variable.
+ */
+struct FieldSnapshot {
+    uword infoIdx; // index of the field in fieldInfos
+    vector<double> data;
+};
+
 enum IOType {
     INPUT, OUTPUT
 };
@@ -34,6 +44,7 @@ public:
     double lastTime;
     int alarmIdx;
     bool isActive;
+    bool isCreated;
 protected:
     MeshType *_mesh;
     TimeManager *_timeManager;
@@ -41,6 +52,7 @@ public:
     DataFile(MeshType &mesh, TimeManager &timeManager) {
         _mesh = &mesh;
         _timeManager = &timeManager;
+        isCreated = false;
     }
     virtual ~DataFile() {}
 
@@ -49,6 +61,11 @@ public:
         return *_mesh;
     }
 
+    const MeshType&
+    mesh() const {
+        return *_mesh;
+    }
+
     virtual void
     addField(const string &xtype, int spaceDims,
              initializer_list<Field<MeshType>*> fields) = 0;
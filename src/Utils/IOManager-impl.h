@@ -7,10 +7,17 @@ TimeManager *IOManager<DataFileType>::timeManager;
 
 template <class DataFileType>
 IOManager<DataFileType>::IOManager() {
+    _isOutputAsync = false;
+    isWriterStopped = true;
+    maxNumPendingJob = 2;
 }
 
 template <class DataFileType>
 IOManager<DataFileType>::~IOManager() {
+    stopWriter();
+    for (uword i = 0; i < freeJobs.size(); ++i) {
+        delete freeJobs[i];
+    }
 }
 
 template <class DataFileType>
@@ -22,6 +29,7 @@ init(TimeManager &_timeManager) {
 template <class DataFileType>
 int IOManager<DataFileType>::
 addInputFile(MeshType &mesh, const string &filePattern) {
+    flush();
     for (uword i = 0; i < files.size(); ++i) {
         if (files[i].ioType == INPUT && files[i].filePattern == filePattern) {
             REPORT_ERROR("File with file pattern \"" << filePattern <<
@@ -43,6 +51,7 @@ template <class DataFileType>
 int IOManager<DataFileType>::
 addOutputFile(typename DataFileType::MeshType &mesh, StampString &filePattern,
               const duration &freq) {
+    flush();
     for (uword i = 0; i < files.size(); ++i) {
         if (files[i].ioType == OUTPUT && files[i].filePattern == filePattern) {
             REPORT_ERROR("File with pattern \"" << filePattern <<
@@ -73,6 +82,7 @@ addOutputFile(typename DataFileType::MeshType &mesh, const string &filePattern,
 template <class DataFileType>
 void IOManager<DataFileType>::
 removeFile(uword fileIdx) {
+    flush();
     if (fileIdx < 0 || fileIdx >= files.size()) {
         REPORT_ERROR("File index is out of range!");
     }
@@ -82,6 +92,7 @@ removeFile(uword fileIdx) {
 template <class DataFileType>
 DataFileType& IOManager<DataFileType>::
 file(uword fileIdx) {
+    flush();
     if (fileIdx < 0 || fileIdx >= files.size()) {
         REPORT_ERROR("File index is out of range!");
     }
@@ -107,6 +118,7 @@ template <class DataFileType>
 void IOManager<DataFileType>::
 open(uword fileIdx) {
     if (!isFileActive(fileIdx)) return;
+    flush();
     DataFileType &file = files[fileIdx];
     file.filePath = file.filePattern.run(*timeManager);
     int ret;
@@ -125,33 +137,59 @@ void IOManager<DataFileType>::
 create(uword fileIdx) {
     DataFileType &file = files[fileIdx];
     if (!isFileActive(fileIdx)) return;
-    file.filePath = file.filePattern.run(*timeManager);
+    string filePath = file.filePattern.run(*timeManager);
+    string timeUnits = "days since "+ptime_to_string(timeManager->startTime());
+    if (_isOutputAsync) {
+        OutputJob *job = acquireJob(fileIdx, CREATE_FILE);
+        job->filePath = filePath;
+        job->timeStep = timeManager->numStep();
+        job->stepSizeInSeconds = timeManager->stepSizeInSeconds();
+        job->timeUnits = timeUnits;
+        submitJob(job);
+    } else {
+        file.filePath = filePath;
+        createFile(file, timeManager->numStep(),
+                   timeManager->stepSizeInSeconds(), timeUnits);
+    }
+    file.isCreated = true;
+} // create
+
+template <class DataFileType>
+void IOManager<DataFileType>::
+createFile(DataFileType &file, int timeStep, double stepSizeInSeconds,
+           const string &timeUnits) {
     int ret = nc_create(file.filePath.c_str(), NC_CLOBBER, &file.fileId);
     CHECK_NC_CREATE(ret, file.filePath);
     // Define temporal dimension.
-    int timeStep = timeManager->numStep();
     ret = nc_put_att(file.fileId, NC_GLOBAL, "time_step", NC_INT, 1, &timeStep);
     CHECK_NC_PUT_ATT(ret, file.filePath, "NC_GLOBAL", "time_step");
-    double stepSize = timeManager->stepSizeInSeconds();
-    ret = nc_put_att(file.fileId, NC_GLOBAL, "time_step_size_in_seconds", NC_DOUBLE, 1, &stepSize);
+    ret = nc_put_att(file.fileId, NC_GLOBAL, "time_step_size_in_seconds", NC_DOUBLE, 1, &stepSizeInSeconds);
     CHECK_NC_PUT_ATT(ret, file.filePath, "NC_GLOBAL", "time_step_size_in_seconds");
     ret = nc_def_dim(file.fileId, "time", NC_UNLIMITED, &file.timeDimId);
     CHECK_NC_DEF_DIM(ret, file.filePath, "time");
     ret = nc_def_var(file.fileId, "time", NC_DOUBLE, 1, &file.timeDimId, &file.timeVarId);
     CHECK_NC_DEF_VAR(ret, file.filePath, "time")
-    string units = "days since "+ptime_to_string(timeManager->startTime());
     ret = nc_put_att(file.fileId, file.timeVarId, "units", NC_CHAR,
-                     units.length(), units.c_str());
+                     timeUnits.length(), timeUnits.c_str());
     CHECK_NC_PUT_ATT(ret, file.filePath, "time", "units");
     // Let concrete data file class create the rest data file.
     file.create(*timeManager);
     file.outputDomain();
     file.outputMesh();
-} // create
+} // createFile
+
+template <class DataFileType>
+void IOManager<DataFileType>::
+outputTime(DataFileType &file, double time) {
+    size_t index[1] = {0};
+    int ret = nc_put_var1(file.fileId, file.timeVarId, index, &time);
+    CHECK_NC_PUT_VAR(ret, file.filePath, "time");
+} // outputTime
 
 template <class DataFileType>
 ptime IOManager<DataFileType>::
 getTime(uword fileIdx) const {
+    flush();
     ptime res;
     const DataFileType &file = files[fileIdx];
     int ret; double timeValue;
@@ -235,6 +273,7 @@ getTime(const string &filePath) {
 template <class DataFileType>
 void IOManager<DataFileType>::
 updateTime(uword fileIdx, TimeManager &timeManager) {
+    flush();
     DataFileType &file = files[fileIdx];
     int timeStep, ret;
     ret = nc_get_att(file.fileId, NC_GLOBAL, "time_step", &timeStep);
@@ -248,6 +287,7 @@ template <typename DataType, int NumTimeLevel>
 void IOManager<DataFileType>::
 input(uword fileIdx, const TimeLevelIndex<NumTimeLevel> &timeIdx,
       initializer_list<Field<MeshType>*> fields) {
+    flush();
     DataFileType &file = files[fileIdx];
     file.template input<DataType, NumTimeLevel>(timeIdx, fields);
 } // input
@@ -256,6 +296,7 @@ template <class DataFileType>
 template <typename DataType>
 void IOManager<DataFileType>::
 input(uword fileIdx, initializer_list<Field<MeshType>*> fields) {
+    flush();
     DataFileType &file = files[fileIdx];
     file.template input<DataType>(fields);
 } // input
@@ -265,6 +306,7 @@ template <typename DataType, int NumTimeLevel>
 void IOManager<DataFileType>::
 input(uword fileIdx, const TimeLevelIndex<NumTimeLevel> &timeIdx,
       int timeCounter, initializer_list<Field<MeshType>*> fields) {
+    flush();
     DataFileType &file = files[fileIdx];
     file.template input<DataType, NumTimeLevel>(timeIdx, timeCounter, fields);
 } // input
@@ -274,6 +316,7 @@ template <typename DataType>
 void IOManager<DataFileType>::
 input(uword fileIdx, int timeCounter,
       initializer_list<Field<MeshType>*> fields) {
+    flush();
     DataFileType &file = files[fileIdx];
     file.template input<DataType>(timeCounter, fields);
 } // input
@@ -285,6 +328,18 @@ output(uword fileIdx, const TimeLevelIndex<NumTimeLevel> &timeIdx,
        initializer_list<const Field<MeshType>*> fields) {
     int ret, flag = 0;
     DataFileType &file = files[fileIdx];
+    if (_isOutputAsync) {
+        // If the file is not created yet, then create it.
+        bool isJustCreated = !file.isCreated;
+        if (isJustCreated) create(fileIdx);
+        if (!file.isActive) return;
+        OutputJob *job = acquireJob(fileIdx, WRITE_FIELDS);
+        job->time = timeManager->days();
+        file.template snapshot<DataType, NumTimeLevel>(timeIdx, fields, job->snapshots);
+        submitJob(job);
+        if (isJustCreated) close(fileIdx);
+        return;
+    }
     // If the file is not created yet, then create it.
     ret = nc_inq_format(file.fileId, &flag);
     if (ret != NC_NOERR) {
@@ -293,10 +348,7 @@ output(uword fileIdx, const TimeLevelIndex<NumTimeLevel> &timeIdx,
     }
     if (!file.isActive) return;
     // Write time
-    double time = timeManager->days();
-    size_t index[1] = {0};
-    ret = nc_put_var1(file.fileId, file.timeVarId, index, &time);
-    CHECK_NC_PUT_VAR(ret, file.filePath, "time");
+    outputTime(file, timeManager->days());
     // Write fields
     file.template output<DataType, NumTimeLevel>(timeIdx, fields);
     // If the file is just created, then close it.
@@ -311,6 +363,18 @@ void IOManager<DataFileType>::
 output(uword fileIdx, initializer_list<const Field<MeshType>*> fields) {
     int ret, flag = 0;
     DataFileType &file = files[fileIdx];
+    if (_isOutputAsync) {
+        // If the file is not created yet, then create it.
+        bool isJustCreated = !file.isCreated;
+        if (isJustCreated) create(fileIdx);
+        if (!file.isActive) return;
+        OutputJob *job = acquireJob(fileIdx, WRITE_FIELDS);
+        job->time = timeManager->days();
+        file.template snapshot<DataType>(fields, job->snapshots);
+        submitJob(job);
+        if (isJustCreated) close(fileIdx);
+        return;
+    }
     // If the file is not created yet, then create it.
     ret = nc_inq_format(file.fileId, &flag);
     if (ret != NC_NOERR) {
@@ -320,10 +384,7 @@ output(uword fileIdx, initializer_list<const Field<MeshType>*> fields) {
     if (!file.isActive) return;
     // Write time
     // FIXME: Do we need to write time?
-    double time = timeManager->days();
-    size_t index[1] = {0};
-    ret = nc_put_var1(file.fileId, file.timeVarId, index, &time);
-    CHECK_NC_PUT_VAR(ret, file.filePath, "time");
+    outputTime(file, timeManager->days());
     // Write fields
     file.template output<DataType>(fields);
     // If the file is just created, then close it.
@@ -337,8 +398,113 @@ void IOManager<DataFileType>::
 close(uword fileIdx) {
     DataFileType &file = files[fileIdx];
     if (!file.isActive) return;
-    CHECK_NC_CLOSE(nc_close(file.fileId), file.filePath);
+    if (_isOutputAsync && file.ioType == OUTPUT) {
+        submitJob(acquireJob(fileIdx, CLOSE_FILE));
+    } else {
+        flush();
+        CHECK_NC_CLOSE(nc_close(file.fileId), file.filePath);
+    }
     file.isActive = false;
+    file.isCreated = false;
 } // close
 
+template <class DataFileType>
+void IOManager<DataFileType>::
+setOutputAsync(bool isOutputAsync, uword maxNumPendingJob) {
+    if (maxNumPendingJob == 0) {
+        REPORT_ERROR("Argument maxNumPendingJob should be positive!");
+    }
+    flush();
+    this->maxNumPendingJob = maxNumPendingJob;
+    if (isOutputAsync && isWriterStopped) {
+        isWriterStopped = false;
+        writer = thread(&IOManager<DataFileType>::runWriter, this);
+    } else if (!isOutputAsync) {
+        stopWriter();
+    }
+    _isOutputAsync = isOutputAsync;
+} // setOutputAsync
+
+template <class DataFileType>
+void IOManager<DataFileType>::
+flush() const {
+    if (!_isOutputAsync) return;
+    unique_lock<mutex> lock(jobMutex);
+    jobCondition.wait(lock, [this] { return pendingJobs.empty(); });
+} // flush
+
+template <class DataFileType>
+OutputJob* IOManager<DataFileType>::
+acquireJob(uword fileIdx, int actions) {
+    OutputJob *job;
+    unique_lock<mutex> lock(jobMutex);
+    // Wait for the writer if the queue is full.
+    jobCondition.wait(lock, [this] { return pendingJobs.size() < maxNumPendingJob; });
+    if (freeJobs.empty()) {
+        job = new OutputJob;
+    } else {
+        job = freeJobs.back();
+        freeJobs.pop_back();
+    }
+    job->fileIdx = fileIdx;
+    job->actions = actions;
+    return job;
+} // acquireJob
+
+template <class DataFileType>
+void IOManager<DataFileType>::
+submitJob(OutputJob *job) {
+    {
+        lock_guard<mutex> lock(jobMutex);
+        pendingJobs.push_back(job);
+    }
+    jobCondition.notify_all();
+} // submitJob
+
+template <class DataFileType>
+void IOManager<DataFileType>::
+runWriter() {
+    while (true) {
+        OutputJob *job;
+        {
+            unique_lock<mutex> lock(jobMutex);
+            jobCondition.wait(lock, [this] { return isWriterStopped || !pendingJobs.empty(); });
+            if (pendingJobs.empty()) break;
+            // NOTE: The job is kept in the queue until it is written, so that
+            //       flush can wait for it.
+            job = pendingJobs.front();
+        }
+        DataFileType &file = files[job->fileIdx];
+        if (job->actions & CREATE_FILE) {
+            file.filePath = job->filePath;
+            createFile(file, job->timeStep, job->stepSizeInSeconds, job->timeUnits);
+        }
+        if (job->actions & WRITE_FIELDS) {
+            outputTime(file, job->time);
+            file.outputSnapshots(job->snapshots);
+        }
+        if (job->actions & CLOSE_FILE) {
+            CHECK_NC_CLOSE(nc_close(file.fileId), file.filePath);
+        }
+        {
+            lock_guard<mutex> lock(jobMutex);
+            pendingJobs.pop_front();
+            freeJobs.push_back(job);
+        }
+        jobCondition.notify_all();
+    }
+} // runWriter
+
+template <class DataFileType>
+void IOManager<DataFileType>::
+stopWriter() {
+    if (isWriterStopped) return;
+    {
+        lock_guard<mutex> lock(jobMutex);
+        isWriterStopped = true;
+    }
+    jobCondition.notify_all();
+    writer.join();
+} // stopWriter
+
 } // geomtk
@@ -7,8 +7,36 @@
 
 namespace geomtk {
 
+enum OutputAction {
+    CREATE_FILE = 1, WRITE_FIELDS = 2, CLOSE_FILE = 4
+};
+
+/**
+ *  This struct describes one asynchronous output job. Everything that is
+ *  needed by the writer thread is copied into the job when it is submitted,
+ *  so the model can continue to change the fields and the time manager.
+ */
+struct OutputJob {
+    uword fileIdx;
+    int actions; // combination of OutputAction
+    // for CREATE_FILE
+    string filePath;
+    int timeStep;
+    double stepSizeInSeconds;
+    string timeUnits;
+    // for WRITE_FIELDS
+    double time;
+    vector<FieldSnapshot> snapshots;
+};
+
 /**
  *  This class manages the I/O for fields.
+ *
+ *  When the asynchronous output is turned on by setOutputAsync, the output
+ *  fields are copied into reusable snapshots and written by a background
+ *  writer thread. At most maxNumPendingJob jobs (including the one being
+ *  written) are queued, and the model waits when the queue is full. Since
+ *  NetCDF is not thread-safe, the other operations flush the queue first.
  */
 template <class _DataFileType>
 class IOManager {
@@ -18,6 +46,15 @@ public:
 private:
     static TimeManager *timeManager;
     vector<DataFileType> files;
+    // for asynchronous output
+    bool _isOutputAsync;
+    bool isWriterStopped;
+    uword maxNumPendingJob;
+    deque<OutputJob*> pendingJobs;
+    vector<OutputJob*> freeJobs;
+    thread writer;
+    mutable mutex jobMutex;
+    mutable condition_variable jobCondition;
 public:
     IOManager();
     virtual ~IOManager();
@@ -94,6 +131,44 @@ public:
 
     bool
     isFileActive(uword fileIdx);
+
+    /**
+     *  Turn on or off the asynchronous output.
+     *
+     *  @param isOutputAsync the switch.
+     *  @param maxNumPendingJob the maximum number of queued output jobs (2
+     *                          means double buffering).
+     */
+    void
+    setOutputAsync(bool isOutputAsync, uword maxNumPendingJob = 2);
+
+    bool
+    isOutputAsync() const { return _isOutputAsync; }
+
+    /**
+     *  Wait until all the queued output jobs are written.
+     */
+    void
+    flush() const;
+private:
+    void
+    createFile(DataFileType &file, int timeStep, double stepSizeInSeconds,
+               const string &timeUnits);
+
+    void
+    outputTime(DataFileType &file, double time);
+
+    OutputJob*
+    acquireJob(uword fileIdx, int actions);
+
+    void
+    submitJob(OutputJob *job);
+
+    void
+    runWriter();
+
+    void
+    stopWriter();
 }; // IOManager
 
 } // geomtk
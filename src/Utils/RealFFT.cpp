@@ -0,0 +1,130 @@
+#include "RealFFT.h"
+#include "Numerics.h"
+
+namespace geomtk {
+
+RealFFT::
+RealFFT() {
+    n = 0;
+    m = 0;
+    maxRadix = 0;
+}
+
+RealFFT::
+~RealFFT() {
+}
+
+void RealFFT::
+init(uword n) {
+    if (n == 0) {
+        REPORT_ERROR("Sequence length should be positive!");
+    }
+    this->n = n;
+    m = n%2 == 0 ? n/2 : n;
+    radices = Numerics::factors(m);
+    maxRadix = 1;
+    for (uword l = 0; l < radices.size(); ++l) {
+        maxRadix = max(maxRadix, radices[l]);
+    }
+    twiddles.resize(m);
+    for (uword k = 0; k < m; ++k) {
+        twiddles[k] = std::polar(1.0, -2*M_PI*k/m);
+    }
+    packTwiddles.resize(n/2+1);
+    for (uword k = 0; k <= n/2; ++k) {
+        packTwiddles[k] = std::polar(1.0, -2*M_PI*k/n);
+    }
+} // init
+
+void RealFFT::
+forward(const double *x, Complex *X, Complex *work) const {
+    Complex *z = work, *Z = work+m, *scratch = work+2*m;
+    if (n%2 == 0) {
+        for (uword k = 0; k < m; ++k) {
+            z[k] = Complex(x[2*k], x[2*k+1]);
+        }
+        transform(Z, z, 1, 0, false, scratch);
+        // Split the transforms of the even and odd elements.
+        for (uword k = 0; k <= m; ++k) {
+            Complex a = Z[k%m], b = std::conj(Z[(m-k)%m]);
+            Complex E = 0.5*(a+b);
+            Complex O = Complex(0, -0.5)*(a-b);
+            X[k] = E+packTwiddles[k]*O;
+        }
+    } else {
+        for (uword k = 0; k < m; ++k) {
+            z[k] = x[k];
+        }
+        transform(Z, z, 1, 0, false, scratch);
+        for (uword k = 0; k <= n/2; ++k) {
+            X[k] = Z[k];
+        }
+    }
+} // forward
+
+void RealFFT::
+backward(const Complex *X, double *x, Complex *work) const {
+    Complex *Z = work, *z = work+m, *scratch = work+2*m;
+    if (n%2 == 0) {
+        for (uword k = 0; k < m; ++k) {
+            Complex a = X[k], b = std::conj(X[m-k]);
+            Complex E = 0.5*(a+b);
+            Complex O = 0.5*(a-b)*std::conj(packTwiddles[k]);
+            Z[k] = E+Complex(0, 1)*O;
+        }
+        transform(z, Z, 1, 0, true, scratch);
+        for (uword k = 0; k < m; ++k) {
+            x[2*k] = z[k].real()/m;
+            x[2*k+1] = z[k].imag()/m;
+        }
+    } else {
+        Z[0] = X[0];
+        for (uword k = 1; k <= n/2; ++k) {
+            Z[k] = X[k];
+            Z[n-k] = std::conj(X[k]);
+        }
+        transform(z, Z, 1, 0, true, scratch);
+        for (uword k = 0; k < n; ++k) {
+            x[k] = z[k].real()/n;
+        }
+    }
+} // backward
+
+void RealFFT::
+transform(Complex *out, const Complex *in, uword stride, uword level,
+          bool inverse, Complex *scratch) const {
+    // The sub-transform length on this level is p*q, which is split into p
+    // interleaved transforms of length q.
+    uword p = radices.empty() ? 1 : radices[level];
+    uword q = 1;
+    for (uword l = level+1; l < radices.size(); ++l) {
+        q *= radices[l];
+    }
+    if (q == 1) {
+        for (uword k = 0; k < p; ++k) {
+            out[k] = in[k*stride];
+        }
+    } else {
+        for (uword k = 0; k < p; ++k) {
+            transform(out+k*q, in+k*stride, stride*p, level+1, inverse, scratch);
+        }
+    }
+    if (p == 1) return;
+    // Combine the p sub-transforms by the generic radix-p butterfly.
+    for (uword u = 0; u < q; ++u) {
+        for (uword l = 0; l < p; ++l) {
+            scratch[l] = out[u+l*q];
+        }
+        for (uword l = 0; l < p; ++l) {
+            uword k = u+l*q;
+            Complex res = scratch[0];
+            for (uword r = 1; r < p; ++r) {
+                const Complex &w = twiddles[(r*k*stride)%m];
+                res += scratch[r]*(inverse ? std::conj(w) : w);
+            }
+            out[k] = res;
+        }
+    }
+} // transform
+
+} // geomtk
@@ -0,0 +1,84 @@
+#ifndef __GEOMTK_RealFFT__
+#define __GEOMTK_RealFFT__
+
+#include "geomtk_commons.h"
+
+namespace geomtk {
+
+/**
+ *  This class does the discrete Fourier transform of real sequences with
+ *  any length. The complex transform is a mixed-radix Cooley-Tukey one over
+ *  the prime factors of the length (see Numerics::factors), and for even
+ *  lengths the real sequence is packed into a complex one with half length.
+ *
+ *  The plan (factors and twiddles) is read-only after "init", so one plan can
+ *  be shared by threads, each of which provides its own work buffer with
+ *  "workSize" elements.
+ */
+class RealFFT {
+public:
+    typedef arma::cx_double Complex;
+protected:
+    uword n;
+    // complex transform length (n/2 for even n)
+    uword m;
+    vector<uword> radices;
+    // exp(-2*pi*i*k/m) for the complex transform
+    vector<Complex> twiddles;
+    // exp(-2*pi*i*k/n) for the real-complex packing
+    vector<Complex> packTwiddles;
+    uword maxRadix;
+public:
+    RealFFT();
+    virtual ~RealFFT();
+
+    /**
+     *  Set up the plan for the given length.
+     *
+     *  @param n the sequence length.
+     */
+    void
+    init(uword n);
+
+    uword
+    size() const {
+        return n;
+    }
+
+    /**
+     *  Get the number of complex elements in the work buffer.
+     */
+    uword
+    workSize() const {
+        return 2*m+maxRadix;
+    }
+
+    /**
+     *  Do the forward transform without normalization.
+     *
+     *  @param x    the real sequence with n elements.
+     *  @param X    the output n/2+1 Fourier coefficients.
+     *  @param work the work buffer.
+     */
+    void
+    forward(const double *x, Complex *X, Complex *work) const;
+
+    /**
+     *  Do the backward transform normalized by 1/n, so it is the inverse of
+     *  "forward".
+     *
+     *  @param X    the n/2+1 Fourier coefficients.
+     *  @param x    the output real sequence with n elements.
+     *  @param work the work buffer.
+     */
+    void
+    backward(const Complex *X, double *x, Complex *work) const;
+protected:
+    void
+    transform(Complex *out, const Complex *in, uword stride, uword level,
+              bool inverse, Complex *scratch) const;
+}; // RealFFT
+
+} // geomtk
+
+#endif // __GEOMTK_RealFFT__
@@ -322,49 +322,12 @@ void StructuredDataFile<MeshType>::
 input(const TimeLevelIndex<NumTimeLevel> &timeIdx,
       initializer_list<Field<MeshType>*> fields) {
     typedef StructuredField<MeshType, DataType, NumTimeLevel> FieldType;
-    int ret;
     for (auto field_ : fields) {
-        bool tag = false;
-        for (auto info : this->fieldInfos) {
-            if (info.field == field_) {
-                tag = true;
-                FieldType *field = dynamic_cast<FieldType*>(field_);
-                if (field == NULL) {
-                    REPORT_ERROR("Field \"" << field_->name() << "\" does not match expected type!");
-                }
-                int n = this->mesh().totalNumGrid(field->staggerLocation(), field->numDim());
-                // TODO: Try to eliminiate the following duplicates.
-                if (info.xtype == NC_DOUBLE) {
-                    double *x = new double[n];
-                    ret = nc_get_var_double(this->fileId, info.varId, x);
-                    CHECK_NC_GET_VAR(ret, this->filePath, field->name());
-                    for (int k = 0; k < n; ++k) {
-                        (*field).at(timeIdx, k) = x[k];
-                    }
-                    delete [] x;
-                } else if (info.xtype == NC_FLOAT) {
-                    float *x = new float[n];
-                    ret = nc_get_var_float(this->fileId, info.varId, x);
-                    CHECK_NC_GET_VAR(ret, this->filePath, field->name());
-                    for (int k = 0; k < n; ++k) {
-                        (*field).at(timeIdx, k) = x[k];
-                    }
-                    delete [] x;
-                } else if (info.xtype == NC_INT) {
-                    int *x = new int[n];
-                    ret = nc_get_var_int(this->fileId, info.varId, x);
-                    CHECK_NC_GET_VAR(ret, this->filePath, field->name());
-                    for (int k = 0; k < n; ++k) {
-                        (*field).at(timeIdx, k) = x[k];
-                    }
-                    delete [] x;
-                }
-                break;
-            }
-        }
-        if (!tag) {
-            REPORT_ERROR("Field \"" << field_->name() << "\" is not added for input!");
+        FieldType *field = dynamic_cast<FieldType*>(field_);
+        if (field == NULL) {
+            REPORT_ERROR("Field \"" << field_->name() << "\" does not match expected type!");
         }
+        inputField(this->fieldInfos[fieldInfoIndex(field_, INPUT)], *field, (*field)(timeIdx), -1);
     }
 } // input
 
@@ -373,48 +336,12 @@ template <typename DataType>
 void StructuredDataFile<MeshType>::
 input(initializer_list<Field<MeshType>*> fields) {
     typedef StructuredField<MeshType, DataType, 1> FieldType;
-    int ret;
     for (auto field_ : fields) {
-        bool tag = false;
-        for (auto info : this->fieldInfos) {
-            if (info.field == field_) {
-                tag = true;
-                FieldType *field = dynamic_cast<FieldType*>(field_);
-                if (field == NULL) {
-                    REPORT_ERROR("Field \"" << field_->name() << "\" does not match expected type!");
-                }
-                int n = this->mesh().totalNumGrid(field->staggerLocation(), field->numDim());
-                if (info.xtype == NC_DOUBLE) {
-                    double *x = new double[n];
-                    ret = nc_get_var_double(this->fileId, info.varId, x);
-                    CHECK_NC_GET_VAR(ret, this->filePath, field->name());
-                    for (int k = 0; k < n; ++k) {
-                        (*field)(k) = x[k];
-                    }
-                    delete [] x;
-                } else if (info.xtype == NC_FLOAT) {
-                    float *x = new float[n];
-                    ret = nc_get_var_float(this->fileId, info.varId, x);
-                    CHECK_NC_GET_VAR(ret, this->filePath, field->name());
-                    for (int k = 0; k < n; ++k) {
-                        (*field)(k) = x[k];
-                    }
-                    delete [] x;
-                } else if (info.xtype == NC_INT) {
-                    int *x = new int[n];
-                    ret = nc_get_var_int(this->fileId, info.varId, x);
-                    CHECK_NC_GET_VAR(ret, this->filePath, field->name());
-                    for (int k = 0; k < n; ++k) {
-                        (*field)(k) = x[k];
-                    }
-                    delete [] x;
-                }
-                break;
-            }
-        }
-        if (!tag) {
-            REPORT_ERROR("Field \"" << field_->name() << "\" is not added for input!");
+        FieldType *field = dynamic_cast<FieldType*>(field_);
+        if (field == NULL) {
+            REPORT_ERROR("Field \"" << field_->name() << "\" does not match expected type!");
         }
+        inputField(this->fieldInfos[fieldInfoIndex(field_, INPUT)], *field, (*field)(), -1);
     }
 } // input
 
@@ -424,105 +351,12 @@ void StructuredDataFile<MeshType>::
 input(const TimeLevelIndex<NumTimeLevel> &timeIdx,
       int timeCounter, initializer_list<Field<MeshType>*> fields) {
     typedef StructuredField<MeshType, DataType, NumTimeLevel> FieldType;
-    int ret;
     for (auto field_ : fields) {
-        bool tag = false;
-        for (auto info : this->fieldInfos) {
-            if (info.field == field_) {
-                tag = true;
-                FieldType *field = dynamic_cast<FieldType*>(field_);
-                if (field == NULL) {
-                    REPORT_ERROR("Field \"" << field_->name() << "\" does not match expected type!");
-                }
-                int n = this->mesh().totalNumGrid(field->staggerLocation(), field->numDim());
-                size_t start[field->numDim()+1], count[field->numDim()+1];
-                // assume the first dimension is time
-                start[0] = timeCounter; count[0] = 1;
-                if (field->numDim() == 2) {
-                    start[1] = 0; start[2] = 0;
-                    switch (field->staggerLocation()) {
-                        case StructuredStagger::Location::CENTER:
-                            count[1] = this->mesh().numGrid(1, StructuredStagger::GridType::FULL);
-                            count[2] = this->mesh().numGrid(0, StructuredStagger::GridType::FULL);
-                            break;
-                        case StructuredStagger::Location::X_FACE:
-                            count[1] = this->mesh().numGrid(1, StructuredStagger::GridType::HALF);
-                            count[2] = this->mesh().numGrid(0, StructuredStagger::GridType::FULL);
-                            break;
-                        case StructuredStagger::Location::Y_FACE:
-                            count[1] = this->mesh().numGrid(1, StructuredStagger::GridType::FULL);
-                            count[2] = this->mesh().numGrid(0, StructuredStagger::GridType::HALF);
-                            break;
-                        case StructuredStagger::Location::XY_VERTEX:
-                            count[1] = this->mesh().numGrid(1, StructuredStagger::GridType::HALF);
-                            count[2] = this->mesh().numGrid(0, StructuredStagger::GridType::HALF);
-                            break;
-                        default:
-                            REPORT_ERROR("Unexpected branch!");
-                    }
-                } else if (field->numDim() == 3) {
-                    start[1] = 0; start[2] = 0; start[3] = 0;
-                    switch (field->staggerLocation()) {
-                        case StructuredStagger::Location::CENTER:
-                            count[1] = this->mesh().numGrid(2, StructuredStagger::GridType::FULL);
-                            count[2] = this->mesh().numGrid(1, StructuredStagger::GridType::FULL);
-                            count[3] = this->mesh().numGrid(0, StructuredStagger::GridType::FULL);
-                            break;
-                        case StructuredStagger::Location::X_FACE:
-                            count[1] = this->mesh().numGrid(2, StructuredStagger::GridType::FULL);
-                            count[2] = this->mesh().numGrid(1, StructuredStagger::GridType::HALF);
-                            count[3] = this->mesh().numGrid(0, StructuredStagger::GridType::FULL);
-                            break;
-                        case StructuredStagger::Location::Y_FACE:
-                            count[1] = this->mesh().numGrid(2, StructuredStagger::GridType::FULL);
-                            count[2] = this->mesh().numGrid(1, StructuredStagger::GridType::FULL);
-                            count[3] = this->mesh().numGrid(0, StructuredStagger::GridType::HALF);
-                            break;
-                        case StructuredStagger::Location::Z_FACE:
-                            count[1] = this->mesh().numGrid(2, StructuredStagger::GridType::HALF);
-                            count[2] = this->mesh().numGrid(1, StructuredStagger::GridType::FULL);
-                            count[3] = this->mesh().numGrid(0, StructuredStagger::GridType::FULL);
-                            break;
-                        case StructuredStagger::Location::XY_VERTEX:
-                            count[1] = this->mesh().numGrid(2, StructuredStagger::GridType::FULL);
-                            count[2] = this->mesh().numGrid(1, StructuredStagger::GridType::HALF);
-                            count[3] = this->mesh().numGrid(0, StructuredStagger::GridType::HALF);
-                            break;
-                        default:
-                            REPORT_ERROR("Unexpected branch!");
-                    }
-                }
-                if (info.xtype == NC_DOUBLE) {
-                    double *x = new double[n];
-                    ret = nc_get_vara_double(this->fileId, info.varId, start, count, x);
-                    CHECK_NC_GET_VAR(ret, this->filePath, field->name());
-                    for (int k = 0; k < n; ++k) {
-                        (*field).at(timeIdx, k) = x[k];
-                    }
-                    delete [] x;
-                } else if (info.xtype == NC_FLOAT) {
-                    float *x = new float[n];
-                    ret = nc_get_vara_float(this->fileId, info.varId, start, count, x);
-                    CHECK_NC_GET_VAR(ret, this->filePath, field->name());
-                    for (int k = 0; k < n; ++k) {
-                        (*field).at(timeIdx, k) = x[k];
-                    }
-                    delete [] x;
-                } else if (info.xtype == NC_INT) {
-                    int *x = new int[n];
-                    ret = nc_get_vara_int(this->fileId, info.varId, start, count, x);
-                    CHECK_NC_GET_VAR(ret, this->filePath, field->name());
-                    for (int k = 0; k < n; ++k) {
-                        (*field).at(timeIdx, k) = x[k];
-                    }
-                    delete [] x;
-                }
-                break;
-            }
-        }
-        if (!tag) {
-            REPORT_ERROR("Field \"" << field_->name() << "\" is not added for input!");
+        FieldType *field = dynamic_cast<FieldType*>(field_);
+        if (field == NULL) {
+            REPORT_ERROR("Field \"" << field_->name() << "\" does not match expected type!");
         }
+        inputField(this->fieldInfos[fieldInfoIndex(field_, INPUT)], *field, (*field)(timeIdx), timeCounter);
     }
 } // input
 
@@ -531,105 +365,12 @@ template <typename DataType>
 void StructuredDataFile<MeshType>::
 input(int timeCounter, initializer_list<Field<MeshType>*> fields) {
     typedef StructuredField<MeshType, DataType, 1> FieldType;
-    int ret;
     for (auto field_ : fields) {
-        bool tag = false;
-        for (auto info : this->fieldInfos) {
-            if (info.field == field_) {
-                tag = true;
-                FieldType *field = dynamic_cast<FieldType*>(field_);
-                if (field == NULL) {
-                    REPORT_ERROR("Field \"" << field_->name() << "\" does not match expected type!");
-                }
-                int n = this->mesh().totalNumGrid(field->staggerLocation(), field->numDim());
-                size_t start[field->numDim()+1], count[field->numDim()+1];
-                // assume the first dimension is time
-                start[0] = timeCounter; count[0] = 1;
-                if (field->numDim() == 2) {
-                    start[1] = 0; start[2] = 0;
-                    switch (field->staggerLocation()) {
-                        case StructuredStagger::Location::CENTER:
-                            count[1] = this->mesh().numGrid(1, StructuredStagger::GridType::FULL);
-                            count[2] = this->mesh().numGrid(0, StructuredStagger::GridType::FULL);
-                            break;
-                        case StructuredStagger::Location::X_FACE:
-                            count[1] = this->mesh().numGrid(1, StructuredStagger::GridType::HALF);
-                            count[2] = this->mesh().numGrid(0, StructuredStagger::GridType::FULL);
-                            break;
-                        case StructuredStagger::Location::Y_FACE:
-                            count[1] = this->mesh().numGrid(1, StructuredStagger::GridType::FULL);
-                            count[2] = this->mesh().numGrid(0, StructuredStagger::GridType::HALF);
-                            break;
-                        case StructuredStagger::Location::XY_VERTEX:
-                            count[1] = this->mesh().numGrid(1, StructuredStagger::GridType::HALF);
-                            count[2] = this->mesh().numGrid(0, StructuredStagger::GridType::HALF);
-                            break;
-                        default:
-                            REPORT_ERROR("Unexpected branch!");
-                    }
-                } else if (field->numDim() == 3) {
-                    start[1] = 0; start[2] = 0; start[3] = 0;
-                    switch (field->staggerLocation()) {
-                        case StructuredStagger::Location::CENTER:
-                            count[1] = this->mesh().numGrid(2, StructuredStagger::GridType::FULL);
-                            count[2] = this->mesh().numGrid(1, StructuredStagger::GridType::FULL);
-                            count[3] = this->mesh().numGrid(0, StructuredStagger::GridType::FULL);
-                            break;
-                        case StructuredStagger::Location::X_FACE:
-                            count[1] = this->mesh().numGrid(2, StructuredStagger::GridType::FULL);
-                            count[2] = this->mesh().numGrid(1, StructuredStagger::GridType::HALF);
-                            count[3] = this->mesh().numGrid(0, StructuredStagger::GridType::FULL);
-                            break;
-                        case StructuredStagger::Location::Y_FACE:
-                            count[1] = this->mesh().numGrid(2, StructuredStagger::GridType::FULL);
-                            count[2] = this->mesh().numGrid(1, StructuredStagger::GridType::FULL);
-                            count[3] = this->mesh().numGrid(0, StructuredStagger::GridType::HALF);
-                            break;
-                        case StructuredStagger::Location::Z_FACE:
-                            count[1] = this->mesh().numGrid(2, StructuredStagger::GridType::HALF);
-                            count[2] = this->mesh().numGrid(1, StructuredStagger::GridType::FULL);
-                            count[3] = this->mesh().numGrid(0, StructuredStagger::GridType::FULL);
-                            break;
-                        case StructuredStagger::Location::XY_VERTEX:
-                            count[1] = this->mesh().numGrid(2, StructuredStagger::GridType::FULL);
-                            count[2] = this->mesh().numGrid(1, StructuredStagger::GridType::HALF);
-                            count[3] = this->mesh().numGrid(0, StructuredStagger::GridType::HALF);
-                            break;
-                        default:
-                            REPORT_ERROR("Unexpected branch!");
-                    }
-                }
-                if (info.xtype == NC_DOUBLE) {
-                    double *x = new double[n];
-                    ret = nc_get_vara_double(this->fileId, info.varId, start, count, x);
-                    CHECK_NC_GET_VAR(ret, this->filePath, field->name());
-                    for (int k = 0; k < n; ++k) {
-                        (*field)(k) = x[k];
-                    }
-                    delete [] x;
-                } else if (info.xtype == NC_FLOAT) {
-                    float *x = new float[n];
-                    ret = nc_get_vara_float(this->fileId, info.varId, start, count, x);
-                    CHECK_NC_GET_VAR(ret, this->filePath, field->name());
-                    for (int k = 0; k < n; ++k) {
-                        (*field)(k) = x[k];
-                    }
-                    delete [] x;
-                } else if (info.xtype == NC_INT) {
-                    int *x = new int[n];
-                    ret = nc_get_vara_int(this->fileId, info.varId, start, count, x);
-                    CHECK_NC_GET_VAR(ret, this->filePath, field->name());
-                    for (int k = 0; k < n; ++k) {
-                        (*field)(k) = x[k];
-                    }
-                    delete [] x;
-                }
-                break;
-            }
-        }
-        if (!tag) {
-            REPORT_ERROR("Field \"" << field_->name() << "\" is not added for input!");
+        FieldType *field = dynamic_cast<FieldType*>(field_);
+        if (field == NULL) {
+            REPORT_ERROR("Field \"" << field_->name() << "\" does not match expected type!");
         }
+        inputField(this->fieldInfos[fieldInfoIndex(field_, INPUT)], *field, (*field)(), timeCounter);
     }
 } // input
 
@@ -639,48 +380,12 @@ void StructuredDataFile<MeshType>::
 output(const TimeLevelIndex<NumTimeLevel> &timeIdx,
        initializer_list<const Field<MeshType>*> fields) {
     typedef StructuredField<MeshType, DataType, NumTimeLevel> FieldType;
-    int ret;
     for (auto field_ : fields) {
-        bool tag = false;
-        for (auto info : this->fieldInfos) {
-            if (info.field == field_) {
-                tag = true;
-                const FieldType *field = dynamic_cast<const FieldType*>(field_);
-                if (field == NULL) {
-                    REPORT_ERROR("Field \"" << field_->name() << "\" does not match expected type!");
-                }
-                int n = this->mesh().totalNumGrid(field->staggerLocation(), field->numDim());
-                if (info.xtype == NC_DOUBLE) {
-                    double *x = new double[n];
-                    for (int k = 0; k < n; ++k) {
-                        x[k] = (*field).at(timeIdx, k);
-                    }
-                    ret = nc_put_var_double(this->fileId, info.varId, x);
-                    CHECK_NC_PUT_VAR(ret, this->filePath, field->name());
-                    delete [] x;
-                } else if (info.xtype == NC_FLOAT) {
-                    float *x = new float[n];
-                    for (int k = 0; k < n; ++k) {
-                        x[k] = (*field).at(timeIdx, k);
-                    }
-                    ret = nc_put_var_float(this->fileId, info.varId, x);
-                    CHECK_NC_PUT_VAR(ret, this->filePath, field->name());
-                    delete [] x;
-                } else if (info.xtype == NC_INT) {
-                    int *x = new int[n];
-                    for (int k = 0; k < n; ++k) {
-                        x[k] = (*field).at(timeIdx, k);
-                    }
-                    ret = nc_put_var_int(this->fileId, info.varId, x);
-                    CHECK_NC_PUT_VAR(ret, this->filePath, field->name());
-                    delete [] x;
-                }
-                break;
-            }
-        }
-        if (!tag) {
-            REPORT_ERROR("Field \"" << field_->name() << "\" is not added for output!");
+        const FieldType *field = dynamic_cast<const FieldType*>(field_);
+        if (field == NULL) {
+            REPORT_ERROR("Field \"" << field_->name() << "\" does not match expected type!");
         }
+        outputField(this->fieldInfos[fieldInfoIndex(field_, OUTPUT)], *field, (*field)(timeIdx));
     }
 } // output
 
@@ -689,49 +394,254 @@ template <typename DataType>
 void StructuredDataFile<MeshType>::
 output(initializer_list<const Field<MeshType>*> fields) {
     typedef StructuredField<MeshType, DataType, 1> FieldType;
-    int ret;
     for (auto field_ : fields) {
-        bool tag = false;
-        for (auto info : this->fieldInfos) {
-            if (info.field == field_) {
-                tag = true;
-                const FieldType *field = dynamic_cast<const FieldType*>(field_);
-                if (field == NULL) {
-                    REPORT_ERROR("Field \"" << field_->name() << "\" does not match expected type!");
-                }
-                int n = this->mesh().totalNumGrid(field->staggerLocation(), field->numDim());
-                if (info.xtype == NC_DOUBLE) {
-                    double *x = new double[n];
-                    for (int k = 0; k < n; ++k) {
-                        x[k] = (*field)(k);
-                    }
-                    ret = nc_put_var_double(this->fileId, info.varId, x);
-                    CHECK_NC_PUT_VAR(ret, this->filePath, field->name());
-                    delete [] x;
-                } else if (info.xtype == NC_FLOAT) {
-                    float *x = new float[n];
-                    for (int k = 0; k < n; ++k) {
-                        x[k] = (*field)(k);
-                    }
-                    ret = nc_put_var_float(this->fileId, info.varId, x);
-                    CHECK_NC_PUT_VAR(ret, this->filePath, field->name());
-                    delete [] x;
-                } else if (info.xtype == NC_INT) {
-                    int *x = new int[n];
-                    for (int k = 0; k < n; ++k) {
-                        x[k] = (*field)(k);
-                    }
-                    ret = nc_put_var_int(this->fileId, info.varId, x);
-                    CHECK_NC_PUT_VAR(ret, this->filePath, field->name());
-                    delete [] x;
-                }
-                break;
+        const FieldType *field = dynamic_cast<const FieldType*>(field_);
+        if (field == NULL) {
+            REPORT_ERROR("Field \"" << field_->name() << "\" does not match expected type!");
+        }
+        outputField(this->fieldInfos[fieldInfoIndex(field_, OUTPUT)], *field, (*field)());
+    }
+} // output
+
+template <class MeshType>
+template <class FieldType>
+void StructuredDataFile<MeshType>::
+setHyperSlab(const FieldInfo<MeshType> &info, const FieldType &field,
+             const typename FieldType::StorageType &data, int timeCounter,
+             HyperSlab &slab) const {
+    int numVarDim, ret;
+    ret = nc_inq_varndims(this->fileId, info.varId, &numVarDim);
+    CHECK_NC_INQ_VARNDIMS(ret, this->filePath, field.name());
+    int numDim = field.numDim();
+    if (numVarDim < numDim) {
+        REPORT_ERROR("Variable \"" << field.name() << "\" has less dimensions " <<
+                     "than the field in file \"" << this->filePath << "\"!");
+    }
+    for (int m = 0; m < 3; ++m) {
+        if (m < numDim) {
+            slab.numGrid[m] = this->mesh().numGrid(m, field.gridType(m));
+            slab.startIndex[m] = this->mesh().startIndex(m, field.gridType(m));
+        } else {
+            slab.numGrid[m] = 1;
+            slab.startIndex[m] = 0;
+        }
+        slab.strides[m] = data.stride(m);
+    }
+    slab.start.resize(numVarDim);
+    slab.count.resize(numVarDim);
+    slab.imap.resize(numVarDim);
+    // The leading dimensions (e.g. time) are read or written one record at a
+    // time, and the last ones are the spatial axes in reversed order.
+    int l = numVarDim-numDim;
+    for (int i = 0; i < l; ++i) {
+        slab.start[i] = (i == 0 && timeCounter >= 0) ? timeCounter : 0;
+        slab.count[i] = 1;
+        slab.imap[i] = 0;
+    }
+    for (int m = numDim-1; m >= 0; --m, ++l) {
+        slab.start[l] = 0;
+        slab.count[l] = slab.numGrid[m];
+        slab.imap[l] = slab.strides[m];
+    }
+} // setHyperSlab
+
+template <class MeshType>
+template <class FieldType>
+void StructuredDataFile<MeshType>::
+inputField(const FieldInfo<MeshType> &info, const FieldType &field,
+           typename FieldType::StorageType &data, int timeCounter) {
+    HyperSlab slab;
+    setHyperSlab(info, field, data, timeCounter, slab);
+    auto *x = &data(slab.startIndex[0], slab.startIndex[1], slab.startIndex[2]);
+    int ret = getHyperSlab(info.varId, slab, x);
+    CHECK_NC_GET_VAR(ret, this->filePath, field.name());
+} // inputField
+
+template <class MeshType>
+template <class FieldType>
+void StructuredDataFile<MeshType>::
+outputField(const FieldInfo<MeshType> &info, const FieldType &field,
+            const typename FieldType::StorageType &data) {
+    HyperSlab slab;
+    setHyperSlab(info, field, data, -1, slab);
+    const auto *x = &data(slab.startIndex[0], slab.startIndex[1], slab.startIndex[2]);
+    int ret = putHyperSlab(info.varId, slab, x);
+    CHECK_NC_PUT_VAR(ret, this->filePath, field.name());
+} // outputField
+
+template <class MeshType>
+int StructuredDataFile<MeshType>::
+getHyperSlab(int varId, const HyperSlab &slab, double *x) {
+    return nc_get_varm_double(this->fileId, varId, &slab.start[0], &slab.count[0],
+                              NULL, &slab.imap[0], x);
+} // getHyperSlab
+
+template <class MeshType>
+int StructuredDataFile<MeshType>::
+getHyperSlab(int varId, const HyperSlab &slab, float *x) {
+    return nc_get_varm_float(this->fileId, varId, &slab.start[0], &slab.count[0],
+                             NULL, &slab.imap[0], x);
+} // getHyperSlab
+
+template <class MeshType>
+int StructuredDataFile<MeshType>::
+getHyperSlab(int varId, const HyperSlab &slab, int *x) {
+    return nc_get_varm_int(this->fileId, varId, &slab.start[0], &slab.count[0],
+                           NULL, &slab.imap[0], x);
+} // getHyperSlab
+
+template <class MeshType>
+template <typename T>
+int StructuredDataFile<MeshType>::
+getHyperSlab(int varId, const HyperSlab &slab, T *x) {
+    // Other types are converted through the reusable buffer.
+    const uword nx = slab.numGrid[0], ny = slab.numGrid[1], nz = slab.numGrid[2];
+    conversionBuffer.resize(nx*ny*nz);
+    int ret = nc_get_vara_double(this->fileId, varId, &slab.start[0], &slab.count[0],
+                                 &conversionBuffer[0]);
+    if (ret != NC_NOERR) return ret;
+    for (uword k = 0; k < nz; ++k) {
+        for (uword j = 0; j < ny; ++j) {
+            T *row = x+j*slab.strides[1]+k*slab.strides[2];
+            const double *y = &conversionBuffer[(k*ny+j)*nx];
+            for (uword i = 0; i < nx; ++i) {
+                row[i] = y[i];
             }
         }
-        if (!tag) {
-            REPORT_ERROR("Field \"" << field_->name() << "\" is not added for input!");
+    }
+    return ret;
+} // getHyperSlab
+
+template <class MeshType>
+int StructuredDataFile<MeshType>::
+putHyperSlab(int varId, const HyperSlab &slab, const double *x) {
+    return nc_put_varm_double(this->fileId, varId, &slab.start[0], &slab.count[0],
+                              NULL, &slab.imap[0], x);
+} // putHyperSlab
+
+template <class MeshType>
+int StructuredDataFile<MeshType>::
+putHyperSlab(int varId, const HyperSlab &slab, const float *x) {
+    return nc_put_varm_float(this->fileId, varId, &slab.start[0], &slab.count[0],
+                             NULL, &slab.imap[0], x);
+} // putHyperSlab
+
+template <class MeshType>
+int StructuredDataFile<MeshType>::
+putHyperSlab(int varId, const HyperSlab &slab, const int *x) {
+    return nc_put_varm_int(this->fileId, varId, &slab.start[0], &slab.count[0],
+                           NULL, &slab.imap[0], x);
+} // putHyperSlab
+
+template <class MeshType>
+template <typename T>
+int StructuredDataFile<MeshType>::
+putHyperSlab(int varId, const HyperSlab &slab, const T *x) {
+    // Other types are converted through the reusable buffer.
+    const uword nx = slab.numGrid[0], ny = slab.numGrid[1], nz = slab.numGrid[2];
+    conversionBuffer.resize(nx*ny*nz);
+    for (uword k = 0; k < nz; ++k) {
+        for (uword j = 0; j < ny; ++j) {
+            const T *row = x+j*slab.strides[1]+k*slab.strides[2];
+            double *y = &conversionBuffer[(k*ny+j)*nx];
+            for (uword i = 0; i < nx; ++i) {
+                y[i] = row[i];
+            }
         }
     }
-} // output
+    return nc_put_vara_double(this->fileId, varId, &slab.start[0], &slab.count[0],
+                              &conversionBuffer[0]);
+} // putHyperSlab
+
+template <class MeshType>
+template <typename DataType, int NumTimeLevel>
+void StructuredDataFile<MeshType>::
+snapshot(const TimeLevelIndex<NumTimeLevel> &timeIdx,
+         initializer_list<const Field<MeshType>*> fields,
+         vector<FieldSnapshot> &snapshots) const {
+    typedef StructuredField<MeshType, DataType, NumTimeLevel> FieldType;
+    snapshots.resize(fields.size());
+    uword l = 0;
+    for (auto field_ : fields) {
+        const FieldType *field = dynamic_cast<const FieldType*>(field_);
+        if (field == NULL) {
+            REPORT_ERROR("Field \"" << field_->name() << "\" does not match expected type!");
+        }
+        snapshots[l].infoIdx = fieldInfoIndex(field_, OUTPUT);
+        copyToSnapshot(*field, (*field)(timeIdx), snapshots[l++]);
+    }
+} // snapshot
+
+template <class MeshType>
+template <typename DataType>
+void StructuredDataFile<MeshType>::
+snapshot(initializer_list<const Field<MeshType>*> fields,
+         vector<FieldSnapshot> &snapshots) const {
+    typedef StructuredField<MeshType, DataType, 1> FieldType;
+    snapshots.resize(fields.size());
+    uword l = 0;
+    for (auto field_ : fields) {
+        const FieldType *field = dynamic_cast<const FieldType*>(field_);
+        if (field == NULL) {
+            REPORT_ERROR("Field \"" << field_->name() << "\" does not match expected type!");
+        }
+        snapshots[l].infoIdx = fieldInfoIndex(field_, OUTPUT);
+        copyToSnapshot(*field, (*field)(), snapshots[l++]);
+    }
+} // snapshot
+
+template <class MeshType>
+void StructuredDataFile<MeshType>::
+outputSnapshots(const vector<FieldSnapshot> &snapshots) {
+    int ret;
+    for (uword l = 0; l < snapshots.size(); ++l) {
+        const FieldInfo<MeshType> &info = this->fieldInfos[snapshots[l].infoIdx];
+        ret = nc_put_var_double(this->fileId, info.varId, &snapshots[l].data[0]);
+        CHECK_NC_PUT_VAR(ret, this->filePath, info.field->name());
+    }
+} // outputSnapshots
+
+template <class MeshType>
+uword StructuredDataFile<MeshType>::
+fieldInfoIndex(const Field<MeshType> *field, IOType ioType) const {
+    // NOTE: Only the field pointers are read, since the variable IDs may be
+    //       being set by the writer thread of IOManager.
+    for (uword i = 0; i < this->fieldInfos.size(); ++i) {
+        if (this->fieldInfos[i].field == field) {
+            return i;
+        }
+    }
+    REPORT_ERROR("Field \"" << field->name() << "\" is not added for " <<
+                 (ioType == INPUT ? "input" : "output") << "!");
+} // fieldInfoIndex
+
+template <class MeshType>
+template <class FieldType>
+void StructuredDataFile<MeshType>::
+copyToSnapshot(const FieldType &field,
+               const typename FieldType::StorageType &data,
+               FieldSnapshot &snapshot) const {
+    // The order is the same as the variable in the file. The dimension is
+    // taken from the field rather than the domain, since a 2D field on 3D
+    // mesh (e.g. surface pressure) has no vertical levels in its storage.
+    uword numDim = field.numDim();
+    uword nx = this->mesh().numGrid(0, field.gridType(0));
+    uword ny = numDim > 1 ? this->mesh().numGrid(1, field.gridType(1)) : 1;
+    uword nz = numDim > 2 ? this->mesh().numGrid(2, field.gridType(2)) : 1;
+    uword is = this->mesh().startIndex(0, field.gridType(0));
+    uword js = numDim > 1 ? this->mesh().startIndex(1, field.gridType(1)) : 0;
+    uword ks = numDim > 2 ? this->mesh().startIndex(2, field.gridType(2)) : 0;
+    snapshot.data.resize(nx*ny*nz);
+    #pragma omp parallel for collapse(2)
+    for (uword k = 0; k < nz; ++k) {
+        for (uword j = 0; j < ny; ++j) {
+            const auto *row = &data(is, js+j, ks+k);
+            double *x = &snapshot.data[(k*ny+j)*nx];
+            for (uword i = 0; i < nx; ++i) {
+                x[i] = row[i];
+            }
+        }
+    }
+} // copyToSnapshot
 
 } // geomtk
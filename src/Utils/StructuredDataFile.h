@@ -22,6 +22,8 @@ public:
 protected:
     vector<int> fullDimIDs, fullVarIDs;
     vector<int> halfDimIDs, halfVarIDs;
+    // for the data types that NetCDF can not map directly
+    vector<double> conversionBuffer;
     // for input only
     bool bnds2D;
     int bndsDimID;
@@ -80,6 +82,99 @@ public:
     template <typename DataType>
     void
     output(initializer_list<const Field<MeshType>*> fields);
+
+    /**
+     *  Copy the data of the given fields into the snapshots, which can be
+     *  written later by outputSnapshots without touching the fields. The
+     *  buffers in the snapshots are reused when they are large enough.
+     *
+     *  @param timeIdx the time level index of the fields.
+     *  @param fields the fields to be copied.
+     *  @param snapshots the snapshots to be filled.
+     */
+    template <typename DataType, int NumTimeLevel>
+    void
+    snapshot(const TimeLevelIndex<NumTimeLevel> &timeIdx,
+             initializer_list<const Field<MeshType>*> fields,
+             vector<FieldSnapshot> &snapshots) const;
+
+    template <typename DataType>
+    void
+    snapshot(initializer_list<const Field<MeshType>*> fields,
+             vector<FieldSnapshot> &snapshots) const;
+
+    /**
+     *  Write the snapshots into the file. Only the variable IDs in fieldInfos
+     *  are used, so the fields themselves can be changed meanwhile.
+     *
+     *  @param snapshots the snapshots filled by snapshot.
+     */
+    void
+    outputSnapshots(const vector<FieldSnapshot> &snapshots);
+protected:
+    /**
+     *  This struct describes how the interior of a field is mapped to the
+     *  NetCDF variable, so the data can be read or written in place by
+     *  nc_get_varm/nc_put_varm without copying.
+     */
+    struct HyperSlab {
+        vector<size_t> start, count;
+        vector<ptrdiff_t> imap;
+        uword numGrid[3];
+        uword startIndex[3];
+        ptrdiff_t strides[3];
+    };
+
+    uword
+    fieldInfoIndex(const Field<MeshType> *field, IOType ioType) const;
+
+    template <class FieldType>
+    void
+    setHyperSlab(const FieldInfo<MeshType> &info, const FieldType &field,
+                 const typename FieldType::StorageType &data, int timeCounter,
+                 HyperSlab &slab) const;
+
+    template <class FieldType>
+    void
+    inputField(const FieldInfo<MeshType> &info, const FieldType &field,
+               typename FieldType::StorageType &data, int timeCounter);
+
+    template <class FieldType>
+    void
+    outputField(const FieldInfo<MeshType> &info, const FieldType &field,
+                const typename FieldType::StorageType &data);
+
+    int
+    getHyperSlab(int varId, const HyperSlab &slab, double *x);
+
+    int
+    getHyperSlab(int varId, const HyperSlab &slab, float *x);
+
+    int
+    getHyperSlab(int varId, const HyperSlab &slab, int *x);
+
+    template <typename T>
+    int
+    getHyperSlab(int varId, const HyperSlab &slab, T *x);
+
+    int
+    putHyperSlab(int varId, const HyperSlab &slab, const double *x);
+
+    int
+    putHyperSlab(int varId, const HyperSlab &slab, const float *x);
+
+    int
+    putHyperSlab(int varId, const HyperSlab &slab, const int *x);
+
+    template <typename T>
+    int
+    putHyperSlab(int varId, const HyperSlab &slab, const T *x);
+
+    template <class FieldType>
+    void
+    copyToSnapshot(const FieldType &field,
+                   const typename FieldType::StorageType &data,
+                   FieldSnapshot &snapshot) const;
 }; // StructuredDataFile
 
 } // geomtk
@@ -8,6 +8,11 @@ TimeLevels<T, N>::TimeLevels(bool hasHalfLevel) {
         data = new T[N];
     }
     halfLevel = hasHalfLevel;
+    for (int l = 0; l < NumHalfLevel; ++l) {
+        halfLevelSources[l][0] = -1;
+        halfLevelSources[l][1] = -1;
+        isStale[l] = false;
+    }
 }
 
 template <typename T, int N>
@@ -29,6 +34,36 @@ bool TimeLevels<T, N>::hasHalfLevel() const {
     return halfLevel;
 }
     
+template <typename T, int N>
+void TimeLevels<T, N>::
+invalidateHalfLevel(const TimeLevelIndex<N> &timeIdx) {
+    if (!halfLevel) return;
+    int l = (timeIdx-0.5).get()-N;
+    halfLevelSources[l][0] = (timeIdx-1).get();
+    halfLevelSources[l][1] = timeIdx.get();
+    isStale[l].store(true, std::memory_order_release);
+} // invalidateHalfLevel
+
+template <typename T, int N>
+void TimeLevels<T, N>::
+setHalfLevelUpdated(const TimeLevelIndex<N> &halfTimeIdx) {
+    isStale[halfTimeIdx.get()-N].store(false, std::memory_order_release);
+} // setHalfLevelUpdated
+
+template <typename T, int N>
+void TimeLevels<T, N>::
+updateHalfLevel(int i) const {
+    std::lock_guard<std::mutex> lock(halfLevelMutex);
+    // Other thread may have updated it while this one is waiting.
+    if (!isStale[i-N].load(std::memory_order_relaxed)) return;
+    if (!halfLevelUpdater) {
+        REPORT_ERROR("Half level updater is not set!");
+    }
+    halfLevelUpdater(data[halfLevelSources[i-N][0]],
+                     data[halfLevelSources[i-N][1]], data[i]);
+    isStale[i-N].store(false, std::memory_order_release);
+} // updateHalfLevel
+
 template <typename T, int N>
 TimeLevels<T, N>& TimeLevels<T, N>::operator=(const TimeLevels<T, N> &other) {
     if (this != &other) {
@@ -36,6 +71,12 @@ TimeLevels<T, N>& TimeLevels<T, N>::operator=(const TimeLevels<T, N> &other) {
             for (int i = 0; i < 2*N-1; ++i) {
                 data[i] = other.data[i];
             }
+            for (int l = 0; l < N-1; ++l) {
+                halfLevelSources[l][0] = other.halfLevelSources[l][0];
+                halfLevelSources[l][1] = other.halfLevelSources[l][1];
+                isStale[l] = other.isStale[l].load();
+            }
+            halfLevelUpdater = other.halfLevelUpdater;
         } else {
             for (int i = 0; i < N; ++i) {
                 data[i] = other.data[i];
@@ -12,14 +12,41 @@ namespace geomtk {
 /**
  *  A template class for making variables multi-time-levels.
  *
+ *  The levels are stored in fixed slots, and TimeLevelIndex maps the relative
+ *  levels onto them, so the absolute index is a stable handle of each level
+ *  buffer and shifting the time levels never copies data.
+ *
+ *  The half levels are updated lazily. "invalidateHalfLevel" only records the
+ *  two full levels around the half level, and the half level is computed by
+ *  the updater (see "setHalfLevelUpdater") when it is accessed by relative
+ *  index for the first time, so it costs nothing if it is never used. The
+ *  full levels should not be changed before that. The callers that can
+ *  compute the half level in their own loops can mark it as updated by
+ *  "setHalfLevelUpdated" instead. The lazy update is thread-safe.
+ *
  *  @tparam T the variable type.
  *  @tparam N the number of time levels that are stored.
  */
 template <typename T, int N>
 class TimeLevels {
+public:
+    /**
+     *  The function to compute the half level from the old and new full levels
+     *  around it.
+     */
+    typedef std::function<void (const T &oldLevel, const T &newLevel,
+                                T &halfLevel)> HalfLevelUpdater;
 protected:
+    static const int NumHalfLevel = N > 1 ? N-1 : 1;
+
     T *data;
     bool halfLevel;
+    HalfLevelUpdater halfLevelUpdater;
+    // The absolute indices of the full levels that the stale half levels are
+    // computed from, since TimeLevelIndex may be shifted before the access.
+    int halfLevelSources[NumHalfLevel][2];
+    mutable std::atomic<bool> isStale[NumHalfLevel];
+    mutable std::mutex halfLevelMutex;
 public:
     TimeLevels(bool hasHalfLevel = false);
     virtual ~TimeLevels();
@@ -39,7 +66,9 @@ public:
      *  @return The variable.
      */
     const T& level(const TimeLevelIndex<N> &timeIdx) const {
-        return data[timeIdx.get()];
+        int i = timeIdx.get();
+        if (i >= N) checkHalfLevel(i);
+        return data[i];
     }
 
     /**
@@ -50,11 +79,14 @@ public:
      *  @return The variable.
      */
     T& level(const TimeLevelIndex<N> &timeIdx) {
-        return data[timeIdx.get()];
+        int i = timeIdx.get();
+        if (i >= N) checkHalfLevel(i);
+        return data[i];
     }
 
     /**
-     *  Get the variable on the given time level (absolute index).
+     *  Get the variable on the given time level (absolute index). The half
+     *  levels are returned as they are without the lazy update.
      *
      *  @param i the time level index.
      *
@@ -81,8 +113,50 @@ public:
      *  @return The boolean flag.
      */
     inline bool hasHalfLevel() const;
-    
+
+    void
+    setHalfLevelUpdater(const HalfLevelUpdater &updater) {
+        halfLevelUpdater = updater;
+    }
+
+    bool
+    hasHalfLevelUpdater() const {
+        return static_cast<bool>(halfLevelUpdater);
+    }
+
+    /**
+     *  Mark the half level before the given full level as stale, which will be
+     *  computed from the given and previous full levels on the next access.
+     *
+     *  @param timeIdx the full time level index that is changed.
+     */
+    void
+    invalidateHalfLevel(const TimeLevelIndex<N> &timeIdx);
+
+    /**
+     *  Mark the half level as updated, when it has been computed by the caller.
+     *
+     *  @param halfTimeIdx the half time level index.
+     */
+    void
+    setHalfLevelUpdated(const TimeLevelIndex<N> &halfTimeIdx);
+
+    bool
+    isHalfLevelStale(const TimeLevelIndex<N> &halfTimeIdx) const {
+        return isStale[halfTimeIdx.get()-N].load(std::memory_order_acquire);
+    }
+
     inline TimeLevels<T, N>& operator=(const TimeLevels<T, N> &other);
+protected:
+    void
+    checkHalfLevel(int i) const {
+        if (isStale[i-N].load(std::memory_order_acquire)) {
+            updateHalfLevel(i);
+        }
+    }
+
+    void
+    updateHalfLevel(int i) const;
 };
 
 /*
@@ -0,0 +1,43 @@
+#ifndef __GEOMTK_AlignedArray_test__
+#define __GEOMTK_AlignedArray_test__
+
+#include "AlignedArray.h"
+
+using namespace geomtk;
+
+TEST(AlignedArray, Layout) {
+    AlignedArray<double> a(5, 4, 3);
+
+    ASSERT_EQ(5, a.n_rows);
+    ASSERT_EQ(4, a.n_cols);
+    ASSERT_EQ(3, a.n_slices);
+    ASSERT_EQ(60, a.n_elem);
+    ASSERT_EQ(0, reinterpret_cast<size_t>(a.memptr())%GEOMTK_ALIGNMENT);
+    ASSERT_EQ(1, a.stride(0));
+    ASSERT_EQ(5, a.stride(1));
+    ASSERT_EQ(20, a.stride(2));
+    for (uword i = 0; i < a.n_elem; ++i) {
+        ASSERT_EQ(0, a(i));
+    }
+    a(2, 3, 1) = 1;
+    ASSERT_EQ(1, a.memptr()[2+5*(3+4*1)]);
+    ASSERT_EQ(&a(2, 3, 1), a.slice_memptr(1)+a.offset(2, 3, 0));
+}
+
+TEST(AlignedArray, Copy) {
+    AlignedArray<double> a(3, 2), b;
+
+    a.fill(2);
+    b = a;
+    ASSERT_EQ(a.n_elem, b.n_elem);
+    ASSERT_NE(a.memptr(), b.memptr());
+    for (uword i = 0; i < b.n_elem; ++i) {
+        ASSERT_EQ(2, b(i));
+    }
+    AlignedArray<double> c;
+    c.swap(b);
+    ASSERT_EQ(0, b.n_elem);
+    ASSERT_EQ(6, c.n_elem);
+}
+
+#endif // __GEOMTK_AlignedArray_test__
@@ -296,4 +296,66 @@ TEST_F(IOManagerTest, OutputField) {
     SystemTools::removeFile("test-output.00000.nc");
 }
 
+TEST_F(IOManagerTest, AsyncOutputField) {
+    mesh->init(10, 10);
+
+    RLLField<double, 2> f1, f2;
+    f1.create("f1", "test units", "a field on CENTER location", *mesh, CENTER, 2, false);
+    f2.create("f2", "test units", "a field on X_FACE location", *mesh, X_FACE, 2, false);
+
+    for (uword i = 0; i < mesh->totalNumGrid(f1.staggerLocation(), f1.numDim()); ++i) {
+        f1.at(timeIdx, i) = i;
+    }
+    for (uword i = 0; i < mesh->totalNumGrid(f2.staggerLocation(), f2.numDim()); ++i) {
+        f2.at(timeIdx, i) = -1.0*i;
+    }
+
+    int fileIdx = ioManager.addOutputFile(*mesh, filePattern, seconds(-1));
+    ioManager.file(fileIdx).addField("double", RLLSpaceDimensions::FULL_DIMENSION, {&f1, &f2});
+    ioManager.setOutputAsync(true);
+    ASSERT_TRUE(ioManager.isOutputAsync());
+    ioManager.create(fileIdx);
+    ioManager.output<double, 2>(fileIdx, timeIdx, {&f1, &f2});
+    ioManager.close(fileIdx);
+    // The fields can be changed once the output returns.
+    for (uword i = 0; i < mesh->totalNumGrid(f1.staggerLocation(), f1.numDim()); ++i) {
+        f1.at(timeIdx, i) = 0;
+    }
+    ioManager.flush();
+    ASSERT_TRUE(ioManager.pendingJobs.empty());
+
+    int fileId, varId, ret;
+    double *x;
+
+    ret = nc_open("test-output.00000.nc", NC_NOWRITE, &fileId);
+    ASSERT_EQ(NC_NOERR, ret);
+
+    ret = nc_inq_varid(fileId, "f1", &varId);
+    ASSERT_EQ(NC_NOERR, ret);
+    x = new double[mesh->totalNumGrid(f1.staggerLocation(), f1.numDim())];
+    ret = nc_get_var_double(fileId, varId, x);
+    ASSERT_EQ(NC_NOERR, ret);
+    for (uword i = 0; i < mesh->totalNumGrid(f1.staggerLocation(), f1.numDim()); ++i) {
+        ASSERT_EQ(i, x[i]);
+    }
+    delete [] x;
+
+    ret = nc_inq_varid(fileId, "f2", &varId);
+    ASSERT_EQ(NC_NOERR, ret);
+    x = new double[mesh->totalNumGrid(f2.staggerLocation(), f2.numDim())];
+    ret = nc_get_var_double(fileId, varId, x);
+    ASSERT_EQ(NC_NOERR, ret);
+    for (uword i = 0; i < mesh->totalNumGrid(f2.staggerLocation(), f2.numDim()); ++i) {
+        ASSERT_EQ(x[i], f2.at(timeIdx, i));
+    }
+    delete [] x;
+
+    ret = nc_close(fileId);
+
+    ioManager.setOutputAsync(false);
+    ASSERT_FALSE(ioManager.isOutputAsync());
+
+    SystemTools::removeFile("test-output.00000.nc");
+}
+
 #endif // __GEOMTK_IOManager_test__
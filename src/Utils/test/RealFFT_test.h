@@ -0,0 +1,33 @@
+#ifndef __GEOMTK_RealFFT_test__
+#define __GEOMTK_RealFFT_test__
+
+#include "RealFFT.h"
+
+using namespace geomtk;
+
+TEST(RealFFT, Transform) {
+    uword sizes[] = {1, 8, 45, 97, 360};
+    for (uword n : sizes) {
+        RealFFT fft;
+        fft.init(n);
+        vector<double> x(n), y(n);
+        for (uword i = 0; i < n; ++i) {
+            x[i] = sin(1.3*i)+cos(0.2*i*i);
+        }
+        vector<RealFFT::Complex> X(n/2+1), work(fft.workSize());
+        fft.forward(x.data(), X.data(), work.data());
+        for (uword k = 0; k <= n/2; ++k) {
+            RealFFT::Complex res = 0;
+            for (uword i = 0; i < n; ++i) {
+                res += x[i]*std::polar(1.0, -PI2*i*k/n);
+            }
+            ASSERT_GT(1.0e-10, abs(res-X[k]));
+        }
+        fft.backward(X.data(), y.data(), work.data());
+        for (uword i = 0; i < n; ++i) {
+            ASSERT_NEAR(x[i], y[i], 1.0e-12);
+        }
+    }
+}
+
+#endif // __GEOMTK_RealFFT_test__
@@ -83,4 +83,30 @@ TEST(TimeLevels, OperatorEqual) {
     }
 }
 
+TEST(TimeLevels, LazyHalfLevel) {
+    TimeLevelIndex<2> n;
+    TimeLevels<double, 2> a(HAS_HALF_LEVEL);
+    int numUpdate = 0;
+    a.setHalfLevelUpdater([&numUpdate](const double &x, const double &y, double &z) {
+        z = (x+y)*0.5;
+        numUpdate++;
+    });
+    a.level(n) = 1;
+    a.level(n+1) = 3;
+    a.invalidateHalfLevel(n+1);
+    ASSERT_TRUE(a.isHalfLevelStale(n+0.5));
+    ASSERT_EQ(0, numUpdate);
+    ASSERT_EQ(2, a.level(n+0.5));
+    ASSERT_EQ(2, a.level(n+0.5));
+    ASSERT_EQ(1, numUpdate);
+    ASSERT_FALSE(a.isHalfLevelStale(n+0.5));
+    // The sources are kept after shifting.
+    a.level(n+1) = 5;
+    a.invalidateHalfLevel(n+1);
+    n.shift();
+    ASSERT_EQ(3, a.level(n+0.5));
+    ASSERT_EQ(2, numUpdate);
+    n.reset();
+}
+
 #endif
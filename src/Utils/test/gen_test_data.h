@@ -77,4 +77,62 @@ void gen_2d_tv_data(const string &filePath)
     ret = nc_close(fileId);
 }
 
+void gen_3d_grid_data(const string &filePath, int numLev = 5)
+{
+    int fileId, lonDimID, lonVarID, latDimID, latVarID, levDimID, levVarID;
+    int ptVarId;
+    int ret;
+
+    int numLon = 10, numLat = 10;
+    double lon[numLon], lat[numLat], lev[numLev], pt = 219.4067;
+
+    ret = nc_create(filePath.c_str(), NC_CLOBBER, &fileId);
+
+    ret = nc_def_dim(fileId, "lon", numLon, &lonDimID);
+
+    ret = nc_def_var(fileId, "lon", NC_DOUBLE, 1, &lonDimID, &lonVarID);
+
+    ret = nc_put_att(fileId, lonVarID, "units", NC_CHAR, 11, "degree_east");
+
+    ret = nc_def_dim(fileId, "lat", numLat, &latDimID);
+
+    ret = nc_def_var(fileId, "lat", NC_DOUBLE, 1, &latDimID, &latVarID);
+
+    ret = nc_put_att(fileId, latVarID, "units", NC_CHAR, 12, "degree_north");
+
+    ret = nc_def_dim(fileId, "lev", numLev, &levDimID);
+
+    ret = nc_def_var(fileId, "lev", NC_DOUBLE, 1, &levDimID, &levVarID);
+
+    ret = nc_put_att(fileId, levVarID, "units", NC_CHAR, 1, "1");
+
+    ret = nc_def_var(fileId, "pmtop", NC_DOUBLE, 0, NULL, &ptVarId);
+
+    ret = nc_put_att(fileId, ptVarId, "units", NC_CHAR, 2, "Pa");
+
+    ret = nc_enddef(fileId);
+
+    double dlon = 360.0/numLon;
+    for (int i = 0; i < numLon; ++i) {
+        lon[i] = i*dlon;
+    }
+    double dlat = 180.0/(numLat-1);
+    for (int j = 0; j < numLat; ++j) {
+        lat[j] = -90+j*dlat;
+    }
+    for (int k = 0; k < numLev; ++k) {
+        lev[k] = (k+0.5)/numLev;
+    }
+
+    ret = nc_put_var(fileId, lonVarID, lon);
+
+    ret = nc_put_var(fileId, latVarID, lat);
+
+    ret = nc_put_var(fileId, levVarID, lev);
+
+    ret = nc_put_var(fileId, ptVarId, &pt);
+
+    ret = nc_close(fileId);
+}
+
 #endif // __GEOMTK_GenTestData__
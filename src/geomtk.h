@@ -12,34 +12,47 @@
 
 #include "geomtk_commons.h"
 #include "TimeLevels.h"
+#include "AlignedArray.h"
 #include "TimeManager.h"
 #include "StampString.h"
 #include "SystemTools.h"
 #include "IOManager.h"
 #include "ConfigManager.h"
 #include "Numerics.h"
+#include "RealFFT.h"
 // Domain class hierarchy
 #include "Domain.h"
 #include "SphereDomain.h"
 #include "DomainMetric.h"
+#include "PointIndex.h"
 // Mesh class hierarchy
 #include "Mesh.h"
 #include "MeshIndex.h"
 #include "StructuredMesh.h"
 #include "StructuredMeshIndex.h"
+#include "StructuredMeshIndexBatch.h"
 #include "CartesianMesh.h"
 #include "CartesianMeshIndex.h"
+#include "CartesianMeshIndexBatch.h"
 #include "RLLMesh.h"
 #include "RLLMeshIndex.h"
+#include "RLLMeshIndexBatch.h"
+#include "StructuredDecomp.h"
+#include "StructuredHaloExchange.h"
 // Field class hierarchy
 #include "Field.h"
 #include "CartesianField.h"
 #include "CartesianVelocityField.h"
 #include "RLLField.h"
 #include "RLLVelocityField.h"
+#include "StructuredTracerBundle.h"
+#include "StructuredHaloUpdate.h"
 // Regrid class hierarchy
+#include "RegridPlan.h"
 #include "Regrid.h"
 #include "RLLRegrid.h"
+#include "RLLMeshRegrid.h"
+#include "RLLTrajectory.h"
 #include "CartesianRegrid.h"
 // Filter class hierarchy
 #include "Filter.h"
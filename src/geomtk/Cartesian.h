@@ -17,12 +17,22 @@ using TimeLevelIndex = geomtk::TimeLevelIndex<NumTimeLevel>;
 
 typedef geomtk::SpaceCoord SpaceCoord;
 typedef geomtk::Velocity Velocity;
+template <int NumDim>
+using FixedSpaceCoord = geomtk::FixedSpaceCoord<NumDim>;
+template <int NumDim>
+using FixedVelocity = geomtk::FixedVelocity<NumDim>;
 typedef geomtk::CartesianDomain Domain;
 typedef geomtk::CartesianMesh Mesh;
 typedef geomtk::CartesianMeshIndex MeshIndex;
+typedef geomtk::CartesianMeshIndexBatch MeshIndexBatch;
+typedef geomtk::StructuredDecomp<Mesh> Decomp;
+typedef geomtk::StructuredHaloExchange<Mesh> HaloExchange;
 template <class DataType, int NumTimeLevel = 1>
 using Field = geomtk::CartesianField<DataType, NumTimeLevel>;
 typedef geomtk::CartesianVelocityField VelocityField;
+template <int NumTimeLevel = 1>
+using TracerBundle = geomtk::StructuredTracerBundle<Mesh, NumTimeLevel>;
+typedef geomtk::StructuredHaloUpdate<Mesh> HaloUpdate;
 typedef geomtk::CartesianRegrid Regrid;
 typedef geomtk::RegridMethod RegridMethod;
 typedef geomtk::IOManager<geomtk::CartesianDataFile> IOManager;
@@ -43,5 +53,6 @@ using geomtk::RAD;
 typedef geomtk::DomainMetric<typename Mesh::DomainType> MetricType;
 typedef mlpack::tree::CoverTree<MetricType, mlpack::tree::FirstPointIsRoot, mlpack::range::RangeSearchStat> TreeType;
 typedef mlpack::range::RangeSearch<MetricType, TreeType> SearchType;
+typedef geomtk::PointIndex<typename Mesh::DomainType> PointIndex;
 
 #endif // __GEOMTK_Cartesian__
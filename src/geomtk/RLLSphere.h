@@ -23,13 +23,25 @@ using TimeLevelIndex = geomtk::TimeLevelIndex<NumTimeLevel>;
 
 typedef geomtk::SphereCoord SpaceCoord;
 typedef geomtk::SphereVelocity Velocity;
+template <int NumDim>
+using FixedSpaceCoord = geomtk::FixedSphereCoord<NumDim>;
+template <int NumDim>
+using FixedVelocity = geomtk::FixedSphereVelocity<NumDim>;
 typedef geomtk::SphereDomain Domain;
 typedef geomtk::RLLMesh Mesh;
 typedef geomtk::RLLMeshIndex MeshIndex;
+typedef geomtk::RLLMeshIndexBatch MeshIndexBatch;
+typedef geomtk::StructuredDecomp<Mesh> Decomp;
+typedef geomtk::StructuredHaloExchange<Mesh> HaloExchange;
 template <class DataType, int NumTimeLevel = 1>
 using Field = geomtk::RLLField<DataType, NumTimeLevel>;
 typedef geomtk::RLLVelocityField VelocityField;
+template <int NumTimeLevel = 1>
+using TracerBundle = geomtk::StructuredTracerBundle<Mesh, NumTimeLevel>;
+typedef geomtk::StructuredHaloUpdate<Mesh> HaloUpdate;
 typedef geomtk::RLLRegrid Regrid;
+typedef geomtk::RLLMeshRegrid MeshRegrid;
+typedef geomtk::RLLTrajectory Trajectory;
 typedef geomtk::IOManager<geomtk::RLLDataFile> IOManager;
 typedef geomtk::RLLFilter<Mesh> Filter;
 typedef geomtk::Diagnostics<Mesh, Field, IOManager> Diagnostics;
@@ -49,5 +61,6 @@ using geomtk::RAD;
 typedef geomtk::DomainMetric<typename Mesh::DomainType> MetricType;
 typedef mlpack::tree::CoverTree<MetricType, mlpack::tree::FirstPointIsRoot, mlpack::range::RangeSearchStat> TreeType;
 typedef mlpack::range::RangeSearch<MetricType, TreeType> SearchType;
+typedef geomtk::PointIndex<typename Mesh::DomainType> PointIndex;
 
 #endif // __GEOMTK_RLLSphere__
@@ -16,6 +16,7 @@
 #include "boost/date_time/posix_time/posix_time.hpp"
 #include <netcdf.h>
 #include <mlpack/methods/range_search/range_search.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 #include <mlpack/core/tree/cover_tree.hpp>
 #include <armadillo>
 #include <udunits2.h>
@@ -26,14 +27,23 @@
 #include <assert.h>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
+#include <algorithm>
 #include <string>
 #include <list>
+#include <deque>
 #include <vector>
 #include <map>
 #include <cstdarg>
 #include <typeinfo>
 #include <random>
 #include <exception>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <iterator>
 
 namespace geomtk {
 
@@ -93,11 +103,18 @@ using std::initializer_list;
 using std::string;
 using std::vector;
 using std::list;
+using std::deque;
 using std::map;
 using std::min;
 using std::max;
 using std::getline;
 using std::exception;
+using std::thread;
+using std::mutex;
+using std::atomic;
+using std::condition_variable;
+using std::unique_lock;
+using std::lock_guard;
 
 // meta-programming
 using std::enable_if;
@@ -315,6 +332,15 @@ inline string getClassName(const string &str) {
     } \
 }
 
+#define CHECK_NC_INQ_VARNDIMS(IERR, FILE_NAME, VAR_NAME) \
+{ \
+    if (IERR != NC_NOERR) { \
+        REPORT_ERROR("Failed to inquire dimension number of variable \"" << VAR_NAME << "\" with " << \
+                     "error message \"" << nc_strerror(IERR) << "\" in file " << \
+                     "\"" << FILE_NAME << "\"!"); \
+    } \
+}
+
 #define CHECK_NC_INQ_VARTYPE(IERR, FILE_NAME, VAR_NAME) \
 { \
     if (IERR != NC_NOERR) { \
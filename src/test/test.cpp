@@ -1,25 +1,43 @@
 #include "gtest/gtest.h"
 #include "TimeLevels_test.h"
+#include "AlignedArray_test.h"
 #include "TimeManager_test.h"
 #include "SpaceCoord_test.h"
 #include "CartesianDomain_test.h"
 #include "SphereCoord_test.h"
+#include "FixedSphereCoord_test.h"
 #include "SphereDomain_test.h"
+#include "PointIndex_test.h"
 #include "PeriodicCartesianMesh_test.h"
 #include "OpenCartesianMesh_test.h"
 #include "OpenCartesianMeshIndex_test.h"
 #include "RLLMesh_test.h"
 #include "RLLMeshIndex_test.h"
+#include "StructuredDecomp_test.h"
 #include "RLLField_test.h"
 #include "RLLVelocityField_test.h"
+#include "StructuredTracerBundle_test.h"
+#include "StructuredHaloUpdate_test.h"
 #include "RLLRegrid_test.h"
+#include "RLLMeshRegrid_test.h"
+#include "RLLTrajectory_test.h"
 #include "IOManager_test.h"
 #include "ConfigManager_test.h"
 #include "StampString_test.h"
 #include "Numerics_test.h"
+#include "RealFFT_test.h"
+#include "StructuredFilter_test.h"
+#include "RLLFilter_test.h"
 
 int main(int argc, char *argv[])
 {
+#ifdef GEOMTK_USE_MPI
+    MPI_Init(&argc, &argv);
+#endif
     ::testing::InitGoogleTest(&argc, argv);
-    return RUN_ALL_TESTS();
+    int res = RUN_ALL_TESTS();
+#ifdef GEOMTK_USE_MPI
+    MPI_Finalize();
+#endif
+    return res;
 }